@@ -0,0 +1,618 @@
+/*
+** benchmark_cstructures.c
+** Compares the timings of the containers of libcstructures.so on identical workloads
+** -------------------------------------------
+** Made by Gilles Henrard
+** Last modified : 19/10/2026
+*/
+#include <time.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <threads.h>
+#include "cstructures.h"
+
+#define BENCH_OPERATIONS    2000000U    ///< Number of operations performed on each container
+#define BENCH_KEYS          (1U << 20)  ///< Range of the keys drawn
+#define BENCH_BATCH         32U         ///< Number of elements pushed or popped at once in the batch workloads
+
+/********************************************************
+ * @brief Workload of a producer thread
+********************************************************/
+typedef struct
+{
+    meta_t*         queue;  ///< Queue to fill
+    const uint32_t* keys;   ///< Keys to push
+    uint32_t        nb;     ///< Number of keys
+} benchproducer_t;
+
+/********************************************************
+ * @brief Thread of a multi-producer multi-consumer workload
+********************************************************/
+typedef struct
+{
+    meta_t*         queue;  ///< Queue shared by the threads
+    mtx_t*          lock;   ///< Lock guarding the queue (NULL if the queue is thread-safe)
+    const uint32_t* keys;   ///< Keys to push (NULL for a consumer)
+    uint32_t        nb;     ///< Number of keys to push or pop
+    uint32_t        sum;    ///< Sum of the keys popped
+} benchthread_t;
+
+static int compare_int(const void* a, const void* b);
+static int compare_lowbyte(const void* a, const void* b);
+static double elapsed_ms(const struct timespec* start);
+void bench_avl_rbt(const uint32_t* keys, uint32_t nb);
+void bench_avl_splay(const uint32_t* keys, uint32_t nb);
+void bench_queues(const uint32_t* keys, uint32_t nb);
+void bench_spsc(const uint32_t* keys, uint32_t nb);
+void bench_mpmc(const uint32_t* keys, uint32_t nb);
+void bench_priority(const uint32_t* keys, uint32_t nb);
+void bench_buckets(const uint32_t* keys, uint32_t nb);
+void bench_stacks(const uint32_t* keys, uint32_t nb);
+void bench_batches(const uint32_t* keys, uint32_t nb);
+
+int main(int argc, char *argv[])
+{
+    uint32_t* keys = NULL;
+
+    (void)argc;
+    (void)argv;
+
+    //draw the keys once, so every container replays the same workload
+    keys = calloc(BENCH_OPERATIONS, sizeof(uint32_t));
+    if(!keys)
+        exit(EXIT_FAILURE);
+
+    srand(time(NULL));
+    for(uint32_t i = 0 ; i < BENCH_OPERATIONS ; i++)
+        keys[i] = (uint32_t)rand() % BENCH_KEYS;
+
+    bench_avl_rbt(keys, BENCH_OPERATIONS);
+    bench_avl_splay(keys, BENCH_OPERATIONS);
+    bench_queues(keys, BENCH_OPERATIONS);
+    bench_spsc(keys, BENCH_OPERATIONS);
+    bench_mpmc(keys, BENCH_OPERATIONS);
+    bench_priority(keys, BENCH_OPERATIONS);
+    bench_buckets(keys, BENCH_OPERATIONS);
+    bench_stacks(keys, BENCH_OPERATIONS);
+    bench_batches(keys, BENCH_OPERATIONS);
+
+    free(keys);
+    exit(EXIT_SUCCESS);
+}
+
+/************************************************************/
+/*  I : First integer to compare                            */
+/*      Second integer to compare                           */
+/*  P : Compares two unsigned integers                      */
+/*  O : -1, 0 or 1 whether a is lower, equal or greater     */
+/************************************************************/
+static int compare_int(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+
+    return (x > y) - (x < y);
+}
+
+/************************************************************/
+/*  I : First integer to compare                            */
+/*      Second integer to compare                           */
+/*  P : Compares the lowest bytes of two unsigned integers, */
+/*          the lowest one being the greatest               */
+/*  O : -1, 0 or 1 whether a is lower, equal or greater     */
+/************************************************************/
+static int compare_lowbyte(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a & 0xFFU, y = *(const uint32_t*)b & 0xFFU;
+
+    return (y > x) - (y < x);
+}
+
+/************************************************************/
+/*  I : Moment at which the measure started                 */
+/*  P : Computes the time elapsed since a moment            */
+/*  O : Milliseconds elapsed                                */
+/************************************************************/
+static double elapsed_ms(const struct timespec* start)
+{
+    struct timespec now;
+
+    timespec_get(&now, TIME_UTC);
+    return ((double)(now.tv_sec - start->tv_sec) * 1000.0) + ((double)(now.tv_nsec - start->tv_nsec) / 1000000.0);
+}
+
+/************************************************************/
+/*  I : Keys drawn                                          */
+/*      Number of keys                                      */
+/*  P : Compares AVL and red-black trees on a write-heavy   */
+/*          workload (the lowest bit of each key decides    */
+/*          whether it is inserted or removed)              */
+/*  O : /                                                   */
+/************************************************************/
+void bench_avl_rbt(const uint32_t* keys, uint32_t nb)
+{
+    meta_t avl, rbt;
+    struct timespec start;
+    uint32_t key = 0;
+
+    initialise_structure(&avl, sizeof(uint32_t), compare_int, NULL);
+    initialise_structure(&rbt, sizeof(uint32_t), compare_int, NULL);
+
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i < nb ; i++)
+    {
+        key = keys[i] >> 1;
+        if(keys[i] & 1U)
+            avl.structure = insertAVL(&avl, avl.structure, &key);
+        else
+            delete_AVL_key(&avl, &key);
+    }
+    printf("bench_avl_rbt : AVL : %u mixed insertions and removals in %.1f ms (%u elements left)\n", nb, elapsed_ms(&start), avl.nbelements);
+
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i < nb ; i++)
+    {
+        key = keys[i] >> 1;
+        if(keys[i] & 1U)
+            rbt.structure = insertRBT(&rbt, rbt.structure, &key);
+        else
+            delete_RBT_key(&rbt, &key);
+    }
+    printf("bench_avl_rbt : red-black tree : %u mixed insertions and removals in %.1f ms (%u elements left)\n", nb, elapsed_ms(&start), rbt.nbelements);
+
+    while(avl.structure)
+        delete_AVL_root(&avl);
+    while(rbt.structure)
+        delete_RBT_root(&rbt);
+}
+
+/************************************************************/
+/*  I : Keys drawn                                          */
+/*      Number of keys                                      */
+/*  P : Compares AVL and splay trees on skewed lookups      */
+/*          (90% of them on 16 hot keys)                    */
+/*  O : /                                                   */
+/************************************************************/
+void bench_avl_splay(const uint32_t* keys, uint32_t nb)
+{
+    meta_t avl, splay;
+    struct timespec start;
+    uint32_t key = 0, found = 0;
+
+    initialise_structure(&avl, sizeof(uint32_t), compare_int, NULL);
+    initialise_structure(&splay, sizeof(uint32_t), compare_int, NULL);
+
+    for(uint32_t i = 0 ; i < nb ; i++)
+    {
+        avl.structure = insertAVL(&avl, avl.structure, (void*)&keys[i]);
+        insertSplay(&splay, &keys[i]);
+    }
+
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i < nb ; i++)
+    {
+        key = (keys[i] % 10 ? keys[(keys[i] >> 4) % 16] : keys[i]);
+        found += (search_AVL(&avl, avl.structure, &key) != NULL);
+    }
+    printf("bench_avl_splay : AVL : %u skewed lookups in %.1f ms (%u found)\n", nb, elapsed_ms(&start), found);
+
+    found = 0;
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i < nb ; i++)
+    {
+        key = (keys[i] % 10 ? keys[(keys[i] >> 4) % 16] : keys[i]);
+        found += (search_Splay(&splay, &key) != NULL);
+    }
+    printf("bench_avl_splay : splay tree : %u skewed lookups in %.1f ms (%u found)\n", nb, elapsed_ms(&start), found);
+
+    while(avl.structure)
+        delete_AVL_root(&avl);
+    while(splay.structure)
+        delete_Splay_root(&splay);
+}
+
+/************************************************************/
+/*  I : Keys drawn                                          */
+/*      Number of keys                                      */
+/*  P : Compares linked and ring queues, keeping 64         */
+/*          elements queued while pushing and popping       */
+/*  O : /                                                   */
+/************************************************************/
+void bench_queues(const uint32_t* keys, uint32_t nb)
+{
+    meta_t linked, ring;
+    struct timespec start;
+    dyndata_t* popped = NULL;
+    uint32_t sum = 0, value = 0;
+
+    initialise_structure(&linked, sizeof(uint32_t), compare_int, NULL);
+    initialise_structure(&ring, sizeof(uint32_t), compare_int, NULL);
+
+    //reserve room for the 65 elements queued at most, so the ring queue is measured in steady state
+    if(initialise_ring_queue(&ring, 65) < 0)
+        return;
+
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i < nb ; i++)
+    {
+        pushQueue(&linked, &keys[i]);
+        if(i >= 64)
+        {
+            popped = popQueue(&linked);
+            sum += *(uint32_t*)popped->data;
+            free_dyn(&popped);
+        }
+    }
+    printf("bench_queues : linked queue : %u pushes and pops in %.1f ms (checksum %u)\n", nb, elapsed_ms(&start), sum);
+
+    sum = 0;
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i < nb ; i++)
+    {
+        pushRingQueue(&ring, &keys[i]);
+        if(i >= 64)
+        {
+            popRingQueue(&ring, &value);
+            sum += value;
+        }
+    }
+    printf("bench_queues : ring queue : %u pushes and pops in %.1f ms (checksum %u)\n", nb, elapsed_ms(&start), sum);
+
+    while((popped = popQueue(&linked)))
+        free_dyn(&popped);
+    free_ring_queue(&ring);
+}
+
+/************************************************************/
+/*  I : Workload of the producer                            */
+/*  P : Pushes all the keys in a SPSC queue, by batches     */
+/*  O :  0 -> Success                                       */
+/************************************************************/
+static int spsc_producer(void* arg)
+{
+    benchproducer_t* producer = (benchproducer_t*)arg;
+    uint32_t pushed = 0, nb = 0;
+
+    while(pushed < producer->nb)
+    {
+        nb = (producer->nb - pushed < BENCH_BATCH ? producer->nb - pushed : BENCH_BATCH);
+        nb = pushSPSCQueueBatch(producer->queue, &producer->keys[pushed], nb);
+        if(!nb)
+            thrd_yield();
+
+        pushed += nb;
+    }
+
+    return 0;
+}
+
+/************************************************************/
+/*  I : Keys drawn                                          */
+/*      Number of keys                                      */
+/*  P : Measures the throughput of a SPSC queue between a   */
+/*          producer and a consumer thread                  */
+/*  O : /                                                   */
+/************************************************************/
+void bench_spsc(const uint32_t* keys, uint32_t nb)
+{
+    meta_t queue;
+    benchproducer_t producer = {&queue, keys, nb};
+    struct timespec start;
+    thrd_t thread;
+    uint32_t popped[BENCH_BATCH], received = 0, sum = 0, count = 0;
+    double ms = 0.0;
+
+    initialise_structure(&queue, sizeof(uint32_t), compare_int, NULL);
+    if(initialise_SPSC_queue(&queue, 4096) < 0)
+        return;
+
+    timespec_get(&start, TIME_UTC);
+    if(thrd_create(&thread, spsc_producer, &producer) != thrd_success)
+    {
+        free_SPSC_queue(&queue);
+        return;
+    }
+
+    while(received < nb)
+    {
+        count = popSPSCQueueBatch(&queue, popped, BENCH_BATCH);
+        if(!count)
+            thrd_yield();
+
+        for(uint32_t i = 0 ; i < count ; i++)
+            sum += popped[i];
+        received += count;
+    }
+    thrd_join(thread, NULL);
+    ms = elapsed_ms(&start);
+
+    printf("bench_spsc : SPSC queue : %u elements passed between two threads in %.1f ms (%.1f Mops/s, checksum %u)\n", nb, ms, (double)nb / (ms * 1000.0), sum);
+
+    free_SPSC_queue(&queue);
+}
+
+/************************************************************/
+/*  I : Thread workload                                     */
+/*  P : Pushes or pops keys, through a locked ring queue    */
+/*          or a MPMC queue                                 */
+/*  O :  0 -> Success                                       */
+/************************************************************/
+static int mpmc_worker(void* arg)
+{
+    benchthread_t* thread = (benchthread_t*)arg;
+    uint32_t value = 0;
+    int ret = 0;
+
+    for(uint32_t i = 0 ; i < thread->nb ; i++)
+    {
+        do
+        {
+            if(thread->lock)
+            {
+                //ring queue made thread-safe with a single lock
+                mtx_lock(thread->lock);
+                if(thread->keys)
+                    ret = (thread->queue->nbelements < 4096 ? !pushRingQueue(thread->queue, &thread->keys[i]) : 0);
+                else
+                    ret = popRingQueue(thread->queue, &value);
+                mtx_unlock(thread->lock);
+            }
+            else if(thread->keys)
+                ret = !tryPushMPMCQueue(thread->queue, &thread->keys[i]);
+            else
+                ret = tryPopMPMCQueue(thread->queue, &value);
+
+            if(ret != 1)
+                thrd_yield();
+        } while(ret != 1);
+
+        if(!thread->keys)
+            thread->sum += value;
+    }
+
+    return 0;
+}
+
+/************************************************************/
+/*  I : Keys drawn                                          */
+/*      Number of keys                                      */
+/*  P : Compares a locked ring queue and a MPMC queue,      */
+/*          with 4 producers and 4 consumers                */
+/*  O : /                                                   */
+/************************************************************/
+void bench_mpmc(const uint32_t* keys, uint32_t nb)
+{
+    meta_t ring, mpmc;
+    mtx_t lock;
+    benchthread_t threads[8];
+    thrd_t handles[8];
+    struct timespec start;
+    uint32_t sum = 0, share = nb / 4;
+
+    initialise_structure(&ring, sizeof(uint32_t), compare_int, NULL);
+    initialise_structure(&mpmc, sizeof(uint32_t), compare_int, NULL);
+    if(initialise_ring_queue(&ring, 4096) < 0 || initialise_MPMC_queue(&mpmc, 4096) < 0 || mtx_init(&lock, mtx_plain) != thrd_success)
+        return;
+
+    for(int run = 0 ; run < 2 ; run++)
+    {
+        sum = 0;
+        timespec_get(&start, TIME_UTC);
+        for(int i = 0 ; i < 8 ; i++)
+        {
+            threads[i] = (benchthread_t){(run ? &mpmc : &ring), (run ? NULL : &lock), (i < 4 ? &keys[i * share] : NULL), share, 0};
+            thrd_create(&handles[i], mpmc_worker, &threads[i]);
+        }
+        for(int i = 0 ; i < 8 ; i++)
+        {
+            thrd_join(handles[i], NULL);
+            sum += threads[i].sum;
+        }
+
+        printf("bench_mpmc : %s : %u elements passed between 8 threads in %.1f ms (checksum %u)\n", (run ? "MPMC queue" : "locked ring queue"), share * 4, elapsed_ms(&start), sum);
+    }
+
+    mtx_destroy(&lock);
+    free_ring_queue(&ring);
+    free_MPMC_queue(&mpmc);
+}
+
+/************************************************************/
+/*  I : Keys drawn                                          */
+/*      Number of keys                                      */
+/*  P : Compares the linked priority queue and the heap,    */
+/*          pushing 20000 pending elements then popping     */
+/*          them all (the linked queue scans in O(n))       */
+/*  O : /                                                   */
+/************************************************************/
+void bench_priority(const uint32_t* keys, uint32_t nb)
+{
+    meta_t linked, heap;
+    struct timespec start;
+    dyndata_t* popped = NULL;
+    uint32_t sum = 0, value = 0;
+
+    (void)nb;
+    initialise_structure(&linked, sizeof(uint32_t), compare_int, NULL);
+    initialise_structure(&heap, sizeof(uint32_t), compare_int, NULL);
+    if(initialise_heap(&heap, 0, 0) < 0)
+        return;
+
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i < 20000U ; i++)
+        pushPriorityQueue(&linked, &keys[i]);
+    while((popped = popQueue(&linked)))
+    {
+        sum = (sum * 31U) + *(uint32_t*)popped->data;
+        free_dyn(&popped);
+    }
+    printf("bench_priority : linked priority queue : 20000 pushes and pops in %.1f ms (checksum %u)\n", elapsed_ms(&start), sum);
+
+    sum = 0;
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i < 20000U ; i++)
+        pushHeap(&heap, &keys[i]);
+    while(popHeap(&heap, &value) == 1)
+        sum = (sum * 31U) + value;
+    printf("bench_priority : 4-ary heap : 20000 pushes and pops in %.1f ms (checksum %u)\n", elapsed_ms(&start), sum);
+
+    free_heap(&heap);
+}
+
+/************************************************************/
+/*  I : Keys drawn                                          */
+/*      Number of keys                                      */
+/*  P : Compares the heap and the bucket queue on 256       */
+/*          priorities (the lowest byte of each key),       */
+/*          keeping 100000 elements pending                 */
+/*  O : /                                                   */
+/************************************************************/
+void bench_buckets(const uint32_t* keys, uint32_t nb)
+{
+    meta_t heap, buckets;
+    struct timespec start;
+    uint32_t sum = 0, value = 0;
+
+    initialise_structure(&heap, sizeof(uint32_t), compare_lowbyte, NULL);
+    initialise_structure(&buckets, sizeof(uint32_t), compare_int, NULL);
+    if(initialise_heap(&heap, 100001, 0) < 0)
+        return;
+    if(initialise_bucket_queue(&buckets, 100001) < 0)
+    {
+        free_heap(&heap);
+        return;
+    }
+
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i < nb ; i++)
+    {
+        pushHeap(&heap, &keys[i]);
+        if(i >= 100000)
+        {
+            popHeap(&heap, &value);
+            sum += value & 0xFFU;
+        }
+    }
+    printf("bench_buckets : 4-ary heap : %u pushes and pops in %.1f ms (checksum %u)\n", nb, elapsed_ms(&start), sum);
+
+    sum = 0;
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i < nb ; i++)
+    {
+        pushBucketQueue(&buckets, &keys[i], (uint8_t)keys[i]);
+        if(i >= 100000)
+        {
+            popBucketQueue(&buckets, &value, NULL);
+            sum += value & 0xFFU;
+        }
+    }
+    printf("bench_buckets : bucket queue : %u pushes and pops in %.1f ms (checksum %u)\n", nb, elapsed_ms(&start), sum);
+
+    free_heap(&heap);
+    free_bucket_queue(&buckets);
+}
+
+/************************************************************/
+/*  I : Keys drawn                                          */
+/*      Number of keys                                      */
+/*  P : Compares linked and array stacks on a depth-first   */
+/*          pattern (the lowest bit of each key decides     */
+/*          whether it is pushed or an element is popped),  */
+/*          then on batches of BENCH_BATCH elements         */
+/*  O : /                                                   */
+/************************************************************/
+void bench_stacks(const uint32_t* keys, uint32_t nb)
+{
+    meta_t linked, array;
+    struct timespec start;
+    dyndata_t* popped = NULL;
+    uint32_t sum = 0, value = 0, batch[BENCH_BATCH] = {0};
+
+    initialise_structure(&linked, sizeof(uint32_t), compare_int, NULL);
+    initialise_structure(&array, sizeof(uint32_t), compare_int, NULL);
+    if(initialise_array_stack(&array, 0) < 0)
+        return;
+
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i < nb ; i++)
+    {
+        if(keys[i] & 1U || !linked.nbelements)
+            pushStack(&linked, &keys[i]);
+        else
+        {
+            popped = popStack(&linked);
+            sum += *(uint32_t*)popped->data;
+            free_dyn(&popped);
+        }
+    }
+    printf("bench_stacks : linked stack : %u pushes and pops in %.1f ms (checksum %u)\n", nb, elapsed_ms(&start), sum);
+
+    sum = 0;
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i < nb ; i++)
+    {
+        if(keys[i] & 1U || !array.nbelements)
+            pushArrayStack(&array, &keys[i]);
+        else
+        {
+            popArrayStack(&array, &value);
+            sum += value;
+        }
+    }
+    printf("bench_stacks : array stack : %u pushes and pops in %.1f ms (checksum %u)\n", nb, elapsed_ms(&start), sum);
+
+    sum = 0;
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i + BENCH_BATCH <= nb ; i += BENCH_BATCH)
+    {
+        pushArrayStackBatch(&array, &keys[i], BENCH_BATCH);
+        popArrayStackBatch(&array, batch, BENCH_BATCH);
+        sum += batch[0];
+    }
+    printf("bench_stacks : array stack : %u elements pushed and popped by batches of %u in %.1f ms (checksum %u)\n", nb, BENCH_BATCH, elapsed_ms(&start), sum);
+
+    while((popped = popStack(&linked)))
+        free_dyn(&popped);
+    free_array_stack(&array);
+}
+
+/************************************************************/
+/*  I : Keys drawn                                          */
+/*      Number of keys                                      */
+/*  P : Compares single and batch operations on the linked  */
+/*          queues, by bursts of BENCH_BATCH elements       */
+/*  O : /                                                   */
+/************************************************************/
+void bench_batches(const uint32_t* keys, uint32_t nb)
+{
+    meta_t queue;
+    struct timespec start;
+    dyndata_t* popped = NULL;
+    uint32_t sum = 0, batch[BENCH_BATCH] = {0};
+
+    initialise_structure(&queue, sizeof(uint32_t), compare_int, NULL);
+
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i + BENCH_BATCH <= nb ; i += BENCH_BATCH)
+    {
+        for(uint32_t j = 0 ; j < BENCH_BATCH ; j++)
+            pushQueue(&queue, &keys[i + j]);
+        for(uint32_t j = 0 ; j < BENCH_BATCH ; j++)
+        {
+            popped = popQueue(&queue);
+            sum += *(uint32_t*)popped->data;
+            free_dyn(&popped);
+        }
+    }
+    printf("bench_batches : single operations : %u elements pushed and popped in %.1f ms (checksum %u)\n", nb, elapsed_ms(&start), sum);
+
+    sum = 0;
+    timespec_get(&start, TIME_UTC);
+    for(uint32_t i = 0 ; i + BENCH_BATCH <= nb ; i += BENCH_BATCH)
+    {
+        pushQueueBatch(&queue, &keys[i], BENCH_BATCH);
+        popQueueBatch(&queue, batch, BENCH_BATCH);
+        for(uint32_t j = 0 ; j < BENCH_BATCH ; j++)
+            sum += batch[j];
+    }
+    printf("bench_batches : batches of %u : %u elements pushed and popped in %.1f ms (checksum %u)\n", BENCH_BATCH, nb, elapsed_ms(&start), sum);
+}
@@ -0,0 +1,33 @@
+#ifndef CARRAYSTACKS_H_INCLUDED
+#define CARRAYSTACKS_H_INCLUDED
+#include "cstructurescommon.h"
+
+#define ARRAYSTACK_MAX_CAPACITY (1U << 31)  ///< Maximum capacity of an array stack
+
+/********************************************************
+ * @brief Stack storing its elements inline in a growing array
+ * @note The elements are packed (one every elementsize bytes), the bottom
+ *       at index 0 and the top at index nbelements - 1, so the array has the
+ *       layout of a plain C array and batches are copied in one go
+********************************************************/
+typedef struct
+{
+    uint8_t*    elements;   ///< Array holding the elements
+    uint32_t    capacity;   ///< Number of elements the array can hold
+} arraystack_t;
+
+//array stacks manipulations
+int initialise_array_stack(meta_t* meta, uint32_t capacity);
+int free_array_stack(meta_t* meta);
+int pushArrayStack(meta_t* meta, const void* toAdd);
+int pushArrayStackBatch(meta_t* meta, const void* toAdd, uint32_t nb);
+int popArrayStack(meta_t* meta, void* popped);
+uint32_t popArrayStackBatch(meta_t* meta, void* popped, uint32_t nb);
+
+//search algorithms
+void* peekArrayStack(meta_t* meta);
+
+//array stacks functor
+int foreachArrayStack(meta_t* meta, void* parameter, int (*doAction)(void*, void*));
+
+#endif // CARRAYSTACKS_H_INCLUDED
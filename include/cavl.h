@@ -1,15 +1,47 @@
 #ifndef CAVL_H_INCLUDED
 #define CAVL_H_INCLUDED
 #include "cstructurescommon.h"
+#include "cschedulers.h"
+
+#define AVL_MAX_HEIGHT  64U ///< Maximum height of an AVL (about 1.44 * log2(n), so 46 for 2^32 elements)
 
 //enum used in AVL rotation
 typedef enum {
     RIGHT, LEFT
 } e_rotation;
 
+/********************************************************
+ * @brief In-order iterator over an AVL
+ * @note The stack holds the path from the root to the current element,
+ *       so the iterator can move both ways without parent pointers
+********************************************************/
+typedef struct
+{
+    dyndata_t*  stack[AVL_MAX_HEIGHT];  ///< Nodes from the root to the current element
+    uint8_t     depth;                  ///< Number of nodes in the stack (0 when out of the AVL)
+} avliterator_t;
+
 //AVL manipulation
 dyndata_t* insertAVL(meta_t* meta, dyndata_t* avl, void* toAdd);
+int upsertAVL(meta_t* meta, const void* toAdd, int (*doMerge)(void*, const void*));
+dyndata_t* buildAVL(dyndata_t** vine, uint32_t nb);
+dyndata_t* delete_AVL(meta_t* meta, dyndata_t* root, void* key);
 int delete_AVL_root(meta_t* meta);
+int delete_AVL_key(meta_t* meta, const void* key);
+uint32_t delete_AVL_keys(meta_t* meta, const void* keys, uint32_t nb);
+uint32_t delete_AVL_range(meta_t* meta, const void* low, const void* high);
+dyndata_t* join_AVL(dyndata_t* left, dyndata_t* middle, dyndata_t* right);
+dyndata_t* split_AVL(meta_t* meta, dyndata_t* avl, const void* key, dyndata_t** left, dyndata_t** right);
+
+//AVL multisets
+int insertMultisetAVL(meta_t* meta, const void* toAdd);
+int removeMultisetAVL(meta_t* meta, const void* key);
+uint32_t get_AVL_multiplicity(meta_t* meta, const void* key);
+
+//AVL set operations
+int unionAVL(meta_t* dst, meta_t* src);
+int intersectAVL(meta_t* dst, meta_t* src);
+int differenceAVL(meta_t* dst, meta_t* src);
 
 //display function (used in debugging)
 void display_AVL_tree(meta_t* meta, dyndata_t* avl, char dir, char* (*toString)(void*), int (*doPrint)(const char*, ...));
@@ -17,8 +49,23 @@ void display_AVL_tree(meta_t* meta, dyndata_t* avl, char dir, char* (*toString)(
 //search algorithms
 void* search_AVL(meta_t* meta, dyndata_t* avl, void* key);
 dyndata_t* min_AVL_value(dyndata_t* avl);
+void* select_AVL(meta_t* meta, uint32_t k);
+uint32_t rank_AVL(meta_t* meta, const void* key);
+uint32_t count_AVL_range(meta_t* meta, const void* low, const void* high);
+void* lower_bound_AVL(meta_t* meta, const void* key, avliterator_t* it);
+void* upper_bound_AVL(meta_t* meta, const void* key, avliterator_t* it);
+
+//AVL iterators
+void* first_AVL_iterator(meta_t* meta, avliterator_t* it);
+void* last_AVL_iterator(meta_t* meta, avliterator_t* it);
+void* get_AVL_iterator(avliterator_t* it);
+void* next_AVL_iterator(avliterator_t* it);
+void* prev_AVL_iterator(avliterator_t* it);
 
 //AVL functor
 int foreachAVL(meta_t* meta, dyndata_t* avl, void* parameter, int (*doAction)(void*, void*));
+int foreachAVLRange(meta_t* meta, const void* low, const void* high, void* parameter, int (*doAction)(void*, void*));
+int foreachAVLParallel(meta_t* meta, scheduler_t* scheduler, void* parameter, int (*doAction)(void*, void*));
+int reduceAVLParallel(meta_t* meta, scheduler_t* scheduler, void* result, uint32_t resultsize, int (*doAccumulate)(void*, void*), int (*doCombine)(void*, const void*));
 
 #endif // CAVL_H_INCLUDED
@@ -0,0 +1,50 @@
+#ifndef CBTREES_H_INCLUDED
+#define CBTREES_H_INCLUDED
+#include "cstructurescommon.h"
+
+#define BTREE_CACHELINE 64U     ///< Size of a cache line, to which the nodes are aligned
+#define BTREE_NODE_SIZE 512U    ///< Targeted size of an internal node (keys and children)
+#define BTREE_MIN_KEYS  3U      ///< Minimum capacity of a node, whatever the size of the elements
+
+/********************************************************
+ * @brief Node of a B-tree
+ * @note The keys are stored inline right after the header, followed by the children
+ *       addresses in internal nodes (leaves are allocated without them)
+********************************************************/
+typedef struct
+{
+    uint16_t    nbkeys; ///< Number of keys in the node
+    uint16_t    leaf;   ///< 1 if the node has no children, 0 otherwise
+} btnode_t;
+
+/********************************************************
+ * @brief B-tree in which each node stores several contiguous keys
+ * @note The capacity of the nodes is derived from the size of the elements,
+ *       so that an internal node spans a fixed number of cache lines
+********************************************************/
+typedef struct
+{
+    btnode_t*   root;           ///< Address of the root node
+    uint8_t*    buffer;         ///< Buffer used to hold a key while the tree is modified
+    uint32_t    maxkeys;        ///< Maximum number of keys in a node (odd)
+    uint32_t    keysoffset;     ///< Offset of the keys in a node
+    uint32_t    childrenoffset; ///< Offset of the children addresses in a node
+    uint32_t    leafsize;       ///< Size of a leaf node
+    uint32_t    internalsize;   ///< Size of an internal node
+    uint32_t    height;         ///< Number of levels in the tree
+} btree_t;
+
+//B-trees manipulations
+int initialise_btree(meta_t* meta);
+int free_btree(meta_t* meta);
+int insertBTree(meta_t* meta, const void* toAdd);
+int removeBTree(meta_t* meta, const void* toRemove);
+
+//search algorithms
+void* search_BTree(meta_t* meta, const void* key);
+
+//B-trees functors
+int foreachBTree(meta_t* meta, void* parameter, int (*doAction)(void*, void*));
+int foreachBTreeRange(meta_t* meta, const void* low, const void* high, void* parameter, int (*doAction)(void*, void*));
+
+#endif // CBTREES_H_INCLUDED
@@ -0,0 +1,39 @@
+#ifndef CBUCKETQUEUES_H_INCLUDED
+#define CBUCKETQUEUES_H_INCLUDED
+#include "cstructurescommon.h"
+
+#define BUCKET_PRIORITIES   256U        ///< Number of priorities (0 to 255)
+#define BUCKET_ALIGNMENT    8U          ///< Alignment of the elements in the nodes
+#define BUCKET_NONE         UINT32_MAX  ///< Index designating no node
+
+/********************************************************
+ * @brief Priority queue for small integer priorities, with one FIFO bucket per priority
+ * @note The nodes are linked by index in one growing array, the free ones
+ *       being chained together. A bit is set in the bitmap for each non-empty
+ *       bucket, so the lowest priority is found in a few word scans.
+********************************************************/
+typedef struct
+{
+    uint64_t    bitmap[BUCKET_PRIORITIES / 64]; ///< Bits set for the non-empty buckets
+    uint32_t    heads[BUCKET_PRIORITIES];       ///< Index of the first node of each bucket
+    uint32_t    tails[BUCKET_PRIORITIES];       ///< Index of the last node of each bucket
+    uint8_t*    nodes;                          ///< Array holding the nodes (next index + element)
+    uint32_t    capacity;                       ///< Number of nodes the array can hold
+    uint32_t    nbnodes;                        ///< Number of nodes ever used in the array
+    uint32_t    freenode;                       ///< Index of the first free node
+    uint32_t    stride;                         ///< Size of a node in the array (aligned)
+} bucketqueue_t;
+
+//bucket queues manipulations
+int initialise_bucket_queue(meta_t* meta, uint32_t capacity);
+int free_bucket_queue(meta_t* meta);
+int pushBucketQueue(meta_t* meta, const void* toAdd, uint8_t priority);
+int popBucketQueue(meta_t* meta, void* popped, uint8_t* priority);
+
+//search algorithms
+void* peekBucketQueue(meta_t* meta, uint8_t* priority);
+
+//bucket queues functor
+int foreachBucketQueue(meta_t* meta, void* parameter, int (*doAction)(void*, void*));
+
+#endif // CBUCKETQUEUES_H_INCLUDED
@@ -0,0 +1,40 @@
+#ifndef CCONCURRENTAVL_H_INCLUDED
+#define CCONCURRENTAVL_H_INCLUDED
+#include <threads.h>
+#include "cavl.h"
+#include "cepochs.h"
+
+/********************************************************
+ * @brief AVL shared between one or several writers and any number of readers
+ * @note Writers never modify a published node : they copy the path to the element,
+ *       then publish the new root at once. Readers therefore browse an immutable
+ *       snapshot without ever blocking, and the nodes replaced are reclaimed
+ *       through the epoch domain once no reader can browse them anymore.
+********************************************************/
+typedef struct
+{
+    _Atomic(dyndata_t*) root;       ///< Root of the last snapshot published
+    mtx_t               writer;     ///< Lock serialising the writers
+    epochs_t            epochs;     ///< Reclamation domain of the nodes replaced
+} concurrentavl_t;
+
+//concurrent AVL manipulations
+int initialise_concurrent_AVL(meta_t* meta);
+int free_concurrent_AVL(meta_t* meta);
+int register_concurrent_AVL(meta_t* meta);
+void unregister_concurrent_AVL(meta_t* meta, int slot);
+int insertConcurrentAVL(meta_t* meta, int slot, const void* toAdd);
+int removeConcurrentAVL(meta_t* meta, int slot, const void* toRemove);
+
+//snapshots
+dyndata_t* enter_concurrent_AVL(meta_t* meta, int slot);
+void exit_concurrent_AVL(meta_t* meta, int slot);
+
+//search algorithms
+int search_concurrent_AVL(meta_t* meta, int slot, const void* key, void* found);
+uint32_t get_concurrent_AVL_count(meta_t* meta, int slot);
+
+//concurrent AVL functor
+int foreachConcurrentAVL(meta_t* meta, int slot, void* parameter, int (*doAction)(void*, void*));
+
+#endif // CCONCURRENTAVL_H_INCLUDED
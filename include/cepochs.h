@@ -0,0 +1,56 @@
+#ifndef CEPOCHS_H_INCLUDED
+#define CEPOCHS_H_INCLUDED
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define EPOCH_MAX_THREADS       64U ///< Maximum amount of threads registered at once in an epoch domain
+#define EPOCH_CACHELINE         64U ///< Size of a cache line, used to pad the shared counters
+#define EPOCH_ADVANCE_PERIOD    32U ///< Amount of retirements between two attempts to advance the epoch
+
+/********************************************************
+ * @brief Memory waiting to be freed once no thread can read it anymore
+********************************************************/
+typedef struct
+{
+    void*   ptr;                ///< Address of the memory retired
+    void    (*doFree)(void*);   ///< Method used to free the memory
+} retired_t;
+
+/********************************************************
+ * @brief State of a thread registered in an epoch domain
+ * @note Padded to a cache line to avoid false sharing between threads
+********************************************************/
+typedef struct
+{
+    _Alignas(EPOCH_CACHELINE) atomic_uint_fast64_t local;   ///< Epoch observed by the thread, shifted left, with bit 0 set while in a critical section
+    atomic_bool     used;               ///< Whether the slot is registered by a thread
+    retired_t*      limbo[3];           ///< Memory retired during each of the last three epochs
+    uint32_t        nblimbo[3];         ///< Number of elements retired in each limbo list
+    uint32_t        sizelimbo[3];       ///< Capacity of each limbo list
+    uint64_t        limboepoch[3];      ///< Epoch during which each limbo list was filled
+} epochslot_t;
+
+/********************************************************
+ * @brief Epoch-based memory reclamation domain
+ * @note Memory retired during epoch e is freed once the global epoch reached e+2,
+ *       as every thread then left the critical sections that could have read it
+********************************************************/
+typedef struct
+{
+    _Alignas(EPOCH_CACHELINE) atomic_uint_fast64_t global; ///< Global epoch of the domain
+    epochslot_t slots[EPOCH_MAX_THREADS];                   ///< Threads registered in the domain
+} epochs_t;
+
+//domain manipulations
+void initialise_epochs(epochs_t* epochs);
+void free_epochs(epochs_t* epochs);
+int register_epochs(epochs_t* epochs);
+void unregister_epochs(epochs_t* epochs, int slot);
+
+//critical sections
+void enter_epochs(epochs_t* epochs, int slot);
+void exit_epochs(epochs_t* epochs, int slot);
+int retire_epochs(epochs_t* epochs, int slot, void* ptr, void (*doFree)(void*));
+
+#endif // CEPOCHS_H_INCLUDED
@@ -0,0 +1,65 @@
+#ifndef CHEAPS_H_INCLUDED
+#define CHEAPS_H_INCLUDED
+#include "cstructurescommon.h"
+
+#define HEAP_DEFAULT_ARITY  4U  ///< Number of children per node if none specified
+#define HEAP_MAX_ARITY      16U ///< Maximum number of children per node
+#define HEAP_ALIGNMENT      8U  ///< Alignment of the elements in a heap
+
+/********************************************************
+ * @brief Priority queue stored as an implicit d-ary heap
+ * @note The children of the element i are the elements (i * arity) + 1 to
+ *       (i * arity) + arity. The element with the highest priority
+ *       (the greatest according to doCompare) is at index 0.
+********************************************************/
+typedef struct
+{
+    uint8_t*    elements;   ///< Array holding the elements
+    uint8_t*    buffer;     ///< Buffer holding the element moved while sifting
+    uint32_t    capacity;   ///< Number of elements the array can hold
+    uint32_t    stride;     ///< Size of an element in the array (aligned)
+    uint32_t    arity;      ///< Number of children per node
+} heap_t;
+
+/********************************************************
+ * @brief Addressable priority queue stored as an indexed d-ary heap
+ * @note Each element stays in the slot of its handle, and only the handles
+ *       are moved in the heap. handles[] is a permutation of every handle
+ *       allocated : the first nbelements ones are in the heap, the next
+ *       ones are free and get reused by the following pushes.
+********************************************************/
+typedef struct
+{
+    uint8_t*    elements;   ///< Array holding the elements, indexed by handle
+    uint32_t*   handles;    ///< Handles in the heap order, followed by the free handles
+    uint32_t*   positions;  ///< Position of each handle in the handles array
+    uint32_t    capacity;   ///< Number of elements the arrays can hold
+    uint32_t    nbhandles;  ///< Number of handles allocated (in the heap or free)
+    uint32_t    stride;     ///< Size of an element in the array (aligned)
+    uint32_t    arity;      ///< Number of children per node
+} indexedheap_t;
+
+//heaps manipulations
+int initialise_heap(meta_t* meta, uint32_t capacity, uint32_t arity);
+int free_heap(meta_t* meta);
+int pushHeap(meta_t* meta, const void* toAdd);
+int popHeap(meta_t* meta, void* popped);
+int heapifyArray(meta_t* meta, const void* elements, uint32_t nb);
+
+//indexed heaps manipulations
+int initialise_indexed_heap(meta_t* meta, uint32_t capacity, uint32_t arity);
+int free_indexed_heap(meta_t* meta);
+int pushIndexedHeap(meta_t* meta, const void* toAdd, uint32_t* handle);
+int popIndexedHeap(meta_t* meta, void* popped, uint32_t* handle);
+int updateIndexedHeap(meta_t* meta, uint32_t handle, const void* newValue);
+int removeIndexedHeap(meta_t* meta, uint32_t handle, void* removed);
+
+//search algorithms
+void* peekHeap(meta_t* meta);
+void* peekIndexedHeap(meta_t* meta, uint32_t* handle);
+void* get_indexed_heap_elem(meta_t* meta, uint32_t handle);
+
+//heaps functor
+int foreachHeap(meta_t* meta, void* parameter, int (*doAction)(void*, void*));
+
+#endif // CHEAPS_H_INCLUDED
@@ -0,0 +1,47 @@
+#ifndef CLOCKFREELISTS_H_INCLUDED
+#define CLOCKFREELISTS_H_INCLUDED
+#include "cstructurescommon.h"
+#include "cepochs.h"
+
+/********************************************************
+ * @brief Forward-declaration of lfnode_t structures
+********************************************************/
+typedef struct lfnode_t lfnode_t;
+
+/********************************************************
+ * @brief Element of a lock-free sorted list
+ * @note The payload is stored right after the link
+********************************************************/
+struct lfnode_t
+{
+    _Atomic(uintptr_t)  next;   ///< Address of the next element, with bit 0 set once the element is logically removed
+    uint8_t             data[]; ///< Payload of the element
+};
+
+/********************************************************
+ * @brief Lock-free sorted list (Harris-Michael algorithm)
+ * @note Threads must register before using the list, and use their slot in every call
+********************************************************/
+typedef struct
+{
+    _Atomic(uintptr_t)      head;       ///< Address of the first element
+    atomic_uint_fast32_t    nbelements; ///< Number of elements in the list
+    epochs_t                epochs;     ///< Reclamation domain of the elements removed
+} lflist_t;
+
+//lists manipulations
+int initialise_lockfree_list(meta_t* meta);
+int free_lockfree_list(meta_t* meta);
+int register_lockfree_list(meta_t* meta);
+void unregister_lockfree_list(meta_t* meta, int slot);
+int insertLockFreeList(meta_t* meta, int slot, const void* toAdd);
+int removeLockFreeList(meta_t* meta, int slot, const void* toRemove);
+
+//search algorithms
+int find_lockfree_listelem(meta_t* meta, int slot, const void* toSearch, void* found);
+uint32_t get_lockfree_list_count(meta_t* meta);
+
+//lists functor
+int foreachLockFreeList(meta_t* meta, int slot, void* parameter, int (*doAction)(void*, void*));
+
+#endif // CLOCKFREELISTS_H_INCLUDED
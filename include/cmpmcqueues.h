@@ -0,0 +1,48 @@
+#ifndef CMPMCQUEUES_H_INCLUDED
+#define CMPMCQUEUES_H_INCLUDED
+#include <stdatomic.h>
+#include <threads.h>
+#include "cstructurescommon.h"
+
+#define MPMC_CACHELINE      64U         ///< Size of a cache line, on which the indices are padded
+#define MPMC_ALIGNMENT      8U          ///< Alignment of the slots in the buffer
+#define MPMC_MAX_CAPACITY   (1U << 30)  ///< Maximum capacity of a MPMC queue
+
+/********************************************************
+ * @brief Bounded queue shared by any number of producer and consumer threads
+ * @note Each slot holds a sequence number telling whether it is ready to be
+ *       written (sequence == position) or read (sequence == position + 1),
+ *       so the threads only compete on the head or tail index they increment.
+ *       The lock and conditions are only used by the blocking variants,
+ *       to sleep while the queue is full or empty.
+********************************************************/
+typedef struct
+{
+    uint8_t*                            slots;          ///< Buffer holding the sequence numbers and elements
+    uint32_t                            capacity;       ///< Number of elements the buffer can hold (power of two)
+    uint32_t                            stride;         ///< Size of a slot in the buffer (sequence number + aligned element)
+    mtx_t                               lock;           ///< Lock protecting the sleep of the blocked threads
+    cnd_t                               notEmpty;       ///< Condition signalled when an element is pushed
+    cnd_t                               notFull;        ///< Condition signalled when an element is popped
+    atomic_uint                         pushWaiting;    ///< Number of producers sleeping
+    atomic_uint                         popWaiting;     ///< Number of consumers sleeping
+    _Alignas(MPMC_CACHELINE) atomic_uint tail;          ///< Position at which the next element is pushed
+    _Alignas(MPMC_CACHELINE) atomic_uint head;          ///< Position from which the next element is popped
+} mpmcqueue_t;
+
+//MPMC queues manipulations
+int initialise_MPMC_queue(meta_t* meta, uint32_t capacity);
+int free_MPMC_queue(meta_t* meta);
+
+//non-blocking operations
+int tryPushMPMCQueue(meta_t* meta, const void* toAdd);
+int tryPopMPMCQueue(meta_t* meta, void* popped);
+
+//blocking operations
+int pushMPMCQueue(meta_t* meta, const void* toAdd);
+int popMPMCQueue(meta_t* meta, void* popped);
+
+//search algorithms
+uint32_t get_MPMC_queue_count(meta_t* meta);
+
+#endif // CMPMCQUEUES_H_INCLUDED
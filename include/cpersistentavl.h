@@ -0,0 +1,44 @@
+#ifndef CPERSISTENTAVL_H_INCLUDED
+#define CPERSISTENTAVL_H_INCLUDED
+#include <stdatomic.h>
+#include <stddef.h>
+#include "cstructurescommon.h"
+
+/********************************************************
+ * @brief Forward-declaration of pavlnode_t structures
+********************************************************/
+typedef struct pavlnode_t pavlnode_t;
+
+/********************************************************
+ * @brief Immutable node of a persistent AVL
+ * @note A version of the AVL is designated by its root node.
+ *       Nodes are shared between versions, and freed once
+ *       no parent nor version handle references them anymore.
+********************************************************/
+struct pavlnode_t
+{
+    pavlnode_t*                 left;   ///< Root of the left subtree
+    pavlnode_t*                 right;  ///< Root of the right subtree
+    atomic_uint                 refs;   ///< Number of parents and version handles referencing the node
+    uint32_t                    count;  ///< Number of elements in the subtree
+    int16_t                     height; ///< Height of the subtree
+    _Alignas(max_align_t) uint8_t data[]; ///< Payload of the element
+};
+
+//persistent AVL manipulations
+int insertPersistentAVL(meta_t* meta, const void* toAdd);
+int removePersistentAVL(meta_t* meta, const void* toRemove);
+int free_persistent_AVL(meta_t* meta);
+
+//versions
+pavlnode_t* snapshot_persistent_AVL(meta_t* meta);
+void release_persistent_AVL(pavlnode_t* version);
+
+//search algorithms
+void* search_persistent_AVL(meta_t* meta, pavlnode_t* version, const void* key);
+uint32_t get_persistent_AVL_count(pavlnode_t* version);
+
+//persistent AVL functor
+int foreachPersistentAVL(meta_t* meta, pavlnode_t* version, void* parameter, int (*doAction)(void*, void*));
+
+#endif // CPERSISTENTAVL_H_INCLUDED
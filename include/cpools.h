@@ -0,0 +1,56 @@
+#ifndef CPOOLS_H_INCLUDED
+#define CPOOLS_H_INCLUDED
+#include "cstructurescommon.h"
+
+#define POOL_NONE       UINT32_MAX  ///< Index used as a NULL link in a pool
+#define POOL_ALIGNMENT  8U          ///< Alignment of the payloads in a pool
+
+/********************************************************
+ * @brief Links of an element stored in a pool
+ * @note The payload immediately follows the links in the pool block
+********************************************************/
+typedef struct
+{
+    uint32_t    left;   ///< Index of the element to the left of the current one
+    uint32_t    right;  ///< Index of the element to the right of the current one
+} poolnode_t;
+
+/********************************************************
+ * @brief Contiguous block of index-linked elements
+ * @note As links are indices, the block can be moved or written as-is
+********************************************************/
+typedef struct
+{
+    uint8_t*    nodes;      ///< Block holding the links and payloads of all the elements
+    uint32_t    capacity;   ///< Number of elements the block can hold
+    uint32_t    stride;     ///< Size of an element in the block (links + aligned payload)
+    uint32_t    head;       ///< Index of the first element
+    uint32_t    tail;       ///< Index of the last element
+    uint32_t    freelist;   ///< Index of the first released element
+    uint32_t    used;       ///< Number of elements ever handed out by the block
+} pool_t;
+
+//pool manipulations
+int initialise_pool(meta_t* meta, uint32_t capacity);
+int free_pool(meta_t* meta);
+
+//lists manipulations
+int insertPoolTop(meta_t* meta, const void* toAdd);
+int insertPoolBottom(meta_t* meta, const void* toAdd);
+int insertPoolSorted(meta_t* meta, const void* toAdd);
+int popPoolTop(meta_t* meta, void* popped);
+int popPoolBottom(meta_t* meta, void* popped);
+
+//queues and stacks manipulations
+int pushPoolQueue(meta_t* meta, const void* toAdd);
+int popPoolQueue(meta_t* meta, void* popped);
+int pushPoolStack(meta_t* meta, const void* toAdd);
+int popPoolStack(meta_t* meta, void* popped);
+
+//search algorithms
+void* get_poolelem(meta_t* meta, uint32_t i);
+
+//pools functor
+int foreachPool(meta_t* meta, void* parameter, int (*doAction)(void*, void*));
+
+#endif // CPOOLS_H_INCLUDED
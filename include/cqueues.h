@@ -6,6 +6,8 @@
 int pushQueue(meta_t*,  const void*);
 int pushPriorityQueue(meta_t*,  const void*);
 void* popQueue(meta_t* meta);
+int pushQueueBatch(meta_t* meta, const void* toAdd, uint32_t nb);
+uint32_t popQueueBatch(meta_t* meta, void* popped, uint32_t nb);
 
 //queues functors
 int foreachQueue(meta_t* meta, void* parameter, int (*doAction)(void*, void*));
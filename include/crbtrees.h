@@ -0,0 +1,19 @@
+#ifndef CRBTREES_H_INCLUDED
+#define CRBTREES_H_INCLUDED
+#include "cstructurescommon.h"
+
+#define RBT_MAX_HEIGHT  64U ///< Maximum height of a red-black tree (2 * log2(n + 1), so 64 for 2^32 elements)
+
+//red-black tree manipulation
+dyndata_t* insertRBT(meta_t* meta, dyndata_t* rbt, void* toAdd);
+dyndata_t* delete_RBT(meta_t* meta, dyndata_t* root, void* key);
+int delete_RBT_root(meta_t* meta);
+int delete_RBT_key(meta_t* meta, const void* key);
+
+//search algorithms
+void* search_RBT(meta_t* meta, dyndata_t* rbt, void* key);
+
+//red-black tree functor
+int foreachRBT(meta_t* meta, dyndata_t* rbt, void* parameter, int (*doAction)(void*, void*));
+
+#endif // CRBTREES_H_INCLUDED
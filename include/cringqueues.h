@@ -0,0 +1,34 @@
+#ifndef CRINGQUEUES_H_INCLUDED
+#define CRINGQUEUES_H_INCLUDED
+#include "cstructurescommon.h"
+
+#define RING_ALIGNMENT      8U          ///< Alignment of the elements in a ring queue
+#define RING_MAX_CAPACITY   (1U << 31)  ///< Maximum capacity of a ring queue
+
+/********************************************************
+ * @brief Queue storing its elements inline in a circular buffer
+ * @note Head and tail are never wrapped : they only grow, and are reduced
+ *       to a slot with the capacity mask (a power of two)
+********************************************************/
+typedef struct
+{
+    uint8_t*    elements;   ///< Buffer holding the elements
+    uint32_t    capacity;   ///< Number of elements the buffer can hold (power of two)
+    uint32_t    stride;     ///< Size of an element in the buffer (aligned)
+    uint32_t    head;       ///< Index of the first element
+    uint32_t    tail;       ///< Index following the last element
+} ringqueue_t;
+
+//ring queues manipulations
+int initialise_ring_queue(meta_t* meta, uint32_t capacity);
+int free_ring_queue(meta_t* meta);
+int pushRingQueue(meta_t* meta, const void* toAdd);
+int popRingQueue(meta_t* meta, void* popped);
+
+//search algorithms
+void* get_ringelem(meta_t* meta, uint32_t i);
+
+//ring queues functor
+int foreachRingQueue(meta_t* meta, void* parameter, int (*doAction)(void*, void*));
+
+#endif // CRINGQUEUES_H_INCLUDED
@@ -0,0 +1,69 @@
+#ifndef CSCHEDULERS_H_INCLUDED
+#define CSCHEDULERS_H_INCLUDED
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include "cstructurescommon.h"
+
+#define SCHEDULER_CACHELINE     64U     ///< Size of a cache line, on which the workers are padded
+#define SCHEDULER_MAX_WORKERS   256U    ///< Maximum number of worker threads
+#define SCHEDULER_DEQUE_SIZE    256U    ///< Initial capacity of the deque of each worker
+#define SCHEDULER_INBOX_SIZE    1024U   ///< Capacity of the queue of the tasks submitted from outside the workers
+
+/********************************************************
+ * @brief Task run by a scheduler
+********************************************************/
+typedef struct
+{
+    int     (*doTask)(void*);   ///< Function to run (returns -1 on error)
+    void*   argument;           ///< Argument given to the function
+} task_t;
+
+/********************************************************
+ * @brief Forward-declaration of scheduler_t structures
+********************************************************/
+typedef struct scheduler_t scheduler_t;
+
+/********************************************************
+ * @brief Worker thread of a scheduler
+ * @note Padded to a cache line so that the workers do not share theirs
+********************************************************/
+typedef struct
+{
+    _Alignas(SCHEDULER_CACHELINE) meta_t    deque;      ///< Work-stealing deque of the tasks created by the worker
+    scheduler_t*                            scheduler;  ///< Scheduler running the worker
+    thrd_t                                  thread;     ///< Thread of the worker
+    uint32_t                                index;      ///< Index of the worker
+    uint32_t                                seed;       ///< State of the random choice of the workers to steal from
+} schedworker_t;
+
+/********************************************************
+ * @brief Fixed pool of worker threads balancing their tasks by work stealing
+ * @note Tasks submitted by a worker go to its own deque, the others go to a
+ *       shared inbox. Idle workers steal from the others, and sleep once
+ *       there is nothing left to steal.
+********************************************************/
+struct scheduler_t
+{
+    schedworker_t*  workers;        ///< Worker threads
+    uint32_t        nbworkers;      ///< Number of worker threads
+    meta_t          inbox;          ///< MPMC queue of the tasks submitted from outside the workers
+    mtx_t           lock;           ///< Lock protecting the sleep of the workers and waiters
+    cnd_t           wake;           ///< Condition signalled when a task is submitted
+    cnd_t           idle;           ///< Condition signalled when every task submitted is done
+    atomic_uint     pending;        ///< Number of tasks submitted and not done yet
+    atomic_uint     sleeping;       ///< Number of workers sleeping
+    atomic_int      status;         ///< -1 if a task failed since the last wait, 0 otherwise
+    atomic_bool     stop;           ///< Set to stop the workers
+    void            (*doPError)(const char* msg, ...);  ///< Error printing method (can be NULL)
+};
+
+//schedulers manipulations
+int initialise_scheduler(scheduler_t* scheduler, uint32_t nbworkers, void (*doPError)(const char*, ...));
+int free_scheduler(scheduler_t* scheduler);
+
+//tasks
+int submit_scheduler(scheduler_t* scheduler, int (*doTask)(void*), void* argument);
+int wait_scheduler(scheduler_t* scheduler);
+
+#endif // CSCHEDULERS_H_INCLUDED
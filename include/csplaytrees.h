@@ -0,0 +1,16 @@
+#ifndef CSPLAYTREES_H_INCLUDED
+#define CSPLAYTREES_H_INCLUDED
+#include "cstructurescommon.h"
+
+//splay tree manipulation
+int insertSplay(meta_t* meta, const void* toAdd);
+int delete_Splay_key(meta_t* meta, const void* key);
+int delete_Splay_root(meta_t* meta);
+
+//search algorithms
+void* search_Splay(meta_t* meta, const void* key);
+
+//splay tree functor
+int foreachSplay(meta_t* meta, void* parameter, int (*doAction)(void*, void*));
+
+#endif // CSPLAYTREES_H_INCLUDED
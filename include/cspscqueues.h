@@ -0,0 +1,43 @@
+#ifndef CSPSCQUEUES_H_INCLUDED
+#define CSPSCQUEUES_H_INCLUDED
+#include <stdatomic.h>
+#include "cstructurescommon.h"
+
+#define SPSC_CACHELINE      64U         ///< Size of a cache line, on which the indices are padded
+#define SPSC_ALIGNMENT      8U          ///< Alignment of the elements in the buffer
+#define SPSC_MAX_CAPACITY   (1U << 31)  ///< Maximum capacity of a SPSC queue
+
+/********************************************************
+ * @brief Bounded queue between one producer thread and one consumer thread
+ * @note Each index is written by one thread only, and lives on its own cache line
+ *       along with the last value of the other index read by that thread. A thread
+ *       therefore only reads the line of the other one when its cached value
+ *       does not allow it to proceed.
+********************************************************/
+typedef struct
+{
+    uint8_t*                            elements;   ///< Buffer holding the elements
+    uint32_t                            capacity;   ///< Number of elements the buffer can hold (power of two)
+    uint32_t                            stride;     ///< Size of an element in the buffer (aligned)
+    _Alignas(SPSC_CACHELINE) atomic_uint tail;      ///< Index following the last element published (written by the producer)
+    uint32_t                            headcache;  ///< Last head read by the producer
+    _Alignas(SPSC_CACHELINE) atomic_uint head;      ///< Index of the first element (written by the consumer)
+    uint32_t                            tailcache;  ///< Last tail read by the consumer
+} spscqueue_t;
+
+//SPSC queues manipulations
+int initialise_SPSC_queue(meta_t* meta, uint32_t capacity);
+int free_SPSC_queue(meta_t* meta);
+
+//producer side
+int pushSPSCQueue(meta_t* meta, const void* toAdd);
+uint32_t pushSPSCQueueBatch(meta_t* meta, const void* toAdd, uint32_t nb);
+
+//consumer side
+int popSPSCQueue(meta_t* meta, void* popped);
+uint32_t popSPSCQueueBatch(meta_t* meta, void* popped, uint32_t nb);
+
+//search algorithms
+uint32_t get_SPSC_queue_count(meta_t* meta);
+
+#endif // CSPSCQUEUES_H_INCLUDED
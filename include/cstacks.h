@@ -5,6 +5,8 @@
 //queues manipulations
 int pushStack(meta_t*,  const void*);
 void* popStack(meta_t* meta);
+int pushStackBatch(meta_t* meta, const void* toAdd, uint32_t nb);
+uint32_t popStackBatch(meta_t* meta, void* popped, uint32_t nb);
 
 //queues functors
 int foreachStack(meta_t* meta, void* parameter, int (*doAction)(void*, void*));
@@ -3,8 +3,24 @@
 #include "carrays.h"
 #include "clists.h"
 #include "cavl.h"
+#include "cbtrees.h"
+#include "cconcurrentavl.h"
+#include "cpersistentavl.h"
+#include "crbtrees.h"
+#include "csplaytrees.h"
 #include "cqueues.h"
+#include "cringqueues.h"
+#include "cspscqueues.h"
+#include "cmpmcqueues.h"
+#include "cheaps.h"
+#include "cbucketqueues.h"
 #include "cstacks.h"
+#include "carraystacks.h"
+#include "ctreiberstacks.h"
+#include "cworkdeques.h"
+#include "cschedulers.h"
+#include "cpools.h"
+#include "clockfreelists.h"
 
 //enums
 typedef enum {COPY, REPLACE} e_listtoarray;
@@ -13,5 +29,7 @@ typedef enum {COPY, REPLACE} e_listtoarray;
 int listToArray(meta_t* dList, meta_t* dArray, e_listtoarray action);
 int arrayToList(meta_t* dArray, meta_t* dList, e_listtoarray action);
 int arrayToAVL(meta_t* dArray, meta_t* dAVL, e_listtoarray action);
+int sortedArrayToAVL(meta_t* dArray, meta_t* dAVL, e_listtoarray action);
+int sortedListToAVL(meta_t* dList, meta_t* dAVL, e_listtoarray action);
 
 #endif // CSTRUCTURES_H_INCLUDED
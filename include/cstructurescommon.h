@@ -2,6 +2,12 @@
 #define CSTRUCTURESCOMMON_H_INCLUDED
 #include <stdint.h>
 
+//bits of dyndata_t::flags, one per user so the structures never clash
+#define DYN_BLOCK       0x0001U ///< Element allocated within a block of elements (see allocate_dyn_block())
+#define RBT_RED         0x0002U ///< Red node of a red-black tree (black otherwise)
+#define AVL_MULTISET    0x0004U ///< Node of a multiset AVL (data followed by an occurrences counter)
+#define CAVL_FRESH      0x8000U ///< Node of a concurrent AVL created by the current writer, not published yet
+
 /********************************************************
  * @brief Forward-declaration of dyndata_t structures
  * @note Mandatory to use a reference of a structure in itself
@@ -14,7 +20,9 @@ typedef struct dyndata_t dyndata_t;
 struct dyndata_t
 {
     void*       data;   ///< Address of the memory used by the element
-    int         height; ///< Height of the element in the structure @note Used in AVL trees
+    int16_t     height; ///< Height of the element in the structure @note Used in AVL trees
+    uint16_t    flags;  ///< Flags of the element (DYN_BLOCK, RBT_RED, AVL_MULTISET or CAVL_FRESH)
+    uint32_t    count;  ///< Number of elements in the subtree of the element @note Used in AVL trees
     dyndata_t*  left;   ///< Address of the element to the left of the current one
     dyndata_t*  right;  ///< Address of the element to the right of the current one
 };
@@ -35,6 +43,7 @@ typedef struct
 //container elements manipulations
 void initialise_structure(meta_t* meta, const uint32_t elementSize, int (*compare)(const void*, const void*), void (*printError)(const char* msg, ...));
 dyndata_t* allocate_dyn(meta_t* meta, const void* elem);
+dyndata_t* allocate_dyn_block(meta_t* meta, const void* elems, uint32_t nb);
 int free_dyn(dyndata_t** elem);
 int swap_dyn(dyndata_t* a, dyndata_t* b);
 void* getdata(dyndata_t* cur);
@@ -0,0 +1,36 @@
+#ifndef CTREIBERSTACKS_H_INCLUDED
+#define CTREIBERSTACKS_H_INCLUDED
+#include <stdatomic.h>
+#include "cstructurescommon.h"
+
+#define TREIBER_CACHELINE       64U                 ///< Size of a cache line, on which the heads are padded
+#define TREIBER_ALIGNMENT       8U                  ///< Alignment of the elements in the nodes
+#define TREIBER_MAX_CAPACITY    (UINT32_MAX - 1U)   ///< Maximum capacity of a Treiber stack
+#define TREIBER_NONE            UINT32_MAX          ///< Index designating no node
+
+/********************************************************
+ * @brief Lock-free stack shared by any number of threads (Treiber algorithm)
+ * @note The nodes are taken from a pool allocated once, and linked by index.
+ *       Each head packs the index of the top node (low 32 bits) with a tag
+ *       (high 32 bits) incremented on every change, so a thread holding a
+ *       stale head fails its CAS even if the same node is back on top (ABA).
+ *       Free nodes are kept in a second tagged stack.
+ *       No element counter is kept, as it would be another contended line.
+********************************************************/
+typedef struct
+{
+    uint8_t*                                    nodes;      ///< Pool holding the nodes (next index + element)
+    uint32_t                                    capacity;   ///< Number of nodes in the pool
+    uint32_t                                    stride;     ///< Size of a node in the pool (aligned)
+    _Alignas(TREIBER_CACHELINE) _Atomic(uint64_t) top;       ///< Tagged index of the top node of the stack
+    _Alignas(TREIBER_CACHELINE) _Atomic(uint64_t) freenodes; ///< Tagged index of the first free node
+} treiberstack_t;
+
+//Treiber stacks manipulations
+int initialise_treiber_stack(meta_t* meta, uint32_t capacity);
+int free_treiber_stack(meta_t* meta);
+int pushTreiberStack(meta_t* meta, const void* toAdd);
+int popTreiberStack(meta_t* meta, void* popped);
+int popAllTreiberStack(meta_t* meta, void* parameter, int (*doAction)(void*, void*));
+
+#endif // CTREIBERSTACKS_H_INCLUDED
@@ -0,0 +1,54 @@
+#ifndef CWORKDEQUES_H_INCLUDED
+#define CWORKDEQUES_H_INCLUDED
+#include <stdatomic.h>
+#include "cstructurescommon.h"
+
+#define WORKDEQUE_CACHELINE     64U         ///< Size of a cache line, on which the indices are padded
+#define WORKDEQUE_MAX_CAPACITY  (1U << 30)  ///< Maximum capacity of a work-stealing deque
+
+/********************************************************
+ * @brief Forward-declaration of workarray_t structures
+********************************************************/
+typedef struct workarray_t workarray_t;
+
+/********************************************************
+ * @brief Circular array of a work-stealing deque
+ * @note The elements are stored as atomic 64-bit words, so a thief copying
+ *       an element being overwritten only gets a value it then discards
+********************************************************/
+struct workarray_t
+{
+    workarray_t*        retired;    ///< Array replaced by this one, freed with the deque
+    uint32_t            capacity;   ///< Number of elements the array can hold (power of two)
+    _Atomic(uint64_t)   words[];    ///< Words of the elements
+};
+
+/********************************************************
+ * @brief Work-stealing deque (Chase-Lev algorithm)
+ * @note Only the owner thread pushes and pops, at the bottom, while any
+ *       other thread can steal from the top. The owner and the thieves only
+ *       compete (with a CAS on the top) for the last element.
+********************************************************/
+typedef struct
+{
+    _Atomic(workarray_t*)                           array;      ///< Current array of the deque
+    uint32_t                                        nbwords;    ///< Number of words per element
+    _Alignas(WORKDEQUE_CACHELINE) _Atomic(int64_t)  top;        ///< Position of the element stolen next
+    _Alignas(WORKDEQUE_CACHELINE) _Atomic(int64_t)  bottom;     ///< Position at which the owner pushes next
+} workdeque_t;
+
+//work-stealing deques manipulations
+int initialise_work_deque(meta_t* meta, uint32_t capacity);
+int free_work_deque(meta_t* meta);
+
+//owner operations
+int pushWorkDeque(meta_t* meta, const void* toAdd);
+int popWorkDeque(meta_t* meta, void* popped);
+
+//thieves operations
+int stealWorkDeque(meta_t* meta, void* stolen);
+
+//search algorithms
+uint32_t get_work_deque_count(meta_t* meta);
+
+#endif // CWORKDEQUES_H_INCLUDED
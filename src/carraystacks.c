@@ -0,0 +1,303 @@
+/**
+ * @file carraystacks.c
+ * @brief Implement stacks storing their elements inline in a growing array
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note Unlike pushStack() and popStack(), no node is allocated per element :
+ *       the array doubles when full and is never shrunk, so a stack which
+ *       reached its working size pushes and pops with a single memcpy().
+ */
+#include "carraystacks.h"
+#include <stdlib.h>
+#include <string.h>
+
+//array stacks internal functions
+static uint8_t* get_arraystack_elem(const meta_t* meta, const arraystack_t* stack, uint32_t i);
+static int reserve_array_stack(meta_t* meta, arraystack_t* stack, uint32_t nb);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Allocate the array of a stack
+ * @note The structure must have been initialised with initialise_structure() beforehand
+ *
+ * @param meta      Metadata of the stack
+ * @param capacity  Number of elements to reserve (the array grows on demand)
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_array_stack(meta_t* meta, uint32_t capacity){
+    arraystack_t* stack = NULL;
+
+    if(!meta || !meta->elementsize)
+        return -1;
+
+    stack = calloc(1, sizeof(arraystack_t));
+    if(!stack)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_array_stack: stack could not be allocated");
+
+        return -1;
+    }
+
+    meta->structure = stack;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    if(capacity && reserve_array_stack(meta, stack, capacity) < 0)
+    {
+        free_array_stack(meta);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Free the memory of a stack and its elements
+ *
+ * @param meta Metadata of the stack
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_array_stack(meta_t* meta){
+    arraystack_t* stack = NULL;
+
+    if(!meta)
+        return -1;
+
+    stack = meta->structure;
+    if(stack)
+    {
+        free(stack->elements);
+        free(stack);
+    }
+
+    meta->structure = NULL;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Push a new element on top of a stack
+ *
+ * @param meta  Metadata of the stack
+ * @param toAdd Element to push
+ * @retval  0 Element pushed
+ * @retval -1 Error
+ */
+int pushArrayStack(meta_t* meta, const void* toAdd){
+    arraystack_t* stack = NULL;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("pushArrayStack: new element cannot be NULL");
+
+        return -1;
+    }
+
+    stack = meta->structure;
+    if(meta->nbelements == stack->capacity && reserve_array_stack(meta, stack, meta->nbelements + 1) < 0)
+        return -1;
+
+    memcpy(get_arraystack_elem(meta, stack, meta->nbelements), toAdd, meta->elementsize);
+    meta->nbelements++;
+
+    return 0;
+}
+
+/**
+ * @brief Push several elements on top of a stack, in one copy
+ * @note The last element of the array ends up on top
+ *
+ * @param meta  Metadata of the stack
+ * @param toAdd Array of nb elements to push
+ * @param nb    Number of elements to push
+ * @retval  0 Elements pushed
+ * @retval -1 Error (nothing pushed)
+ */
+int pushArrayStackBatch(meta_t* meta, const void* toAdd, uint32_t nb){
+    arraystack_t* stack = NULL;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!toAdd && nb)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("pushArrayStackBatch: new elements cannot be NULL");
+
+        return -1;
+    }
+
+    stack = meta->structure;
+    if(nb > ARRAYSTACK_MAX_CAPACITY - meta->nbelements || reserve_array_stack(meta, stack, meta->nbelements + nb) < 0)
+        return -1;
+
+    if(nb)
+        memcpy(get_arraystack_elem(meta, stack, meta->nbelements), toAdd, (size_t)nb * meta->elementsize);
+    meta->nbelements += nb;
+
+    return 0;
+}
+
+/**
+ * @brief Pop the element on top of a stack
+ *
+ * @param meta      Metadata of the stack
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval  1 Popped
+ * @retval  0 Stack empty
+ * @retval -1 Error
+ */
+int popArrayStack(meta_t* meta, void* popped){
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!meta->nbelements)
+        return 0;
+
+    meta->nbelements--;
+    if(popped)
+        memcpy(popped, get_arraystack_elem(meta, meta->structure, meta->nbelements), meta->elementsize);
+
+    return 1;
+}
+
+/**
+ * @brief Pop several elements from the top of a stack, in one copy
+ * @note The elements are copied in the order they were pushed (the former top last),
+ *       so popping a batch gives back the array of the matching pushArrayStackBatch()
+ *
+ * @param meta      Metadata of the stack
+ * @param popped    Array in which copy the elements (can be NULL)
+ * @param nb        Maximum number of elements to pop
+ * @return          Number of elements popped
+ */
+uint32_t popArrayStackBatch(meta_t* meta, void* popped, uint32_t nb){
+    if(!meta || !meta->structure)
+        return 0;
+
+    if(nb > meta->nbelements)
+        nb = meta->nbelements;
+
+    meta->nbelements -= nb;
+    if(popped && nb)
+        memcpy(popped, get_arraystack_elem(meta, meta->structure, meta->nbelements), (size_t)nb * meta->elementsize);
+
+    return nb;
+}
+
+/**
+ * @brief Get the element on top of a stack, without popping it
+ *
+ * @param meta  Metadata of the stack
+ * @return      Element on top of the stack
+ * @retval NULL Stack empty or error
+ */
+void* peekArrayStack(meta_t* meta){
+    if(!meta || !meta->structure || !meta->nbelements)
+        return NULL;
+
+    return get_arraystack_elem(meta, meta->structure, meta->nbelements - 1);
+}
+
+/**
+ * @brief Perform an action on every element of a stack, from the top to the bottom
+ *
+ * @param meta      Metadata of the stack
+ * @param parameter Parameter used by the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 Action performed
+ * @retval -1 Error
+ */
+int foreachArrayStack(meta_t* meta, void* parameter, int (*doAction)(void*, void*)){
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!doAction)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachArrayStack: action to perform not defined");
+
+        return -1;
+    }
+
+    for(uint32_t i = meta->nbelements ; i > 0 ; i--)
+    {
+        if((*doAction)(get_arraystack_elem(meta, meta->structure, i - 1), parameter) < 0)
+        {
+            if(meta->doPError)
+                (*meta->doPError)("foreachArrayStack: action specified returned with an error");
+
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get the address of an element in the stack array
+ *
+ * @param meta  Metadata of the stack
+ * @param stack Stack in which get the element
+ * @param i     Index of the element (0 being the bottom)
+ * @return      Address of the element
+ */
+static uint8_t* get_arraystack_elem(const meta_t* meta, const arraystack_t* stack, uint32_t i){
+    return stack->elements + ((size_t)i * meta->elementsize);
+}
+
+/**
+ * @brief Make sure a stack array can hold a number of elements, doubling its capacity if needed
+ *
+ * @param meta  Metadata of the stack
+ * @param stack Stack to grow
+ * @param nb    Number of elements to hold
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+static int reserve_array_stack(meta_t* meta, arraystack_t* stack, uint32_t nb){
+    uint8_t* elements = NULL;
+    uint32_t capacity = (stack->capacity ? stack->capacity : 16);
+
+    if(nb <= stack->capacity)
+        return 0;
+
+    if(nb > ARRAYSTACK_MAX_CAPACITY)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("reserve_array_stack: maximum capacity reached");
+
+        return -1;
+    }
+
+    while(capacity < nb)
+        capacity *= 2;
+
+    elements = realloc(stack->elements, (size_t)capacity * meta->elementsize);
+    if(!elements)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("reserve_array_stack: array of %u elements could not be allocated", capacity);
+
+        return -1;
+    }
+
+    stack->elements = elements;
+    stack->capacity = capacity;
+
+    return 0;
+}
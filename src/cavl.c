@@ -4,13 +4,73 @@
  * @author Gilles Henrard
  * @date 13/12/2023
  */
-#include "cavl.h"
+#include "cavlinternal.h"
+#include <stdatomic.h>
+#include <stdlib.h>
 #include <string.h>
+#include <threads.h>
+
+#define AVL_OCCURRENCES_OFFSET(meta)    (((meta)->elementsize + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1))              ///< Offset of the occurrences counter in the data of a multiset node
+#define AVL_OCCURRENCES(meta, data)     ((uint32_t*)((uint8_t*)(data) + AVL_OCCURRENCES_OFFSET(meta)))                    ///< Occurrences counter of a multiset node
+#define AVL_TASKS_PER_THREAD            4U                                                                                  ///< Subtrees handed to each thread of a parallel traversal, to even out the workloads
+
+/********************************************************
+ * @brief Part of an AVL browsed by a thread of a parallel traversal
+********************************************************/
+typedef struct
+{
+    dyndata_t*  node;   ///< Root of the subtree, or single element
+    uint8_t     whole;  ///< 1 if the whole subtree is browsed, 0 if only the node is
+} avltask_t;
+
+/********************************************************
+ * @brief Parallel traversal of an AVL in progress
+ * @note The tasks are listed in ascending order, so the partial results
+ *       of a reduction can be combined in the order of the elements
+********************************************************/
+typedef struct
+{
+    meta_t*     meta;                           ///< Metadata of the AVL
+    avltask_t*  tasks;                          ///< Parts of the AVL to browse, in ascending order
+    uint32_t    nbtasks;                        ///< Number of tasks
+    atomic_uint next;                           ///< Index of the next task to hand out
+    atomic_int  status;                         ///< 0 while browsing, 1 if stopped by the action, -1 on error
+    uint8_t*    partials;                       ///< Partial result of each task (NULL if no reduction)
+    uint32_t    partialsize;                    ///< Size of a partial result
+    void*       parameter;                      ///< Parameter for the action to perform
+    int         (*doAction)(void*, void*);      ///< Action to perform on each element
+    mtx_t       lock;                           ///< Lock protecting the number of workers running
+    cnd_t       done;                           ///< Condition signalled when the last worker is done
+    uint32_t    running;                        ///< Number of workers submitted to the scheduler and not done yet
+} avlparallel_t;
 
 //AVL internal functions
-static dyndata_t* rotate_AVL(dyndata_t* avl, e_rotation side);
-static int get_AVL_balance(dyndata_t* avl);
-static dyndata_t* delete_AVL(meta_t* meta, dyndata_t* root, void* key);
+static uint32_t get_AVL_count(dyndata_t* avl);
+static uint32_t rank_AVL_key(meta_t* meta, const void* key, int inclusive);
+static void* bound_AVL(meta_t* meta, const void* key, int strict, avliterator_t* it);
+static void push_AVL_iterator(avliterator_t* it, dyndata_t* node, e_rotation side);
+static dyndata_t* delete_AVL_sorted(meta_t* meta, dyndata_t* avl, const void* keys, uint32_t nb, uint32_t* removed);
+static dyndata_t* delete_AVL_between(meta_t* meta, dyndata_t* avl, const void* low, const void* high, uint32_t* removed);
+static int16_t get_AVL_height(dyndata_t* avl);
+static dyndata_t* join_AVL_right(dyndata_t* left, dyndata_t* middle, dyndata_t* right);
+static dyndata_t* join_AVL_left(dyndata_t* left, dyndata_t* middle, dyndata_t* right);
+static dyndata_t* join2_AVL(dyndata_t* left, dyndata_t* right);
+static dyndata_t* split_AVL_last(dyndata_t* avl, dyndata_t** last);
+static void free_AVL_node(dyndata_t* avl);
+static dyndata_t* union_AVL_node(meta_t* meta, dyndata_t* a, dyndata_t* b);
+static dyndata_t* intersect_AVL_node(meta_t* meta, dyndata_t* a, dyndata_t* b);
+static dyndata_t* difference_AVL_node(meta_t* meta, dyndata_t* a, dyndata_t* b);
+static int check_AVL_setoperands(meta_t* dst, meta_t* src, const char* func);
+static dyndata_t* allocate_AVL_multinode(meta_t* meta, const void* elem);
+static dyndata_t* find_AVL_multinode(meta_t* meta, const void* key, const char* func);
+static int delete_AVL_node(meta_t* meta, dyndata_t** avl, const void* key, uint8_t occurrence);
+static int insert_AVL_node(meta_t* meta, dyndata_t** avl, const void* toAdd, dyndata_t* (*doAllocate)(meta_t*, const void*), dyndata_t** node);
+static void gather_AVL_tasks(avlparallel_t* job, dyndata_t* avl, uint8_t depth);
+static void browse_AVL_task(avlparallel_t* job, dyndata_t* avl, void* parameter);
+static void apply_AVL_action(avlparallel_t* job, void* data, void* parameter);
+static int parallel_AVL_worker(void* job);
+static int parallel_AVL_task(void* job);
+static int run_AVL_parallel(avlparallel_t* job, scheduler_t* scheduler);
 
 
 /*********************************************************************************************/
@@ -19,6 +79,7 @@ static dyndata_t* delete_AVL(meta_t* meta, dyndata_t* root, void* key);
 
 /**
  * @brief Insert an element in an AVL
+ * @note The path is kept in a stack instead of recursing, and each level is compared once
  * 
  * @param meta  Metadata necessary to the algorithm
  * @param avl   AVL tree to which add the element
@@ -27,76 +88,325 @@ static dyndata_t* delete_AVL(meta_t* meta, dyndata_t* root, void* key);
  * @retval NULL Failure
  */
 dyndata_t* insertAVL(meta_t* meta, dyndata_t* avl, void* toAdd){
-    int height_left=0, height_right=0, balance=0;
+    dyndata_t *node = NULL;
 
     if(!meta)
         return NULL;
 
     //if tree is empty
-    if(!avl){
-        if(!meta->structure)
-            meta->nbelements = 0;
+    if(!avl && !meta->structure)
+        meta->nbelements = 0;
 
-        //memory allocation for the new element
-        avl = allocate_dyn(meta, toAdd);
-        if(!avl)
-            return NULL;
+    //duplicates are ignored (forbidden in AVL trees)
+    insert_AVL_node(meta, &avl, toAdd, allocate_dyn, &node);
+    return avl;
+}
 
-        meta->nbelements++;
-        return avl;
+/**
+ * @brief Insert an element in the AVL, or merge it with the element with the same key
+ * @note The AVL is descended only once, whether the key exists or not
+ * @warning The merge must not modify the key of the existing element
+ * 
+ * @param meta      Metadata necessary to the algorithm
+ * @param toAdd     Element to insert or merge
+ * @param doMerge   Function merging the new element into the existing one (replaces it if NULL)
+ * @retval 1    The key already existed and the elements were merged
+ * @retval 0    The element was inserted
+ * @retval -1   Error
+ */
+int upsertAVL(meta_t* meta, const void* toAdd, int (*doMerge)(void*, const void*)){
+    dyndata_t *root = NULL, *node = NULL;
+    int ret = 0;
+
+    if(!meta || !toAdd)
+        return -1;
+
+    if(!meta->structure)
+        meta->nbelements = 0;
+
+    root = meta->structure;
+    ret = insert_AVL_node(meta, &root, toAdd, allocate_dyn, &node);
+    meta->structure = root;
+    if(ret != 1)
+        return ret;
+
+    //key already in the AVL, merge the element with the existing one
+    if(!doMerge){
+        memcpy(node->data, toAdd, meta->elementsize);
+        return 1;
     }
 
-    //sort whether the new element goes as right or left child
-    //  + build a new AVL with the child as root
-    if((*meta->doCompare)(avl->data, toAdd) != 0){
-        if((*meta->doCompare)(avl->data, toAdd) < 0)
-            //to the right
-            avl->right = insertAVL(meta, avl->right, toAdd);
-        else
-            //to the left
-            avl->left = insertAVL(meta, avl->left, toAdd);
+    if((*doMerge)(node->data, toAdd) < 0){
+        if(meta->doPError)
+            (*meta->doPError)("upsertAVL: elements could not be merged");
+
+        return -1;
     }
-    else{
-        //ignore duplicates (forbidden in AVL trees)
-        return avl;
+
+    return 1;
+}
+
+/**
+ * @brief Insert an occurrence of an element in a multiset AVL
+ * @note Each node keeps the number of occurrences of its key after its data,
+ *       so the duplicates do not take any node. The AVL is descended only once.
+ * @warning The AVL must only be filled with insertMultisetAVL() (other AVLs are rejected)
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param toAdd Element to insert
+ * @retval 1    The key already existed and its number of occurrences was incremented
+ * @retval 0    The element was inserted
+ * @retval -1   Error
+ */
+int insertMultisetAVL(meta_t* meta, const void* toAdd){
+    dyndata_t *root = NULL, *node = NULL;
+    uint32_t* occurrences = NULL;
+    int ret = 0;
+
+    if(!meta || !toAdd)
+        return -1;
+
+    if(!meta->structure)
+        meta->nbelements = 0;
+
+    root = meta->structure;
+    if(root && !(root->flags & AVL_MULTISET)){
+        if(meta->doPError)
+            (*meta->doPError)("insertMultisetAVL: the AVL is not a multiset");
+
+        return -1;
     }
 
-    //get the height of the left and right children AVL
-    height_right = (avl->right ? avl->right->height : 0);
-    height_left = (avl->left ? avl->left->height : 0);
+    ret = insert_AVL_node(meta, &root, toAdd, allocate_AVL_multinode, &node);
+    meta->structure = root;
+    if(ret != 1)
+        return ret;
 
-    //update the current node's height
-    avl->height = 1+(height_left > height_right ? height_left : height_right);
+    //key already in the AVL, count one more occurrence
+    occurrences = AVL_OCCURRENCES(meta, node->data);
+    if(*occurrences == UINT32_MAX){
+        if(meta->doPError)
+            (*meta->doPError)("insertMultisetAVL: too many occurrences of the element");
 
-    //compute the balance (height difference between left and right)
-    if(avl)
-        balance = get_AVL_balance(avl);
+        return -1;
+    }
+    (*occurrences)++;
 
-    //re-balance the tree if necessary
-    if(balance < -1){
-        // right right case
-        if((*meta->doCompare)(avl->right->data, toAdd) < 0){
-            return rotate_AVL(avl, LEFT);
-        }
-        // right left case
-        if((*meta->doCompare)(avl->right->data, toAdd) > 0){
-            avl->right = rotate_AVL(avl->right, RIGHT);
-            return rotate_AVL(avl, LEFT);
+    return 1;
+}
+
+/**
+ * @brief Remove an occurrence of a key from a multiset AVL
+ * @note The node is only removed with the last occurrence of its key, and the AVL is descended only once
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param key   Key of which remove an occurrence
+ * @retval 1    An occurrence was removed
+ * @retval 0    Key not found
+ * @retval -1   Error (the AVL is not a multiset)
+ */
+int removeMultisetAVL(meta_t* meta, const void* key){
+    dyndata_t* root = NULL;
+    int ret = 0;
+
+    if(!meta || !key)
+        return -1;
+
+    root = meta->structure;
+    ret = delete_AVL_node(meta, &root, key, 1);
+    meta->structure = root;
+
+    return ret;
+}
+
+/**
+ * @brief Get the number of occurrences of a key in a multiset AVL
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param key   Key to look for
+ * @return      Number of occurrences of the key (0 if not found or if the AVL is not a multiset)
+ */
+uint32_t get_AVL_multiplicity(meta_t* meta, const void* key){
+    dyndata_t* node = NULL;
+
+    if(!meta || !key)
+        return 0;
+
+    node = find_AVL_multinode(meta, key, "get_AVL_multiplicity");
+    return (node ? *AVL_OCCURRENCES(meta, node->data) : 0);
+}
+
+/**
+ * @brief Allocate a multiset AVL node, followed by the number of occurrences of its key
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param elem  Data to copy in the new node
+ * @return      New node
+ * @retval NULL Error
+ */
+static dyndata_t* allocate_AVL_multinode(meta_t* meta, const void* elem){
+    dyndata_t* tmp = NULL;
+
+    tmp = calloc(1, sizeof(dyndata_t));
+    if(!tmp){
+        if(meta->doPError)
+            (*meta->doPError)("allocate_AVL_multinode: element could not be allocated");
+
+        return NULL;
+    }
+
+    //the counter lives right after the data, so free_dyn() releases both at once
+    tmp->data = calloc(1, (size_t)AVL_OCCURRENCES_OFFSET(meta) + sizeof(uint32_t));
+    if(!tmp->data){
+        if(meta->doPError)
+            (*meta->doPError)("allocate_AVL_multinode: element data could not be allocated");
+
+        free(tmp);
+        return NULL;
+    }
+
+    memcpy(tmp->data, elem, meta->elementsize);
+    *AVL_OCCURRENCES(meta, tmp->data) = 1;
+    tmp->flags = AVL_MULTISET;
+    tmp->height = 1;
+    tmp->count = 1;
+
+    return tmp;
+}
+
+/**
+ * @brief Find the node matching a key in a multiset AVL
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param key   Key to look for
+ * @param func  Name of the calling function (for the error message)
+ * @return      Node matching the key
+ * @retval NULL Key not found, or the node is not a multiset node
+ */
+static dyndata_t* find_AVL_multinode(meta_t* meta, const void* key, const char* func){
+    dyndata_t* node = meta->structure;
+    int cmp = 0;
+
+    while(node && (cmp = (*meta->doCompare)(node->data, key)) != 0)
+        node = (cmp < 0 ? node->right : node->left);
+
+    if(node && !(node->flags & AVL_MULTISET)){
+        if(meta->doPError)
+            (*meta->doPError)("%s: the AVL is not a multiset", func);
+
+        return NULL;
+    }
+
+    return node;
+}
+
+/**
+ * @brief Insert an element in an AVL, or find the element with the same key
+ * @note The path is kept in a stack instead of recursing, and each level is compared once
+ * 
+ * @param meta          Metadata necessary to the algorithm
+ * @param avl           Address of the root of the AVL (updated if re-balanced)
+ * @param toAdd         Element to insert in the AVL
+ * @param doAllocate    Function allocating the new node
+ * @param node          Node inserted, or existing node with the same key
+ * @retval 1    The key already existed
+ * @retval 0    The element was inserted
+ * @retval -1   Error
+ */
+static int insert_AVL_node(meta_t* meta, dyndata_t** avl, const void* toAdd, dyndata_t* (*doAllocate)(meta_t*, const void*), dyndata_t** node){
+    dyndata_t **path[AVL_MAX_HEIGHT] = {0}, **link = avl, *cur = NULL;
+    int balance=0, cmp=0, height=0;
+    uint8_t depth = 0;
+
+    //go down to the leaf where the element belongs, saving the links browsed
+    while(*link){
+        cmp = (*meta->doCompare)((*link)->data, toAdd);
+
+        //key already in the AVL
+        if(!cmp){
+            *node = *link;
+            return 1;
         }
+
+        path[depth++] = link;
+        link = (cmp < 0 ? &(*link)->right : &(*link)->left);
     }
-    if(balance > 1){
-        // left left case
-        if((*meta->doCompare)(avl->left->data, toAdd) > 0){
-            return rotate_AVL(avl, RIGHT);
+
+    //memory allocation for the new element
+    *link = (*doAllocate)(meta, toAdd);
+    if(!*link)
+        return -1;
+
+    *node = *link;
+    meta->nbelements++;
+
+    //go back up, updating the heights and re-balancing the tree if necessary
+    while(depth){
+        link = path[--depth];
+        cur = *link;
+        height = cur->height;
+        update_AVL_node(cur);
+
+        //compute the balance (height difference between left and right)
+        balance = get_AVL_balance(cur);
+        if(balance > 1){
+            //left right case
+            if(get_AVL_balance(cur->left) < 0)
+                cur->left = rotate_AVL(cur->left, LEFT);
+
+            //left left case (the subtree recovers its height, nothing left to update above)
+            *link = rotate_AVL(cur, RIGHT);
+            break;
         }
-        //left right case
-        if((*meta->doCompare)(avl->left->data, toAdd) < 0){
-            avl->left = rotate_AVL(avl->left, LEFT);
-            return rotate_AVL(avl, RIGHT);
+        if(balance < -1){
+            //right left case
+            if(get_AVL_balance(cur->right) > 0)
+                cur->right = rotate_AVL(cur->right, RIGHT);
+
+            //right right case (the subtree recovers its height, nothing left to update above)
+            *link = rotate_AVL(cur, LEFT);
+            break;
         }
+
+        //height unchanged, the rest of the path is unaffected
+        if(cur->height == height)
+            break;
     }
 
-    return avl;
+    //the ancestors above only gained one element in their subtree
+    while(depth)
+        (*path[--depth])->count++;
+
+    return 0;
+}
+
+/**
+ * @brief Build a perfectly balanced AVL from a vine, in linear time
+ * @note A vine is a chain of nodes sorted in ascending order and linked by their right pointer
+ * 
+ * @param vine  Address of the first node of the vine (moved past the nodes used)
+ * @param nb    Number of nodes of the vine to use
+ * @return Root of the AVL
+ */
+dyndata_t* buildAVL(dyndata_t** vine, uint32_t nb){
+    dyndata_t *left=NULL, *root=NULL;
+
+    if(!nb)
+        return NULL;
+
+    //build the left subtree with the lowest half of the nodes
+    left = buildAVL(vine, nb / 2);
+
+    //the next node in the vine becomes the root
+    root = *vine;
+    *vine = root->right;
+    root->left = left;
+
+    //build the right subtree with the remaining nodes
+    root->right = buildAVL(vine, nb - (nb / 2) - 1);
+    update_AVL_node(root);
+
+    return root;
 }
 
 /**
@@ -145,7 +455,6 @@ void display_AVL_tree(meta_t* meta, dyndata_t* avl, char dir, char* (*toString)(
  */
 dyndata_t* rotate_AVL(dyndata_t* avl, e_rotation side){
     dyndata_t *newTree=NULL, *child=NULL;
-    int height_l=0, height_r=0;
 
     if(side == RIGHT)
     {
@@ -168,15 +477,9 @@ dyndata_t* rotate_AVL(dyndata_t* avl, e_rotation side){
         avl->right = child;
     }
 
-    //set new height of the previous root
-    height_l = (avl->left ? avl->left->height : 0);
-    height_r = (avl->right ? avl->right->height : 0);
-    avl->height = (height_l > height_r ? height_l : height_r) + 1;
-
-    //set new height of the new root
-    height_l = (newTree->left ? newTree->left->height : 0);
-    height_r = (newTree->right ? newTree->right->height : 0);
-    newTree->height = (height_l > height_r ? height_l : height_r) + 1;
+    //set new height of the previous root, then of the new root
+    update_AVL_node(avl);
+    update_AVL_node(newTree);
 
     return newTree;
 }
@@ -199,6 +502,31 @@ int get_AVL_balance(dyndata_t* avl){
     return height_left - height_right;
 }
 
+/**
+ * @brief Update the height and the subtree size of an AVL node from the ones of its children
+ * 
+ * @param avl   Node to update
+ */
+void update_AVL_node(dyndata_t* avl){
+    int height_left=0, height_right=0;
+
+    height_right = (avl->right ? avl->right->height : 0);
+    height_left = (avl->left ? avl->left->height : 0);
+
+    avl->height = 1+(height_left > height_right ? height_left : height_right);
+    avl->count = 1 + get_AVL_count(avl->left) + get_AVL_count(avl->right);
+}
+
+/**
+ * @brief Get the number of elements in an AVL subtree
+ * 
+ * @param avl   Subtree of which get the size
+ * @return      Number of elements
+ */
+uint32_t get_AVL_count(dyndata_t* avl){
+    return (avl ? avl->count : 0);
+}
+
 /**
  * @brief Perform an action on every element of the AVL
  * 
@@ -260,105 +588,131 @@ void* search_AVL(meta_t* meta, dyndata_t* avl, void* key){
 
 /**
  * @brief Remove an element from the AVL provided
+ * @note Nodes are relinked instead of having their data copied,
+ *       so the data of the other elements never moves
  * 
  * @param meta  Metadata necessary to the algorithm
  * @param root  Root of the AVL from which remove an elemnt
  * @param key   Key to remove from the AVL
- * @return Node found
- * @retval NULL Key not found
+ * @return Root of the AVL
  */
 dyndata_t* delete_AVL(meta_t* meta, dyndata_t* root, void* key){
-    int height_right=0, height_left=0, balance=0;
-    dyndata_t *tmp=NULL, *databuf=NULL;
+    delete_AVL_node(meta, &root, key, 0);
+    return root;
+}
+
+/**
+ * @brief Remove the element matching a key from an AVL, or one of its occurrences
+ * @note Nodes are relinked instead of having their data copied,
+ *       so the data of the other elements never moves
+ * 
+ * @param meta          Metadata necessary to the algorithm
+ * @param avl           Address of the root of the AVL (updated if re-balanced)
+ * @param key           Key to remove from the AVL
+ * @param occurrence    1 to only remove one occurrence of the key from a multiset AVL, 0 to remove the node
+ * @retval  1 Removed
+ * @retval  0 Key not found
+ * @retval -1 Error (occurrence requested in a node which is not a multiset node)
+ */
+static int delete_AVL_node(meta_t* meta, dyndata_t** avl, const void* key, uint8_t occurrence){
+    dyndata_t **path[AVL_MAX_HEIGHT] = {0}, **link = avl, **successorLink = NULL;
+    dyndata_t *node = NULL, *successor = NULL;
+    int balance=0, cmp=0, height=0;
+    uint8_t depth = 0, nodeDepth = 0;
 
-    //if no AVL, skip
-    if(!root)
-        return root;
+    //go down to the key, saving the links browsed
+    while(*link && (cmp = (*meta->doCompare)((*link)->data, key)) != 0){
+        path[depth++] = link;
+        link = (cmp < 0 ? &(*link)->right : &(*link)->left);
+    }
 
-    //key in the right subtree
-    if((*meta->doCompare)(root->data, key) < 0)
-        root->right = delete_AVL(meta, root->right, key);
+    //key not found
+    if(!*link)
+        return 0;
 
-    //key in the left subtree
-    else if((*meta->doCompare)(root->data, key) > 0)
-        root->left = delete_AVL(meta, root->left, key);
+    node = *link;
+    if(occurrence){
+        if(!(node->flags & AVL_MULTISET)){
+            if(meta->doPError)
+                (*meta->doPError)("removeMultisetAVL: the AVL is not a multiset");
 
-    //key is found
-    else{
-        //node with less than 2 children nodes
-        if(root->left==NULL || root->right==NULL)
-        {
-            //get at least one existing child
-            tmp = (root->left ? root->left : root->right);
-
-            if(!tmp){
-                //no children nodes
-                //directly delete the avl
-                tmp = root;
-                root = NULL;
-            }
-            else
-            {
-                //one child node
-                //copy the child node in the father node (with addresses of the grand-children)
-                //save the data address of the avl, then copy everything from the child to the avl
-                databuf = root->data;
-                memcpy(root, tmp, sizeof(dyndata_t));
-                //recover the data pointer of the father, then copy the data (child -> avl)
-                root->data = databuf;
-                memcpy(root->data, tmp->data, meta->elementsize);
-            }
-
-            //free the memory of the child and update the elements counter
-            free_dyn(&tmp);
-            meta->nbelements--;
+            return -1;
         }
-        else{
-            //2 children nodes
-            //copy the data from the child directly at the right of the avl,
-            //      then delete said child
-            tmp = min_AVL_value(root->right);
-            memcpy(root->data, tmp->data, meta->elementsize);
-            root->right = delete_AVL(meta, root->right, tmp->data);
+
+        //more occurrences remaining, simply decrement the counter
+        if(*AVL_OCCURRENCES(meta, node->data) > 1){
+            (*AVL_OCCURRENCES(meta, node->data))--;
+            return 1;
         }
     }
 
-    if(!root)
-        return root;
-
-    //get the height of the left and right children AVL
-    height_right = (root->right ? root->right->height : 0);
-    height_left = (root->left ? root->left->height : 0);
+    if(node->left==NULL || node->right==NULL){
+        //less than 2 children nodes, replace the node by its child (if any)
+        *link = (node->left ? node->left : node->right);
+    }
+    else{
+        //2 children nodes, find the successor (most left node of the right subtree)
+        nodeDepth = depth;
+        path[depth++] = link;
+        successorLink = &node->right;
+        while((*successorLink)->left){
+            path[depth++] = successorLink;
+            successorLink = &(*successorLink)->left;
+        }
 
-    //update the current node's height
-    root->height = 1+(height_left > height_right ? height_left : height_right);
+        //unchain the successor, then put it at the place of the node
+        successor = *successorLink;
+        *successorLink = successor->right;
+        successor->left = node->left;
+        successor->right = node->right;
+        successor->height = node->height;
+        successor->count = node->count;
+        *link = successor;
 
-    //if still a root, re-balance accordingly
-    balance = get_AVL_balance(root);
-    if(balance < -1){
-        // right right case
-        if(get_AVL_balance(root->right) <= 0){
-            return rotate_AVL(root, LEFT);
-        }
-        // right left case
-        if(get_AVL_balance(root->right) > 0){
-            root->right = rotate_AVL(root->right, RIGHT);
-            return rotate_AVL(root, LEFT);
-        }
+        //the link below the node in the path now belongs to the successor
+        if(depth > nodeDepth + 1)
+            path[nodeDepth + 1] = &successor->right;
     }
-    if(balance > 1){
-        // left left case
-        if(get_AVL_balance(root->left) >= 0){
-            return rotate_AVL(root, RIGHT);
+
+    //free the memory of the node and update the elements counter
+    free_dyn(&node);
+    meta->nbelements--;
+
+    //go back up, updating the heights and re-balancing the tree if necessary
+    while(depth){
+        link = path[--depth];
+        node = *link;
+        height = node->height;
+        update_AVL_node(node);
+
+        balance = get_AVL_balance(node);
+        if(balance > 1){
+            //left right case
+            if(get_AVL_balance(node->left) < 0)
+                node->left = rotate_AVL(node->left, LEFT);
+
+            //left left case
+            *link = rotate_AVL(node, RIGHT);
         }
-        //left right case
-        if(get_AVL_balance(root->right) < 0){
-            root->left = rotate_AVL(root->left, LEFT);
-            return rotate_AVL(root, RIGHT);
+        else if(balance < -1){
+            //right left case
+            if(get_AVL_balance(node->right) > 0)
+                node->right = rotate_AVL(node->right, RIGHT);
+
+            //right right case
+            *link = rotate_AVL(node, LEFT);
         }
+
+        //height unchanged, the rest of the path is unaffected
+        if((*link)->height == height)
+            break;
     }
 
-    return root;
+    //the ancestors above only lost one element in their subtree
+    while(depth)
+        (*path[--depth])->count--;
+
+    return 1;
 }
 
 /**
@@ -378,18 +732,1213 @@ int delete_AVL_root(meta_t* meta){
 }
 
 /**
- * @brief Find the subtree with the smallest value
- * @note This is the node most to the left
+ * @brief Remove the element matching a key from the AVL
  * 
- * @param avl AVL for which find the smallest value
- * @return Most left node in the subtree
+ * @param meta  Metadata necessary to the algorithm
+ * @param key   Key of the element to remove
+ * @retval  1 Removed
+ * @retval  0 Key not found
+ * @retval -1 Error
  */
-dyndata_t* min_AVL_value(dyndata_t* avl){
-    dyndata_t* current = avl;
+int delete_AVL_key(meta_t* meta, const void* key){
+    uint32_t nbelements = 0;
 
-    while(current->left){
-        current = current->left;
+    if(!meta || !key)
+        return -1;
+
+    if(!meta->structure)
+        return 0;
+
+    nbelements = meta->nbelements;
+    meta->structure = delete_AVL(meta, meta->structure, (void*)key);
+
+    return (meta->nbelements != nbelements);
+}
+
+/**
+ * @brief Remove a set of keys from the AVL in a single traversal
+ * @note Only the paths leading to the keys are browsed, and the subtrees are re-balanced
+ *       by joining them on the way back up (O(nb * log(n / nb + 1)) instead of O(nb * log(n)))
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param keys  Array of nb keys to remove, sorted in ascending order
+ * @param nb    Number of keys
+ * @return      Number of elements removed
+ */
+uint32_t delete_AVL_keys(meta_t* meta, const void* keys, uint32_t nb){
+    uint32_t removed = 0;
+
+    if(!meta || !keys || !nb)
+        return 0;
+
+    meta->structure = delete_AVL_sorted(meta, meta->structure, keys, nb, &removed);
+    meta->nbelements -= removed;
+
+    return removed;
+}
+
+/**
+ * @brief Remove the elements between two keys (included) from the AVL in a single traversal
+ * @note Only the paths leading to the bounds and the elements removed are browsed,
+ *       and the subtrees are re-balanced by joining them on the way back up
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param low   Lowest key of the range
+ * @param high  Highest key of the range
+ * @return      Number of elements removed
+ */
+uint32_t delete_AVL_range(meta_t* meta, const void* low, const void* high){
+    uint32_t removed = 0;
+
+    if(!meta || !low || !high)
+        return 0;
+
+    meta->structure = delete_AVL_between(meta, meta->structure, low, high, &removed);
+    meta->nbelements -= removed;
+
+    return removed;
+}
+
+/**
+ * @brief Recursively remove a set of sorted keys from a subtree
+ * 
+ * @param meta      Metadata necessary to the algorithm
+ * @param avl       Root of the subtree
+ * @param keys      Array of nb keys to remove, sorted in ascending order
+ * @param nb        Number of keys
+ * @param removed   Counter of the elements removed
+ * @return          New root of the subtree
+ */
+dyndata_t* delete_AVL_sorted(meta_t* meta, dyndata_t* avl, const void* keys, uint32_t nb, uint32_t* removed){
+    dyndata_t *left = NULL, *right = NULL;
+    uint32_t low = 0, high = nb, middle = 0;
+    int cmp = 0, found = 0;
+
+    if(!avl || !nb)
+        return avl;
+
+    //split the keys around the root (binary search)
+    while(low < high && !found){
+        middle = (low + high) / 2;
+        cmp = (*meta->doCompare)((const uint8_t*)keys + ((size_t)middle * meta->elementsize), avl->data);
+        if(!cmp){
+            found = 1;
+            low = middle;
+        }
+        else if(cmp < 0)
+            low = middle + 1;
+        else
+            high = middle;
     }
 
-    return current;
+    //remove the lower keys from the left subtree, and the higher ones from the right subtree
+    left = delete_AVL_sorted(meta, avl->left, keys, low, removed);
+    right = delete_AVL_sorted(meta, avl->right, (const uint8_t*)keys + ((size_t)(low + found) * meta->elementsize), nb - low - found, removed);
+
+    if(found){
+        free_dyn(&avl);
+        (*removed)++;
+        return join2_AVL(left, right);
+    }
+
+    return join_AVL(left, avl, right);
+}
+
+/**
+ * @brief Recursively remove the elements between two keys (included) from a subtree
+ * 
+ * @param meta      Metadata necessary to the algorithm
+ * @param avl       Root of the subtree
+ * @param low       Lowest key of the range
+ * @param high      Highest key of the range
+ * @param removed   Counter of the elements removed
+ * @return          New root of the subtree
+ */
+dyndata_t* delete_AVL_between(meta_t* meta, dyndata_t* avl, const void* low, const void* high, uint32_t* removed){
+    dyndata_t *left = NULL, *right = NULL;
+
+    if(!avl)
+        return NULL;
+
+    //root lower than the range, only the right subtree is concerned
+    if((*meta->doCompare)(avl->data, low) < 0){
+        right = delete_AVL_between(meta, avl->right, low, high, removed);
+        return join_AVL(avl->left, avl, right);
+    }
+
+    //root higher than the range, only the left subtree is concerned
+    if((*meta->doCompare)(avl->data, high) > 0){
+        left = delete_AVL_between(meta, avl->left, low, high, removed);
+        return join_AVL(left, avl, avl->right);
+    }
+
+    //root in the range, remove it and join what is left of its subtrees
+    left = delete_AVL_between(meta, avl->left, low, high, removed);
+    right = delete_AVL_between(meta, avl->right, low, high, removed);
+    free_dyn(&avl);
+    (*removed)++;
+
+    return join2_AVL(left, right);
+}
+
+/**
+ * @brief Get the height of an AVL subtree
+ * 
+ * @param avl   Subtree of which get the height
+ * @return      Height of the subtree
+ */
+int16_t get_AVL_height(dyndata_t* avl){
+    return (avl ? avl->height : 0);
+}
+
+/**
+ * @brief Join two AVLs and a middle node, whatever the difference of their heights
+ * @note All the elements of the left AVL must be lower than the middle node,
+ *       and all the ones of the right AVL higher. Runs in O(|height difference|).
+ * 
+ * @param left      Left AVL
+ * @param middle    Node to put between both AVLs
+ * @param right     Right AVL
+ * @return          Root of the joined AVL
+ */
+dyndata_t* join_AVL(dyndata_t* left, dyndata_t* middle, dyndata_t* right){
+    if(left && get_AVL_height(left) > get_AVL_height(right) + 1)
+        return join_AVL_right(left, middle, right);
+
+    if(right && get_AVL_height(right) > get_AVL_height(left) + 1)
+        return join_AVL_left(left, middle, right);
+
+    middle->left = left;
+    middle->right = right;
+    update_AVL_node(middle);
+
+    return middle;
+}
+
+/**
+ * @brief Join a middle node and a right AVL to the right spine of a higher left AVL
+ * 
+ * @param left      Left AVL (higher than the right one)
+ * @param middle    Node to put between both AVLs
+ * @param right     Right AVL
+ * @return          Root of the joined AVL
+ */
+dyndata_t* join_AVL_right(dyndata_t* left, dyndata_t* middle, dyndata_t* right){
+    //spine node found, hang the middle node under it
+    if(!left->right || get_AVL_height(left->right) <= get_AVL_height(right) + 1){
+        middle->left = left->right;
+        middle->right = right;
+        update_AVL_node(middle);
+
+        //right left case
+        if(middle->height > get_AVL_height(left->left) + 1){
+            left->right = rotate_AVL(middle, RIGHT);
+            return rotate_AVL(left, LEFT);
+        }
+
+        left->right = middle;
+        update_AVL_node(left);
+        return left;
+    }
+
+    //keep going down the right spine, then re-balance on the way back up
+    left->right = join_AVL_right(left->right, middle, right);
+    update_AVL_node(left);
+    if(get_AVL_balance(left) < -1)
+        return rotate_AVL(left, LEFT);
+
+    return left;
+}
+
+/**
+ * @brief Join a left AVL and a middle node to the left spine of a higher right AVL
+ * 
+ * @param left      Left AVL
+ * @param middle    Node to put between both AVLs
+ * @param right     Right AVL (higher than the left one)
+ * @return          Root of the joined AVL
+ */
+dyndata_t* join_AVL_left(dyndata_t* left, dyndata_t* middle, dyndata_t* right){
+    //spine node found, hang the middle node under it
+    if(!right->left || get_AVL_height(right->left) <= get_AVL_height(left) + 1){
+        middle->left = left;
+        middle->right = right->left;
+        update_AVL_node(middle);
+
+        //left right case
+        if(middle->height > get_AVL_height(right->right) + 1){
+            right->left = rotate_AVL(middle, LEFT);
+            return rotate_AVL(right, RIGHT);
+        }
+
+        right->left = middle;
+        update_AVL_node(right);
+        return right;
+    }
+
+    //keep going down the left spine, then re-balance on the way back up
+    right->left = join_AVL_left(left, middle, right->left);
+    update_AVL_node(right);
+    if(get_AVL_balance(right) > 1)
+        return rotate_AVL(right, RIGHT);
+
+    return right;
+}
+
+/**
+ * @brief Join two AVLs, all the elements of the left one being lower than the ones of the right one
+ * 
+ * @param left  Left AVL
+ * @param right Right AVL
+ * @return      Root of the joined AVL
+ */
+dyndata_t* join2_AVL(dyndata_t* left, dyndata_t* right){
+    dyndata_t* last = NULL;
+
+    if(!left)
+        return right;
+
+    //the highest element of the left AVL becomes the middle node
+    left = split_AVL_last(left, &last);
+
+    return join_AVL(left, last, right);
+}
+
+/**
+ * @brief Unchain the highest element of an AVL
+ * 
+ * @param avl   AVL from which unchain the highest element
+ * @param last  Highest element unchained
+ * @return      Root of the remaining AVL
+ */
+dyndata_t* split_AVL_last(dyndata_t* avl, dyndata_t** last){
+    dyndata_t* rest = NULL;
+
+    if(!avl->right){
+        *last = avl;
+        return avl->left;
+    }
+
+    rest = split_AVL_last(avl->right, last);
+    return join_AVL(avl->left, avl, rest);
+}
+
+/**
+ * @brief Find the subtree with the smallest value
+ * @note This is the node most to the left
+ * 
+ * @param avl AVL for which find the smallest value
+ * @return Most left node in the subtree
+ */
+dyndata_t* min_AVL_value(dyndata_t* avl){
+    dyndata_t* current = avl;
+
+    while(current->left){
+        current = current->left;
+    }
+
+    return current;
+}
+
+/**
+ * @brief Get the element at a position in the AVL, in ascending order
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param k     Position of the element (0 being the smallest)
+ * @return      Data of the element
+ * @retval NULL Position out of bounds
+ */
+void* select_AVL(meta_t* meta, uint32_t k){
+    dyndata_t* current = NULL;
+    uint32_t leftCount = 0;
+
+    if(!meta)
+        return NULL;
+
+    current = meta->structure;
+    while(current){
+        leftCount = get_AVL_count(current->left);
+
+        if(k == leftCount)
+            return current->data;
+
+        //skip the left subtree and the current node if the position is further
+        if(k < leftCount)
+            current = current->left;
+        else{
+            k -= leftCount + 1;
+            current = current->right;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Get the number of elements lower (or lower or equal) than a key
+ * 
+ * @param meta      Metadata necessary to the algorithm
+ * @param key       Key to compare
+ * @param inclusive 1 if elements equal to the key are counted, 0 otherwise
+ * @return          Number of elements
+ */
+uint32_t rank_AVL_key(meta_t* meta, const void* key, int inclusive){
+    dyndata_t* current = meta->structure;
+    uint32_t rank = 0;
+    int cmp = 0;
+
+    while(current){
+        cmp = (*meta->doCompare)(current->data, key);
+
+        //key found, only its left subtree is lower
+        if(!cmp)
+            return rank + get_AVL_count(current->left) + (inclusive ? 1 : 0);
+
+        //the current node and its left subtree are lower than the key
+        if(cmp < 0){
+            rank += get_AVL_count(current->left) + 1;
+            current = current->right;
+        }
+        else
+            current = current->left;
+    }
+
+    return rank;
+}
+
+/**
+ * @brief Get the rank of a key in the AVL (number of elements strictly lower)
+ * @note The key does not need to be in the AVL
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param key   Key of which get the rank
+ * @return      Rank of the key
+ */
+uint32_t rank_AVL(meta_t* meta, const void* key){
+    if(!meta || !key)
+        return 0;
+
+    return rank_AVL_key(meta, key, 0);
+}
+
+/**
+ * @brief Count the elements of the AVL between two keys (included)
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param low   Lowest key of the range
+ * @param high  Highest key of the range
+ * @return      Number of elements in the range
+ */
+uint32_t count_AVL_range(meta_t* meta, const void* low, const void* high){
+    uint32_t lower = 0, upper = 0;
+
+    if(!meta || !low || !high)
+        return 0;
+
+    lower = rank_AVL_key(meta, low, 0);
+    upper = rank_AVL_key(meta, high, 1);
+
+    return (upper > lower ? upper - lower : 0);
+}
+
+/**
+ * @brief Position an iterator on the first element higher (or equal) than a key
+ * 
+ * @param meta      Metadata necessary to the algorithm
+ * @param key       Key to compare
+ * @param strict    1 if elements equal to the key are skipped, 0 otherwise
+ * @param it        Iterator to position
+ * @return          Data of the element found
+ * @retval NULL     No element matches
+ */
+void* bound_AVL(meta_t* meta, const void* key, int strict, avliterator_t* it){
+    dyndata_t* current = meta->structure;
+    uint8_t found = 0;
+    int cmp = 0;
+
+    //go down to the leaf, remembering the depth of the last node matching
+    it->depth = 0;
+    while(current){
+        it->stack[it->depth++] = current;
+        cmp = (*meta->doCompare)(current->data, key);
+
+        if(cmp > 0 || (!cmp && !strict)){
+            found = it->depth;
+            current = current->left;
+        }
+        else
+            current = current->right;
+    }
+
+    //the path to the last node matching is the beginning of the path browsed
+    it->depth = found;
+
+    return get_AVL_iterator(it);
+}
+
+/**
+ * @brief Find the first element of the AVL higher or equal to a key
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param key   Key to compare
+ * @param it    Iterator to position on the element (can be NULL)
+ * @return      Data of the element found
+ * @retval NULL No element higher or equal
+ */
+void* lower_bound_AVL(meta_t* meta, const void* key, avliterator_t* it){
+    avliterator_t tmp;
+
+    if(!meta || !key)
+        return NULL;
+
+    return bound_AVL(meta, key, 0, (it ? it : &tmp));
+}
+
+/**
+ * @brief Find the first element of the AVL strictly higher than a key
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param key   Key to compare
+ * @param it    Iterator to position on the element (can be NULL)
+ * @return      Data of the element found
+ * @retval NULL No element higher
+ */
+void* upper_bound_AVL(meta_t* meta, const void* key, avliterator_t* it){
+    avliterator_t tmp;
+
+    if(!meta || !key)
+        return NULL;
+
+    return bound_AVL(meta, key, 1, (it ? it : &tmp));
+}
+
+/**
+ * @brief Push a node and all its descendants on one side in an iterator
+ * 
+ * @param it    Iterator in which push the nodes
+ * @param node  First node to push
+ * @param side  Side to follow (LEFT to reach the lowest element, RIGHT to reach the highest)
+ */
+void push_AVL_iterator(avliterator_t* it, dyndata_t* node, e_rotation side){
+    while(node){
+        it->stack[it->depth++] = node;
+        node = (side == LEFT ? node->left : node->right);
+    }
+}
+
+/**
+ * @brief Position an iterator on the lowest element of the AVL
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param it    Iterator to position
+ * @return      Data of the lowest element
+ * @retval NULL Empty AVL
+ */
+void* first_AVL_iterator(meta_t* meta, avliterator_t* it){
+    if(!meta || !it)
+        return NULL;
+
+    it->depth = 0;
+    push_AVL_iterator(it, meta->structure, LEFT);
+
+    return get_AVL_iterator(it);
+}
+
+/**
+ * @brief Position an iterator on the highest element of the AVL
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param it    Iterator to position
+ * @return      Data of the highest element
+ * @retval NULL Empty AVL
+ */
+void* last_AVL_iterator(meta_t* meta, avliterator_t* it){
+    if(!meta || !it)
+        return NULL;
+
+    it->depth = 0;
+    push_AVL_iterator(it, meta->structure, RIGHT);
+
+    return get_AVL_iterator(it);
+}
+
+/**
+ * @brief Get the element on which an iterator is positioned
+ * 
+ * @param it    Iterator
+ * @return      Data of the current element
+ * @retval NULL Iterator out of the AVL
+ */
+void* get_AVL_iterator(avliterator_t* it){
+    if(!it || !it->depth)
+        return NULL;
+
+    return it->stack[it->depth - 1]->data;
+}
+
+/**
+ * @brief Move an iterator to the next element, in ascending order
+ * @note Once out of the AVL, the iterator must be positioned again
+ * @warning The AVL must not be modified while iterating
+ * 
+ * @param it    Iterator to move
+ * @return      Data of the next element
+ * @retval NULL No element left
+ */
+void* next_AVL_iterator(avliterator_t* it){
+    dyndata_t* child = NULL;
+
+    if(!it || !it->depth)
+        return NULL;
+
+    child = it->stack[it->depth - 1];
+    if(child->right){
+        //next element is the lowest of the right subtree
+        push_AVL_iterator(it, child->right, LEFT);
+    }
+    else{
+        //go up until coming from a left subtree
+        do{
+            child = it->stack[--it->depth];
+        }while(it->depth && it->stack[it->depth - 1]->right == child);
+    }
+
+    return get_AVL_iterator(it);
+}
+
+/**
+ * @brief Move an iterator to the previous element, in ascending order
+ * @note Once out of the AVL, the iterator must be positioned again
+ * @warning The AVL must not be modified while iterating
+ * 
+ * @param it    Iterator to move
+ * @return      Data of the previous element
+ * @retval NULL No element left
+ */
+void* prev_AVL_iterator(avliterator_t* it){
+    dyndata_t* child = NULL;
+
+    if(!it || !it->depth)
+        return NULL;
+
+    child = it->stack[it->depth - 1];
+    if(child->left){
+        //previous element is the highest of the left subtree
+        push_AVL_iterator(it, child->left, RIGHT);
+    }
+    else{
+        //go up until coming from a right subtree
+        do{
+            child = it->stack[--it->depth];
+        }while(it->depth && it->stack[it->depth - 1]->left == child);
+    }
+
+    return get_AVL_iterator(it);
+}
+
+/**
+ * @brief Perform an action on the elements of the AVL between two keys (included), in ascending order
+ * @note Only the elements in the range are visited, and the browsing stops as soon as
+ *       the action returns something else than 0
+ * 
+ * @param meta      Metadata necessary to the algorithm
+ * @param low       Lowest key of the range
+ * @param high      Highest key of the range
+ * @param parameter Parameter for the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 OK
+ * @retval  1 Browsing stopped by the action
+ * @retval -1 Error
+ */
+int foreachAVLRange(meta_t* meta, const void* low, const void* high, void* parameter, int (*doAction)(void*, void*)){
+    avliterator_t it;
+    void* current = NULL;
+    int ret = 0;
+
+    if(!meta || !low || !high)
+        return -1;
+
+    if(!doAction)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachAVLRange: action to perform not defined");
+
+        return -1;
+    }
+
+    current = bound_AVL(meta, low, 0, &it);
+    while(current && (*meta->doCompare)(current, high) <= 0){
+        ret = (*doAction)(current, parameter);
+        if(ret < 0)
+        {
+            if(meta->doPError)
+                (*meta->doPError)("foreachAVLRange: action specified returned with an error");
+
+            return -1;
+        }
+        if(ret)
+            return 1;
+
+        current = next_AVL_iterator(&it);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Split an AVL around a key, in O(log n)
+ * @note The nodes are moved, the AVL provided must not be used anymore
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param avl   AVL to split
+ * @param key   Key around which split the AVL
+ * @param left  AVL with all the elements lower than the key
+ * @param right AVL with all the elements higher than the key
+ * @return      Node matching the key (detached, without children)
+ * @retval NULL Key not in the AVL
+ */
+dyndata_t* split_AVL(meta_t* meta, dyndata_t* avl, const void* key, dyndata_t** left, dyndata_t** right){
+    dyndata_t *middle = NULL, *subtree = NULL;
+    int cmp = 0;
+
+    if(!avl){
+        *left = NULL;
+        *right = NULL;
+        return NULL;
+    }
+
+    cmp = (*meta->doCompare)(avl->data, key);
+    //hand out the subtrees, and detach the node matching the key from them
+    if(!cmp){
+        *left = avl->left;
+        *right = avl->right;
+        avl->left = NULL;
+        avl->right = NULL;
+        avl->height = 1;
+        avl->count = 1;
+        return avl;
+    }
+
+    //root higher than the key, split the left subtree and join its higher part to the root
+    if(cmp > 0){
+        middle = split_AVL(meta, avl->left, key, left, &subtree);
+        *right = join_AVL(subtree, avl, avl->right);
+        return middle;
+    }
+
+    //root lower than the key, split the right subtree and join its lower part to the root
+    middle = split_AVL(meta, avl->right, key, &subtree, right);
+    *left = join_AVL(avl->left, avl, subtree);
+    return middle;
+}
+
+/**
+ * @brief Recursively free the nodes of an AVL and their data
+ * 
+ * @param avl   Root of the subtree to free
+ */
+void free_AVL_node(dyndata_t* avl){
+    if(!avl)
+        return;
+
+    free_AVL_node(avl->left);
+    free_AVL_node(avl->right);
+    free_dyn(&avl);
+}
+
+/**
+ * @brief Check two AVLs can be combined by a set operation
+ * 
+ * @param dst   Metadata of the AVL receiving the result
+ * @param src   Metadata of the other AVL
+ * @param func  Name of the calling function (for the error message)
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int check_AVL_setoperands(meta_t* dst, meta_t* src, const char* func){
+    if(!dst || !src || dst == src)
+        return -1;
+
+    if(dst->elementsize != src->elementsize || dst->doCompare != src->doCompare)
+    {
+        if(dst->doPError)
+            (*dst->doPError)("%s: both AVLs must hold the same elements", func);
+
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Recursively compute the union of two AVLs (elements of the first one kept on duplicates)
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param a     First AVL
+ * @param b     Second AVL
+ * @return      Root of the union
+ */
+dyndata_t* union_AVL_node(meta_t* meta, dyndata_t* a, dyndata_t* b){
+    dyndata_t *left = NULL, *right = NULL, *duplicate = NULL, *bleft = NULL, *bright = NULL;
+
+    if(!a)
+        return b;
+    if(!b)
+        return a;
+
+    //split the first AVL around the root of the second one, then merge each side
+    bleft = b->left;
+    bright = b->right;
+    duplicate = split_AVL(meta, a, b->data, &left, &right);
+    left = union_AVL_node(meta, left, bleft);
+    right = union_AVL_node(meta, right, bright);
+
+    //keep the element of the first AVL on duplicates
+    if(duplicate){
+        free_dyn(&b);
+        return join_AVL(left, duplicate, right);
+    }
+
+    return join_AVL(left, b, right);
+}
+
+/**
+ * @brief Recursively compute the intersection of two AVLs (elements of the first one kept)
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param a     First AVL
+ * @param b     Second AVL
+ * @return      Root of the intersection
+ */
+dyndata_t* intersect_AVL_node(meta_t* meta, dyndata_t* a, dyndata_t* b){
+    dyndata_t *left = NULL, *right = NULL, *common = NULL, *bleft = NULL, *bright = NULL;
+
+    if(!a || !b){
+        free_AVL_node(a);
+        free_AVL_node(b);
+        return NULL;
+    }
+
+    //split the first AVL around the root of the second one, then intersect each side
+    bleft = b->left;
+    bright = b->right;
+    common = split_AVL(meta, a, b->data, &left, &right);
+    free_dyn(&b);
+    left = intersect_AVL_node(meta, left, bleft);
+    right = intersect_AVL_node(meta, right, bright);
+
+    if(common)
+        return join_AVL(left, common, right);
+
+    return join2_AVL(left, right);
+}
+
+/**
+ * @brief Recursively compute the difference of two AVLs (elements of the first one not in the second one)
+ * 
+ * @param meta  Metadata necessary to the algorithm
+ * @param a     First AVL
+ * @param b     Second AVL
+ * @return      Root of the difference
+ */
+dyndata_t* difference_AVL_node(meta_t* meta, dyndata_t* a, dyndata_t* b){
+    dyndata_t *left = NULL, *right = NULL, *common = NULL, *bleft = NULL, *bright = NULL;
+
+    if(!a || !b){
+        free_AVL_node(b);
+        return a;
+    }
+
+    //split the first AVL around the root of the second one, then subtract each side
+    bleft = b->left;
+    bright = b->right;
+    common = split_AVL(meta, a, b->data, &left, &right);
+    free_dyn(&b);
+    if(common)
+        free_dyn(&common);
+
+    left = difference_AVL_node(meta, left, bleft);
+    right = difference_AVL_node(meta, right, bright);
+
+    return join2_AVL(left, right);
+}
+
+/**
+ * @brief Merge all the elements of an AVL into another one, in O(m log(n / m + 1))
+ * @note The nodes of the source AVL are moved (duplicates are freed), leaving it empty
+ * 
+ * @param dst   Metadata of the AVL receiving the union
+ * @param src   Metadata of the AVL to merge
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int unionAVL(meta_t* dst, meta_t* src){
+    dyndata_t* root = NULL;
+
+    if(check_AVL_setoperands(dst, src, "unionAVL") < 0)
+        return -1;
+
+    root = union_AVL_node(dst, dst->structure, src->structure);
+    dst->structure = root;
+    dst->nbelements = (root ? root->count : 0);
+    src->structure = NULL;
+    src->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Keep in an AVL only the elements also in another one, in O(m log(n / m + 1))
+ * @note The source AVL is freed in the process, leaving it empty
+ * 
+ * @param dst   Metadata of the AVL receiving the intersection
+ * @param src   Metadata of the AVL to intersect with
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int intersectAVL(meta_t* dst, meta_t* src){
+    dyndata_t* root = NULL;
+
+    if(check_AVL_setoperands(dst, src, "intersectAVL") < 0)
+        return -1;
+
+    root = intersect_AVL_node(dst, dst->structure, src->structure);
+    dst->structure = root;
+    dst->nbelements = (root ? root->count : 0);
+    src->structure = NULL;
+    src->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Remove from an AVL all the elements in another one, in O(m log(n / m + 1))
+ * @note The source AVL is freed in the process, leaving it empty
+ * 
+ * @param dst   Metadata of the AVL receiving the difference
+ * @param src   Metadata of the AVL to subtract
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int differenceAVL(meta_t* dst, meta_t* src){
+    dyndata_t* root = NULL;
+
+    if(check_AVL_setoperands(dst, src, "differenceAVL") < 0)
+        return -1;
+
+    root = difference_AVL_node(dst, dst->structure, src->structure);
+    dst->structure = root;
+    dst->nbelements = (root ? root->count : 0);
+    src->structure = NULL;
+    src->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Perform an action on every element of the AVL, with the workers of a scheduler
+ * @note The AVL is cut into subtrees handed out to the workers as they get idle,
+ *       so the elements are not visited in order. The calling thread takes part.
+ * @warning The action must be thread-safe, and the AVL must not be modified meanwhile.
+ *          The call waits for the workers it submitted, so it must not be made from a task of the scheduler.
+ * 
+ * @param meta      Metadata necessary to the algorithm
+ * @param scheduler Scheduler whose workers browse the AVL (NULL to browse it in the calling thread only)
+ * @param parameter Parameter for the action to perform
+ * @param doAction  Action to perform (browsing stops on every thread as soon as it returns something else than 0)
+ * @retval  0 OK
+ * @retval  1 Browsing stopped by the action
+ * @retval -1 Error
+ */
+int foreachAVLParallel(meta_t* meta, scheduler_t* scheduler, void* parameter, int (*doAction)(void*, void*)){
+    avlparallel_t job = {0};
+
+    if(!meta)
+        return -1;
+
+    if(!doAction)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachAVLParallel: action to perform not defined");
+
+        return -1;
+    }
+
+    job.meta = meta;
+    job.parameter = parameter;
+    job.doAction = doAction;
+
+    return run_AVL_parallel(&job, scheduler);
+}
+
+/**
+ * @brief Reduce the elements of the AVL to a single result, with the workers of a scheduler
+ * @note Each part of the AVL is accumulated in its own partial result, starting from the
+ *       initial value of result. The partial results are then combined in ascending order,
+ *       so the combination only needs to be associative.
+ * @warning The AVL must not be modified meanwhile. The call waits for the workers
+ *          it submitted, so it must not be made from a task of the scheduler.
+ * 
+ * @param meta          Metadata necessary to the algorithm
+ * @param scheduler     Scheduler whose workers browse the AVL (NULL to browse it in the calling thread only)
+ * @param result        Neutral element of the reduction, replaced by the final result
+ * @param resultsize    Size of a result
+ * @param doAccumulate  Function accumulating an element (first parameter) in a partial result (second parameter)
+ * @param doCombine     Function combining a partial result (second parameter) into the final result (first parameter)
+ * @retval  0 OK
+ * @retval  1 Reduction stopped by the accumulation (result only covers the elements accumulated)
+ * @retval -1 Error
+ */
+int reduceAVLParallel(meta_t* meta, scheduler_t* scheduler, void* result, uint32_t resultsize, int (*doAccumulate)(void*, void*), int (*doCombine)(void*, const void*)){
+    avlparallel_t job = {0};
+    int ret = 0;
+
+    if(!meta || !result || !resultsize)
+        return -1;
+
+    if(!doAccumulate || !doCombine)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("reduceAVLParallel: accumulation or combination not defined");
+
+        return -1;
+    }
+
+    job.meta = meta;
+    job.parameter = result;
+    job.partialsize = resultsize;
+    job.doAction = doAccumulate;
+
+    ret = run_AVL_parallel(&job, scheduler);
+    if(ret < 0)
+        goto end;
+
+    //combine the partial results in ascending order
+    for(uint32_t i = 0 ; i < job.nbtasks && ret >= 0 ; i++)
+    {
+        if((*doCombine)(result, job.partials + ((size_t)i * resultsize)) < 0)
+        {
+            if(meta->doPError)
+                (*meta->doPError)("reduceAVLParallel: partial results could not be combined");
+
+            ret = -1;
+        }
+    }
+
+end:
+    free(job.partials);
+    free(job.tasks);
+    return ret;
+}
+
+/**
+ * @brief List the subtrees of an AVL at a given depth, and the nodes above them, in ascending order
+ * 
+ * @param job   Parallel traversal to which add the tasks
+ * @param avl   AVL to cut
+ * @param depth Depth at which the subtrees are handed out whole
+ */
+static void gather_AVL_tasks(avlparallel_t* job, dyndata_t* avl, uint8_t depth){
+    if(!avl)
+        return;
+
+    if(!depth){
+        job->tasks[job->nbtasks++] = (avltask_t){avl, 1};
+        return;
+    }
+
+    gather_AVL_tasks(job, avl->left, depth - 1);
+    job->tasks[job->nbtasks++] = (avltask_t){avl, 0};
+    gather_AVL_tasks(job, avl->right, depth - 1);
+}
+
+/**
+ * @brief Perform the action of a parallel traversal on every element of a subtree, in ascending order
+ * 
+ * @param job       Parallel traversal in progress
+ * @param avl       Subtree to browse
+ * @param parameter Parameter for the action (partial result of the task when reducing)
+ */
+static void browse_AVL_task(avlparallel_t* job, dyndata_t* avl, void* parameter){
+    if(!avl || atomic_load_explicit(&job->status, memory_order_relaxed))
+        return;
+
+    browse_AVL_task(job, avl->left, parameter);
+    apply_AVL_action(job, avl->data, parameter);
+    browse_AVL_task(job, avl->right, parameter);
+}
+
+/**
+ * @brief Perform the action of a parallel traversal on an element
+ * @note Every thread stops as soon as the action fails or asks to
+ * 
+ * @param job       Parallel traversal in progress
+ * @param data      Element on which perform the action
+ * @param parameter Parameter for the action (partial result of the task when reducing)
+ */
+static void apply_AVL_action(avlparallel_t* job, void* data, void* parameter){
+    int ret = 0, expected = 0;
+
+    if(atomic_load_explicit(&job->status, memory_order_relaxed))
+        return;
+
+    ret = (*job->doAction)(data, parameter);
+    if(ret < 0)
+        atomic_store(&job->status, -1);
+    else if(ret)
+        atomic_compare_exchange_strong(&job->status, &expected, 1);
+}
+
+/**
+ * @brief Browse the parts of an AVL until no task remains
+ * @note Run by the calling thread and by the workers of the scheduler
+ * 
+ * @param job   Parallel traversal in progress
+ * @retval 0    OK
+ */
+static int parallel_AVL_worker(void* job){
+    avlparallel_t* parallel = (avlparallel_t*)job;
+    void* parameter = NULL;
+    avltask_t* task = NULL;
+    uint32_t i = 0;
+
+    while((i = atomic_fetch_add_explicit(&parallel->next, 1, memory_order_relaxed)) < parallel->nbtasks){
+        task = &parallel->tasks[i];
+        parameter = (parallel->partials ? parallel->partials + ((size_t)i * parallel->partialsize) : parallel->parameter);
+
+        //nodes above the cut are browsed alone, their subtrees being tasks of their own
+        if(task->whole)
+            browse_AVL_task(parallel, task->node, parameter);
+        else
+            apply_AVL_action(parallel, task->node->data, parameter);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Browse the parts of an AVL from a worker of the scheduler, then tell the calling thread
+ * @note The count is updated under the lock, so the calling thread cannot
+ *       release the traversal before the last worker is done with it
+ * 
+ * @param job   Parallel traversal in progress
+ * @retval 0    OK
+ */
+static int parallel_AVL_task(void* job){
+    avlparallel_t* parallel = (avlparallel_t*)job;
+
+    parallel_AVL_worker(job);
+
+    mtx_lock(&parallel->lock);
+    if(!--parallel->running)
+        cnd_signal(&parallel->done);
+    mtx_unlock(&parallel->lock);
+
+    return 0;
+}
+
+/**
+ * @brief Cut the AVL into tasks, and have them browsed by the workers of a scheduler
+ * @note The tasks are kept in job to let the reductions combine the partial results.
+ *       The workers run the same loop as the calling thread, taking the tasks one at a time,
+ *       and only they are waited for (not the other tasks of the scheduler).
+ * 
+ * @param job       Parallel traversal to run
+ * @param scheduler Scheduler whose workers browse the AVL (can be NULL)
+ * @retval  0 OK
+ * @retval  1 Browsing stopped by the action
+ * @retval -1 Error
+ */
+static int run_AVL_parallel(avlparallel_t* job, scheduler_t* scheduler){
+    uint32_t nbthreads = 1;
+    uint8_t depth = 0;
+
+    if(!job->meta->structure)
+        return 0;
+
+    //the calling thread browses the AVL along with the workers
+    if(scheduler && scheduler->workers)
+        nbthreads += scheduler->nbworkers;
+
+    //cut the AVL deep enough to hand out several subtrees to each thread
+    while((1U << depth) < nbthreads * AVL_TASKS_PER_THREAD)
+        depth++;
+
+    job->tasks = calloc((size_t)2U << depth, sizeof(avltask_t));
+    if(!job->tasks)
+    {
+        if(job->meta->doPError)
+            (*job->meta->doPError)("run_AVL_parallel: tasks could not be allocated");
+
+        return -1;
+    }
+    gather_AVL_tasks(job, job->meta->structure, depth);
+
+    //each task of a reduction starts from the neutral element
+    if(job->partialsize)
+    {
+        job->partials = malloc((size_t)job->nbtasks * job->partialsize);
+        if(!job->partials)
+        {
+            if(job->meta->doPError)
+                (*job->meta->doPError)("run_AVL_parallel: partial results could not be allocated");
+
+            return -1;
+        }
+
+        for(uint32_t i = 0 ; i < job->nbtasks ; i++)
+            memcpy(job->partials + ((size_t)i * job->partialsize), job->parameter, job->partialsize);
+    }
+
+    //the workers can only be used if the calling thread can wait for them
+    if(nbthreads > 1 && mtx_init(&job->lock, mtx_plain) != thrd_success)
+        nbthreads = 1;
+    if(nbthreads > 1 && cnd_init(&job->done) != thrd_success)
+    {
+        mtx_destroy(&job->lock);
+        nbthreads = 1;
+    }
+
+    //hand the loop to the workers (if some cannot be, the remaining ones take up their share)
+    atomic_init(&job->next, 0);
+    atomic_init(&job->status, 0);
+    job->running = 0;
+    for(uint32_t i = 1 ; i < nbthreads ; i++)
+    {
+        mtx_lock(&job->lock);
+        job->running++;
+        mtx_unlock(&job->lock);
+
+        if(submit_scheduler(scheduler, parallel_AVL_task, job) < 0)
+        {
+            mtx_lock(&job->lock);
+            job->running--;
+            mtx_unlock(&job->lock);
+            break;
+        }
+    }
+
+    //browse along with the workers, then wait for the ones still busy
+    parallel_AVL_worker(job);
+    if(nbthreads > 1)
+    {
+        mtx_lock(&job->lock);
+        while(job->running)
+            cnd_wait(&job->done, &job->lock);
+        mtx_unlock(&job->lock);
+
+        cnd_destroy(&job->done);
+        mtx_destroy(&job->lock);
+    }
+
+    if(atomic_load(&job->status) < 0 && job->meta->doPError)
+        (*job->meta->doPError)("run_AVL_parallel: action specified returned with an error");
+
+    if(!job->partialsize)
+    {
+        free(job->tasks);
+        job->tasks = NULL;
+    }
+
+    return atomic_load(&job->status);
 }
@@ -0,0 +1,10 @@
+#ifndef CAVLINTERNAL_H_INCLUDED
+#define CAVLINTERNAL_H_INCLUDED
+#include "cavl.h"
+
+//AVL balancing, shared by the AVL implementations (not part of the API)
+dyndata_t* rotate_AVL(dyndata_t* avl, e_rotation side);
+int get_AVL_balance(dyndata_t* avl);
+void update_AVL_node(dyndata_t* avl);
+
+#endif // CAVLINTERNAL_H_INCLUDED
@@ -0,0 +1,676 @@
+/**
+ * @file cbtrees.c
+ * @brief Implement B-trees storing several contiguous keys per node
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note Nodes are allocated on cache line boundaries, and their keys are stored inline
+ *       and contiguously. A lookup therefore reads a few lines per level instead of one
+ *       scattered node per comparison, and the tree is a few levels deep only.
+ *       Full nodes are split on the way down when inserting, and nodes with the minimum
+ *       number of keys are filled on the way down when removing, so both run in one pass.
+ */
+#include "cbtrees.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BTREE_ALIGN(size, align) (((size_t)(size) + (align) - 1) & ~((size_t)(align) - 1))
+
+//B-trees internal functions
+static btnode_t* allocate_btnode(meta_t* meta, uint16_t leaf);
+static void free_btnode(meta_t* meta, btnode_t* node);
+static void* get_btkey(meta_t* meta, btnode_t* node, uint32_t i);
+static btnode_t** get_btchildren(meta_t* meta, btnode_t* node);
+static uint32_t search_btnode(meta_t* meta, btnode_t* node, const void* key, int* found);
+static int split_btchild(meta_t* meta, btnode_t* parent, uint32_t i);
+static void merge_btchildren(meta_t* meta, btnode_t* parent, uint32_t i);
+static void borrow_btleft(meta_t* meta, btnode_t* parent, uint32_t i);
+static void borrow_btright(meta_t* meta, btnode_t* parent, uint32_t i);
+static int browse_btnode(meta_t* meta, btnode_t* node, const void* low, const void* high, void* parameter, int (*doAction)(void*, void*));
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Allocate the header of a B-tree
+ * @note The structure must have been initialised with initialise_structure() beforehand
+ *
+ * @param meta  Metadata of the B-tree
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_btree(meta_t* meta){
+    btree_t* tree = NULL;
+    uint32_t maxkeys = 0;
+
+    if(!meta || !meta->elementsize || !meta->doCompare)
+        return -1;
+
+    tree = calloc(1, sizeof(btree_t));
+    if(!tree)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_btree: B-tree could not be allocated");
+
+        return -1;
+    }
+
+    tree->buffer = malloc(meta->elementsize);
+    if(!tree->buffer)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_btree: buffer could not be allocated");
+
+        free(tree);
+        return -1;
+    }
+
+    //fit as many keys and children as possible in an internal node (odd number of keys)
+    tree->keysoffset = BTREE_ALIGN(sizeof(btnode_t), _Alignof(max_align_t));
+    if(BTREE_NODE_SIZE > tree->keysoffset + sizeof(btnode_t*))
+        maxkeys = (BTREE_NODE_SIZE - tree->keysoffset - sizeof(btnode_t*)) / (meta->elementsize + sizeof(btnode_t*));
+    if(maxkeys > UINT16_MAX)
+        maxkeys = UINT16_MAX;
+    if(maxkeys < BTREE_MIN_KEYS)
+        maxkeys = BTREE_MIN_KEYS;
+    if(!(maxkeys % 2))
+        maxkeys--;
+
+    //compute the layout of the nodes, rounded up to whole cache lines
+    tree->maxkeys = maxkeys;
+    tree->childrenoffset = BTREE_ALIGN(tree->keysoffset + ((size_t)maxkeys * meta->elementsize), _Alignof(btnode_t*));
+    tree->leafsize = BTREE_ALIGN(tree->keysoffset + ((size_t)maxkeys * meta->elementsize), BTREE_CACHELINE);
+    tree->internalsize = BTREE_ALIGN(tree->childrenoffset + ((maxkeys + 1) * sizeof(btnode_t*)), BTREE_CACHELINE);
+
+    meta->structure = tree;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Free the memory of a B-tree and its data
+ *
+ * @param meta  Metadata of the B-tree
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_btree(meta_t* meta){
+    btree_t* tree = NULL;
+
+    if(!meta)
+        return -1;
+
+    tree = meta->structure;
+    if(tree)
+    {
+        if(tree->root)
+            free_btnode(meta, tree->root);
+
+        free(tree->buffer);
+        free(tree);
+    }
+
+    meta->structure = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Allocate a B-tree node, aligned on a cache line
+ *
+ * @param meta  Metadata of the B-tree
+ * @param leaf  1 if the node has no children, 0 otherwise
+ * @return      Address of the node
+ * @retval NULL Error
+ */
+static btnode_t* allocate_btnode(meta_t* meta, uint16_t leaf){
+    btree_t* tree = meta->structure;
+    btnode_t* node = NULL;
+
+    node = aligned_alloc(BTREE_CACHELINE, (leaf ? tree->leafsize : tree->internalsize));
+    if(!node)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("allocate_btnode: node could not be allocated");
+
+        return NULL;
+    }
+
+    node->nbkeys = 0;
+    node->leaf = leaf;
+
+    return node;
+}
+
+/**
+ * @brief Recursively free a B-tree node and its children
+ *
+ * @param meta  Metadata of the B-tree
+ * @param node  Node to free
+ */
+static void free_btnode(meta_t* meta, btnode_t* node){
+    btnode_t** children = NULL;
+
+    if(!node->leaf)
+    {
+        children = get_btchildren(meta, node);
+        for(uint32_t i = 0 ; i <= node->nbkeys ; i++)
+            free_btnode(meta, children[i]);
+    }
+
+    free(node);
+}
+
+/**
+ * @brief Get the address of a key in a B-tree node
+ *
+ * @param meta  Metadata of the B-tree
+ * @param node  Node in which the key is stored
+ * @param i     Index of the key
+ * @return      Address of the key
+ */
+static void* get_btkey(meta_t* meta, btnode_t* node, uint32_t i){
+    return (uint8_t*)node + ((btree_t*)meta->structure)->keysoffset + ((size_t)i * meta->elementsize);
+}
+
+/**
+ * @brief Get the children addresses of an internal B-tree node
+ *
+ * @param meta  Metadata of the B-tree
+ * @param node  Internal node
+ * @return      Array of the children addresses
+ */
+static btnode_t** get_btchildren(meta_t* meta, btnode_t* node){
+    return (btnode_t**)((uint8_t*)node + ((btree_t*)meta->structure)->childrenoffset);
+}
+
+/**
+ * @brief Find the first key of a node higher or equal to a key (binary search)
+ *
+ * @param meta  Metadata of the B-tree
+ * @param node  Node in which search
+ * @param key   Key to search
+ * @param found Set to 1 if the key is in the node, 0 otherwise
+ * @return      Index of the key found (nbkeys if all the keys are lower)
+ */
+static uint32_t search_btnode(meta_t* meta, btnode_t* node, const void* key, int* found){
+    uint32_t low = 0, high = node->nbkeys, middle = 0;
+    int cmp = 0;
+
+    *found = 0;
+    while(low < high)
+    {
+        middle = (low + high) / 2;
+        cmp = (*meta->doCompare)(get_btkey(meta, node, middle), key);
+        if(!cmp)
+        {
+            *found = 1;
+            return middle;
+        }
+
+        if(cmp < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+/**
+ * @brief Split a full child in two, moving its median key up in its parent
+ * @note The parent must not be full
+ *
+ * @param meta      Metadata of the B-tree
+ * @param parent    Parent of the node to split
+ * @param i         Index of the child to split
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+static int split_btchild(meta_t* meta, btnode_t* parent, uint32_t i){
+    btree_t* tree = meta->structure;
+    btnode_t **parentChildren = get_btchildren(meta, parent), *child = parentChildren[i], *sibling = NULL;
+    uint32_t half = tree->maxkeys / 2;
+
+    sibling = allocate_btnode(meta, child->leaf);
+    if(!sibling)
+        return -1;
+
+    //move the keys (and children) above the median in the new sibling
+    memcpy(get_btkey(meta, sibling, 0), get_btkey(meta, child, half + 1), (size_t)half * meta->elementsize);
+    if(!child->leaf)
+        memcpy(get_btchildren(meta, sibling), get_btchildren(meta, child) + half + 1, (half + 1) * sizeof(btnode_t*));
+    sibling->nbkeys = half;
+    child->nbkeys = half;
+
+    //make room in the parent, then move the median up
+    memmove(get_btkey(meta, parent, i + 1), get_btkey(meta, parent, i), (size_t)(parent->nbkeys - i) * meta->elementsize);
+    memmove(parentChildren + i + 2, parentChildren + i + 1, (parent->nbkeys - i) * sizeof(btnode_t*));
+    memcpy(get_btkey(meta, parent, i), get_btkey(meta, child, half), meta->elementsize);
+    parentChildren[i + 1] = sibling;
+    parent->nbkeys++;
+
+    return 0;
+}
+
+/**
+ * @brief Merge a child with its right sibling and the key separating them
+ *
+ * @param meta      Metadata of the B-tree
+ * @param parent    Parent of the nodes to merge
+ * @param i         Index of the left child
+ */
+static void merge_btchildren(meta_t* meta, btnode_t* parent, uint32_t i){
+    btnode_t **parentChildren = get_btchildren(meta, parent), *child = parentChildren[i], *sibling = parentChildren[i + 1];
+
+    //append the separator, then the keys (and children) of the sibling to the child
+    memcpy(get_btkey(meta, child, child->nbkeys), get_btkey(meta, parent, i), meta->elementsize);
+    memcpy(get_btkey(meta, child, child->nbkeys + 1U), get_btkey(meta, sibling, 0), (size_t)sibling->nbkeys * meta->elementsize);
+    if(!child->leaf)
+        memcpy(get_btchildren(meta, child) + child->nbkeys + 1, get_btchildren(meta, sibling), (sibling->nbkeys + 1U) * sizeof(btnode_t*));
+    child->nbkeys += sibling->nbkeys + 1;
+
+    //remove the separator and the sibling from the parent
+    memmove(get_btkey(meta, parent, i), get_btkey(meta, parent, i + 1), (size_t)(parent->nbkeys - i - 1) * meta->elementsize);
+    memmove(parentChildren + i + 1, parentChildren + i + 2, (parent->nbkeys - i - 1) * sizeof(btnode_t*));
+    parent->nbkeys--;
+
+    free(sibling);
+}
+
+/**
+ * @brief Move a key from the left sibling of a child to the child, through their parent
+ *
+ * @param meta      Metadata of the B-tree
+ * @param parent    Parent of the child
+ * @param i         Index of the child
+ */
+static void borrow_btleft(meta_t* meta, btnode_t* parent, uint32_t i){
+    btnode_t **parentChildren = get_btchildren(meta, parent), *child = parentChildren[i], *sibling = parentChildren[i - 1];
+    btnode_t** children = NULL;
+
+    //make room for the separator at the beginning of the child
+    memmove(get_btkey(meta, child, 1), get_btkey(meta, child, 0), (size_t)child->nbkeys * meta->elementsize);
+    memcpy(get_btkey(meta, child, 0), get_btkey(meta, parent, i - 1), meta->elementsize);
+    if(!child->leaf)
+    {
+        children = get_btchildren(meta, child);
+        memmove(children + 1, children, (child->nbkeys + 1U) * sizeof(btnode_t*));
+        children[0] = get_btchildren(meta, sibling)[sibling->nbkeys];
+    }
+    child->nbkeys++;
+
+    //the last key of the sibling becomes the separator
+    memcpy(get_btkey(meta, parent, i - 1), get_btkey(meta, sibling, sibling->nbkeys - 1U), meta->elementsize);
+    sibling->nbkeys--;
+}
+
+/**
+ * @brief Move a key from the right sibling of a child to the child, through their parent
+ *
+ * @param meta      Metadata of the B-tree
+ * @param parent    Parent of the child
+ * @param i         Index of the child
+ */
+static void borrow_btright(meta_t* meta, btnode_t* parent, uint32_t i){
+    btnode_t **parentChildren = get_btchildren(meta, parent), *child = parentChildren[i], *sibling = parentChildren[i + 1];
+    btnode_t** children = NULL;
+
+    //append the separator to the child
+    memcpy(get_btkey(meta, child, child->nbkeys), get_btkey(meta, parent, i), meta->elementsize);
+    if(!child->leaf)
+        get_btchildren(meta, child)[child->nbkeys + 1] = get_btchildren(meta, sibling)[0];
+    child->nbkeys++;
+
+    //the first key of the sibling becomes the separator
+    memcpy(get_btkey(meta, parent, i), get_btkey(meta, sibling, 0), meta->elementsize);
+    memmove(get_btkey(meta, sibling, 0), get_btkey(meta, sibling, 1), (size_t)(sibling->nbkeys - 1U) * meta->elementsize);
+    if(!sibling->leaf)
+    {
+        children = get_btchildren(meta, sibling);
+        memmove(children, children + 1, sibling->nbkeys * sizeof(btnode_t*));
+    }
+    sibling->nbkeys--;
+}
+
+/**
+ * @brief Insert an element in a B-tree
+ * @note Full nodes are split on the way down, so the tree is browsed once
+ *
+ * @param meta  Metadata of the B-tree
+ * @param toAdd Element to insert
+ * @retval  0 Added
+ * @retval  1 Already in the B-tree
+ * @retval -1 Error
+ */
+int insertBTree(meta_t* meta, const void* toAdd){
+    btree_t* tree = NULL;
+    btnode_t *node = NULL, *child = NULL;
+    uint32_t i = 0;
+    int found = 0, cmp = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("insertBTree: new element cannot be NULL");
+
+        return -1;
+    }
+
+    tree = meta->structure;
+
+    //first element, create a leaf as the root
+    if(!tree->root)
+    {
+        tree->root = allocate_btnode(meta, 1);
+        if(!tree->root)
+            return -1;
+
+        tree->height = 1;
+    }
+
+    //root full, split it under a new root (the tree grows by the top)
+    if(tree->root->nbkeys == tree->maxkeys)
+    {
+        node = allocate_btnode(meta, 0);
+        if(!node)
+            return -1;
+
+        get_btchildren(meta, node)[0] = tree->root;
+        if(split_btchild(meta, node, 0) < 0)
+        {
+            free(node);
+            return -1;
+        }
+
+        tree->root = node;
+        tree->height++;
+    }
+
+    node = tree->root;
+    while(1)
+    {
+        i = search_btnode(meta, node, toAdd, &found);
+        if(found)
+            return 1;
+
+        //leaf reached, make room for the element
+        if(node->leaf)
+        {
+            memmove(get_btkey(meta, node, i + 1), get_btkey(meta, node, i), (size_t)(node->nbkeys - i) * meta->elementsize);
+            memcpy(get_btkey(meta, node, i), toAdd, meta->elementsize);
+            node->nbkeys++;
+            meta->nbelements++;
+
+            return 0;
+        }
+
+        //split the child if full, then go down the half in which the element belongs
+        child = get_btchildren(meta, node)[i];
+        if(child->nbkeys == tree->maxkeys)
+        {
+            if(split_btchild(meta, node, i) < 0)
+                return -1;
+
+            cmp = (*meta->doCompare)(get_btkey(meta, node, i), toAdd);
+            if(!cmp)
+                return 1;
+            if(cmp < 0)
+                i++;
+        }
+
+        node = get_btchildren(meta, node)[i];
+    }
+}
+
+/**
+ * @brief Remove an element from a B-tree
+ * @note Nodes with the minimum number of keys are filled on the way down,
+ *       so the tree is browsed once
+ *
+ * @param meta      Metadata of the B-tree
+ * @param toRemove  Element to remove
+ * @retval  1 Removed
+ * @retval  0 Not in the B-tree
+ * @retval -1 Error
+ */
+int removeBTree(meta_t* meta, const void* toRemove){
+    btree_t* tree = NULL;
+    btnode_t *node = NULL, *child = NULL, **children = NULL;
+    const void* key = toRemove;
+    uint32_t i = 0, minkeys = 0;
+    int found = 0, ret = 0;
+
+    if(!meta || !meta->structure || !toRemove)
+        return -1;
+
+    tree = meta->structure;
+    node = tree->root;
+    minkeys = tree->maxkeys / 2;
+
+    while(node)
+    {
+        i = search_btnode(meta, node, key, &found);
+
+        //leaf reached, remove the key if found
+        if(node->leaf)
+        {
+            if(found)
+            {
+                memmove(get_btkey(meta, node, i), get_btkey(meta, node, i + 1), (size_t)(node->nbkeys - i - 1) * meta->elementsize);
+                node->nbkeys--;
+                meta->nbelements--;
+                ret = 1;
+            }
+
+            break;
+        }
+
+        children = get_btchildren(meta, node);
+        if(found)
+        {
+            if(children[i]->nbkeys > minkeys)
+            {
+                //replace the key by its predecessor, then remove the predecessor from the left subtree
+                child = children[i];
+                while(!child->leaf)
+                    child = get_btchildren(meta, child)[child->nbkeys];
+
+                memcpy(tree->buffer, get_btkey(meta, child, child->nbkeys - 1U), meta->elementsize);
+                memcpy(get_btkey(meta, node, i), tree->buffer, meta->elementsize);
+                key = tree->buffer;
+            }
+            else if(children[i + 1]->nbkeys > minkeys)
+            {
+                //replace the key by its successor, then remove the successor from the right subtree
+                child = children[i + 1];
+                while(!child->leaf)
+                    child = get_btchildren(meta, child)[0];
+
+                memcpy(tree->buffer, get_btkey(meta, child, 0), meta->elementsize);
+                memcpy(get_btkey(meta, node, i), tree->buffer, meta->elementsize);
+                key = tree->buffer;
+                i++;
+            }
+            else
+            {
+                //both subtrees are minimal, merge them around the key and remove it from there
+                merge_btchildren(meta, node, i);
+            }
+        }
+        else if(children[i]->nbkeys <= minkeys)
+        {
+            //make sure the child to go down can lose a key
+            if(i > 0 && children[i - 1]->nbkeys > minkeys)
+                borrow_btleft(meta, node, i);
+            else if(i < node->nbkeys && children[i + 1]->nbkeys > minkeys)
+                borrow_btright(meta, node, i);
+            else if(i < node->nbkeys)
+                merge_btchildren(meta, node, i);
+            else
+                merge_btchildren(meta, node, --i);
+        }
+
+        //root emptied by a merge, the tree shrinks by the top
+        child = children[i];
+        if(!node->nbkeys)
+        {
+            tree->root = child;
+            tree->height--;
+            free(node);
+        }
+
+        node = child;
+    }
+
+    //last element removed
+    if(tree->root && !tree->root->nbkeys)
+    {
+        free(tree->root);
+        tree->root = NULL;
+        tree->height = 0;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Search an element in a B-tree
+ *
+ * @param meta  Metadata of the B-tree
+ * @param key   Key to search
+ * @return      Address of the element in the B-tree (valid until the next modification)
+ * @retval NULL Not found
+ */
+void* search_BTree(meta_t* meta, const void* key){
+    btnode_t* node = NULL;
+    uint32_t i = 0;
+    int found = 0;
+
+    if(!meta || !meta->structure || !key)
+        return NULL;
+
+    node = ((btree_t*)meta->structure)->root;
+    while(node)
+    {
+        i = search_btnode(meta, node, key, &found);
+        if(found)
+            return get_btkey(meta, node, i);
+
+        node = (node->leaf ? NULL : get_btchildren(meta, node)[i]);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Recursively perform an action on the keys of a node between two keys (included)
+ *
+ * @param meta      Metadata of the B-tree
+ * @param node      Node to browse
+ * @param low       Lowest key of the range (NULL if none)
+ * @param high      Highest key of the range (NULL if none)
+ * @param parameter Parameter for the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 Keep browsing
+ * @retval  1 Browsing stopped by the action
+ * @retval  2 Highest key of the range passed
+ * @retval -1 Error
+ */
+static int browse_btnode(meta_t* meta, btnode_t* node, const void* low, const void* high, void* parameter, int (*doAction)(void*, void*)){
+    uint32_t i = 0;
+    int found = 0, ret = 0;
+
+    //skip the keys lower than the range, and the subtree left of the lowest key if found
+    if(low)
+        i = search_btnode(meta, node, low, &found);
+
+    for( ; i <= node->nbkeys ; i++)
+    {
+        if(!node->leaf && !found)
+        {
+            ret = browse_btnode(meta, get_btchildren(meta, node)[i], low, high, parameter, doAction);
+            if(ret)
+                return ret;
+        }
+
+        //everything after the first subtree is higher than the lowest key
+        low = NULL;
+        found = 0;
+        if(i == node->nbkeys)
+            break;
+
+        if(high && (*meta->doCompare)(get_btkey(meta, node, i), high) > 0)
+            return 2;
+
+        ret = (*doAction)(get_btkey(meta, node, i), parameter);
+        if(ret)
+            return (ret < 0 ? -1 : 1);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Perform an action on every element of a B-tree, in ascending order
+ * @note The browsing stops as soon as the action returns something else than 0
+ *
+ * @param meta      Metadata of the B-tree
+ * @param parameter Parameter for the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 OK
+ * @retval  1 Browsing stopped by the action
+ * @retval -1 Error
+ */
+int foreachBTree(meta_t* meta, void* parameter, int (*doAction)(void*, void*)){
+    return foreachBTreeRange(meta, NULL, NULL, parameter, doAction);
+}
+
+/**
+ * @brief Perform an action on the elements of a B-tree between two keys (included), in ascending order
+ * @note Only the elements in the range are visited, and the browsing stops as soon as
+ *       the action returns something else than 0
+ *
+ * @param meta      Metadata of the B-tree
+ * @param low       Lowest key of the range (NULL to start from the lowest element)
+ * @param high      Highest key of the range (NULL to go up to the highest element)
+ * @param parameter Parameter for the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 OK
+ * @retval  1 Browsing stopped by the action
+ * @retval -1 Error
+ */
+int foreachBTreeRange(meta_t* meta, const void* low, const void* high, void* parameter, int (*doAction)(void*, void*)){
+    btree_t* tree = NULL;
+    int ret = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!doAction)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachBTreeRange: action to perform not defined");
+
+        return -1;
+    }
+
+    tree = meta->structure;
+    if(!tree->root)
+        return 0;
+
+    ret = browse_btnode(meta, tree->root, low, high, parameter, doAction);
+    if(ret < 0 && meta->doPError)
+        (*meta->doPError)("foreachBTreeRange: action specified returned with an error");
+
+    return (ret == 2 ? 0 : ret);
+}
@@ -0,0 +1,344 @@
+/**
+ * @file cbucketqueues.c
+ * @brief Implement priority queues for small integer priorities, as bucket queues
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note Pushing appends to the bucket of the priority in O(1), and popping takes
+ *       the head of the first non-empty bucket found in the bitmap, also in O(1).
+ *       Elements of equal priority are popped in the order they were pushed.
+ *       The lowest priority is popped first, as priorities usually are deadlines.
+ */
+#include "cbucketqueues.h"
+#include <stdlib.h>
+#include <string.h>
+
+//bucket queues internal functions
+static uint32_t* get_bucket_next(const bucketqueue_t* queue, uint32_t node);
+static uint8_t* get_bucket_elem(const bucketqueue_t* queue, uint32_t node);
+static int get_first_bucket(const bucketqueue_t* queue);
+static uint32_t allocate_bucket_node(meta_t* meta, bucketqueue_t* queue);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Allocate the nodes array of a bucket queue
+ * @note The structure must have been initialised with initialise_structure() beforehand
+ *
+ * @param meta      Metadata of the bucket queue
+ * @param capacity  Number of elements to reserve (the array grows on demand)
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_bucket_queue(meta_t* meta, uint32_t capacity){
+    bucketqueue_t* queue = NULL;
+
+    if(!meta || !meta->elementsize)
+        return -1;
+
+    queue = calloc(1, sizeof(bucketqueue_t));
+    if(!queue)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_bucket_queue: queue could not be allocated");
+
+        return -1;
+    }
+
+    queue->stride = BUCKET_ALIGNMENT + ((meta->elementsize + BUCKET_ALIGNMENT - 1) & ~(BUCKET_ALIGNMENT - 1));
+    queue->freenode = BUCKET_NONE;
+    for(uint32_t i = 0 ; i < BUCKET_PRIORITIES ; i++)
+        queue->heads[i] = queue->tails[i] = BUCKET_NONE;
+
+    if(capacity)
+    {
+        queue->nodes = malloc((size_t)capacity * queue->stride);
+        if(!queue->nodes)
+        {
+            if(meta->doPError)
+                (*meta->doPError)("initialise_bucket_queue: array of %u nodes could not be allocated", capacity);
+
+            free(queue);
+            return -1;
+        }
+        queue->capacity = capacity;
+    }
+
+    meta->structure = queue;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Free the memory of a bucket queue and its elements
+ *
+ * @param meta Metadata of the bucket queue
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_bucket_queue(meta_t* meta){
+    bucketqueue_t* queue = NULL;
+
+    if(!meta)
+        return -1;
+
+    queue = meta->structure;
+    if(queue)
+    {
+        free(queue->nodes);
+        free(queue);
+    }
+
+    meta->structure = NULL;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Push a new element at the end of the bucket of its priority, in O(1)
+ *
+ * @param meta      Metadata of the bucket queue
+ * @param toAdd     Element to push
+ * @param priority  Priority of the element (the lowest is popped first)
+ * @retval  0 Element pushed
+ * @retval -1 Error
+ */
+int pushBucketQueue(meta_t* meta, const void* toAdd, uint8_t priority){
+    bucketqueue_t* queue = NULL;
+    uint32_t node = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("pushBucketQueue: new element cannot be NULL");
+
+        return -1;
+    }
+
+    queue = meta->structure;
+    node = allocate_bucket_node(meta, queue);
+    if(node == BUCKET_NONE)
+        return -1;
+
+    memcpy(get_bucket_elem(queue, node), toAdd, meta->elementsize);
+    *get_bucket_next(queue, node) = BUCKET_NONE;
+
+    //append the node to its bucket, flagging the bucket as non-empty if it was
+    if(queue->tails[priority] == BUCKET_NONE)
+    {
+        queue->heads[priority] = node;
+        queue->bitmap[priority / 64] |= (1ULL << (priority % 64));
+    }
+    else
+        *get_bucket_next(queue, queue->tails[priority]) = node;
+    queue->tails[priority] = node;
+
+    meta->nbelements++;
+    return 0;
+}
+
+/**
+ * @brief Pop the oldest element with the lowest priority from a bucket queue, in O(1)
+ *
+ * @param meta      Metadata of the bucket queue
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @param priority  Buffer in which store the priority of the element (can be NULL)
+ * @retval  1 Popped
+ * @retval  0 Queue empty
+ * @retval -1 Error
+ */
+int popBucketQueue(meta_t* meta, void* popped, uint8_t* priority){
+    bucketqueue_t* queue = NULL;
+    uint32_t node = 0;
+    int first = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    queue = meta->structure;
+    first = get_first_bucket(queue);
+    if(first < 0)
+        return 0;
+
+    node = queue->heads[first];
+    if(popped)
+        memcpy(popped, get_bucket_elem(queue, node), meta->elementsize);
+    if(priority)
+        *priority = (uint8_t)first;
+
+    //unlink the node, clearing the bit of the bucket if it is now empty
+    queue->heads[first] = *get_bucket_next(queue, node);
+    if(queue->heads[first] == BUCKET_NONE)
+    {
+        queue->tails[first] = BUCKET_NONE;
+        queue->bitmap[first / 64] &= ~(1ULL << (first % 64));
+    }
+
+    //chain the node to the free ones
+    *get_bucket_next(queue, node) = queue->freenode;
+    queue->freenode = node;
+
+    meta->nbelements--;
+    return 1;
+}
+
+/**
+ * @brief Get the oldest element with the lowest priority from a bucket queue, without popping it
+ *
+ * @param meta      Metadata of the bucket queue
+ * @param priority  Buffer in which store the priority of the element (can be NULL)
+ * @return          Element to be popped next
+ * @retval NULL     Queue empty or error
+ */
+void* peekBucketQueue(meta_t* meta, uint8_t* priority){
+    bucketqueue_t* queue = NULL;
+    int first = 0;
+
+    if(!meta || !meta->structure)
+        return NULL;
+
+    queue = meta->structure;
+    first = get_first_bucket(queue);
+    if(first < 0)
+        return NULL;
+
+    if(priority)
+        *priority = (uint8_t)first;
+
+    return get_bucket_elem(queue, queue->heads[first]);
+}
+
+/**
+ * @brief Perform an action on every element of a bucket queue, in the order they would be popped
+ *
+ * @param meta      Metadata of the bucket queue
+ * @param parameter Parameter used by the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 Action performed
+ * @retval -1 Error
+ */
+int foreachBucketQueue(meta_t* meta, void* parameter, int (*doAction)(void*, void*)){
+    bucketqueue_t* queue = NULL;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!doAction)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachBucketQueue: action to perform not defined");
+
+        return -1;
+    }
+
+    queue = meta->structure;
+    for(uint32_t i = 0 ; i < BUCKET_PRIORITIES ; i++)
+    {
+        for(uint32_t node = queue->heads[i] ; node != BUCKET_NONE ; node = *get_bucket_next(queue, node))
+        {
+            if((*doAction)(get_bucket_elem(queue, node), parameter) < 0)
+            {
+                if(meta->doPError)
+                    (*meta->doPError)("foreachBucketQueue: action specified returned with an error");
+
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get the address of the index of the node following another one
+ *
+ * @param queue Bucket queue in which get the node
+ * @param node  Index of the node
+ * @return      Address of the index of the next node
+ */
+static uint32_t* get_bucket_next(const bucketqueue_t* queue, uint32_t node){
+    return (uint32_t*)(queue->nodes + ((size_t)node * queue->stride));
+}
+
+/**
+ * @brief Get the address of the element of a node
+ *
+ * @param queue Bucket queue in which get the element
+ * @param node  Index of the node
+ * @return      Address of the element
+ */
+static uint8_t* get_bucket_elem(const bucketqueue_t* queue, uint32_t node){
+    return queue->nodes + ((size_t)node * queue->stride) + BUCKET_ALIGNMENT;
+}
+
+/**
+ * @brief Find the lowest priority having a non-empty bucket
+ *
+ * @param queue Bucket queue in which find the priority
+ * @return      Lowest priority having elements
+ * @retval -1   Queue empty
+ */
+static int get_first_bucket(const bucketqueue_t* queue){
+    for(uint32_t i = 0 ; i < BUCKET_PRIORITIES / 64 ; i++)
+    {
+        if(queue->bitmap[i])
+            return (int)((i * 64) + (uint32_t)__builtin_ctzll(queue->bitmap[i]));
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Take a free node, or a new one at the end of the array (doubled if full)
+ *
+ * @param meta  Metadata of the bucket queue
+ * @param queue Bucket queue in which allocate the node
+ * @return      Index of the node
+ * @retval BUCKET_NONE Error
+ */
+static uint32_t allocate_bucket_node(meta_t* meta, bucketqueue_t* queue){
+    uint8_t* nodes = NULL;
+    uint32_t node = queue->freenode, capacity = 0;
+
+    if(node != BUCKET_NONE)
+    {
+        queue->freenode = *get_bucket_next(queue, node);
+        return node;
+    }
+
+    if(queue->nbnodes == queue->capacity)
+    {
+        if(queue->capacity >= BUCKET_NONE / 2)
+        {
+            if(meta->doPError)
+                (*meta->doPError)("allocate_bucket_node: maximum capacity reached");
+
+            return BUCKET_NONE;
+        }
+
+        capacity = (queue->capacity ? queue->capacity * 2 : 16);
+        nodes = realloc(queue->nodes, (size_t)capacity * queue->stride);
+        if(!nodes)
+        {
+            if(meta->doPError)
+                (*meta->doPError)("allocate_bucket_node: array of %u nodes could not be allocated", capacity);
+
+            return BUCKET_NONE;
+        }
+
+        queue->nodes = nodes;
+        queue->capacity = capacity;
+    }
+
+    return queue->nbnodes++;
+}
@@ -0,0 +1,627 @@
+/**
+ * @file cconcurrentavl.c
+ * @brief Implement AVL trees readable while being modified (path copying)
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note A writer copies every node it has to modify (the path to the element and the nodes
+ *       rotated), builds the new version on the copies, then publishes the new root with a
+ *       single atomic store. Published nodes are never modified, so readers only load the
+ *       root and browse it like a regular AVL, without any lock. The data of the elements
+ *       is shared between the versions, only the nodes are copied.
+ */
+#include "cconcurrentavl.h"
+#include "cavlinternal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define CAVL_MAX_COPIES (3U * AVL_MAX_HEIGHT)   ///< Maximum number of nodes a writer can create (path and rotations)
+
+/********************************************************
+ * @brief Modification of a concurrent AVL in progress
+********************************************************/
+typedef struct
+{
+    meta_t*     meta;                           ///< Metadata of the AVL
+    dyndata_t*  fresh[CAVL_MAX_COPIES];         ///< Nodes created for the new version
+    uint32_t    nbfresh;                        ///< Number of nodes created
+    retired_t   retired[CAVL_MAX_COPIES + 2];   ///< Memory to retire once the new version is published
+    uint32_t    nbretired;                      ///< Amount of memory to retire
+    dyndata_t*  added;                          ///< Element inserted (if any)
+    dyndata_t*  removed;                        ///< Element removed (if any)
+    int         error;                          ///< 1 if an allocation failed, 0 otherwise
+} cavlwrite_t;
+
+//concurrent AVL internal functions
+static void free_concurrent_AVL_node(dyndata_t* node);
+static dyndata_t* own_concurrent_AVL_node(cavlwrite_t* write, dyndata_t* node);
+static dyndata_t* rebalance_concurrent_AVL(cavlwrite_t* write, dyndata_t* node);
+static dyndata_t* insert_concurrent_AVL_node(cavlwrite_t* write, dyndata_t* node, const void* toAdd);
+static dyndata_t* remove_concurrent_AVL_node(cavlwrite_t* write, dyndata_t* node, const void* key);
+static dyndata_t* remove_concurrent_AVL_min(cavlwrite_t* write, dyndata_t* node, dyndata_t** min);
+static int publish_concurrent_AVL(cavlwrite_t* write, int slot, dyndata_t* root);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Allocate the header of a concurrent AVL
+ * @note The structure must have been initialised with initialise_structure() beforehand
+ *
+ * @param meta  Metadata of the AVL
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_concurrent_AVL(meta_t* meta){
+    concurrentavl_t* tree = NULL;
+
+    if(!meta || !meta->doCompare)
+        return -1;
+
+    //the epoch slots are aligned on cache lines, so is the header
+    tree = aligned_alloc(EPOCH_CACHELINE, sizeof(concurrentavl_t));
+    if(!tree)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_concurrent_AVL: AVL could not be allocated");
+
+        return -1;
+    }
+    memset(tree, 0, sizeof(concurrentavl_t));
+
+    if(mtx_init(&tree->writer, mtx_plain) != thrd_success)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_concurrent_AVL: writers lock could not be created");
+
+        free(tree);
+        return -1;
+    }
+
+    atomic_init(&tree->root, NULL);
+    initialise_epochs(&tree->epochs);
+
+    meta->structure = tree;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Free the memory of a concurrent AVL and its data
+ * @warning No thread may use the AVL anymore
+ *
+ * @param meta  Metadata of the AVL
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_concurrent_AVL(meta_t* meta){
+    concurrentavl_t* tree = NULL;
+
+    if(!meta)
+        return -1;
+
+    tree = meta->structure;
+    if(tree)
+    {
+        free_concurrent_AVL_node(atomic_load(&tree->root));
+        free_epochs(&tree->epochs);
+        mtx_destroy(&tree->writer);
+        free(tree);
+    }
+
+    meta->structure = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Recursively free the nodes of an AVL and their data
+ *
+ * @param node  Root of the subtree to free
+ */
+static void free_concurrent_AVL_node(dyndata_t* node){
+    if(!node)
+        return;
+
+    free_concurrent_AVL_node(node->left);
+    free_concurrent_AVL_node(node->right);
+    free_dyn(&node);
+}
+
+/**
+ * @brief Register the calling thread as a user of a concurrent AVL
+ *
+ * @param meta  Metadata of the AVL
+ * @return      Slot to use in all the subsequent calls of the thread
+ * @retval -1   Error
+ */
+int register_concurrent_AVL(meta_t* meta){
+    int slot = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    slot = register_epochs(&((concurrentavl_t*)meta->structure)->epochs);
+    if(slot < 0 && meta->doPError)
+        (*meta->doPError)("register_concurrent_AVL: more than %u threads registered", EPOCH_MAX_THREADS);
+
+    return slot;
+}
+
+/**
+ * @brief Unregister a thread from a concurrent AVL
+ *
+ * @param meta  Metadata of the AVL
+ * @param slot  Slot of the thread
+ */
+void unregister_concurrent_AVL(meta_t* meta, int slot){
+    if(meta && meta->structure && slot >= 0)
+        unregister_epochs(&((concurrentavl_t*)meta->structure)->epochs, slot);
+}
+
+/**
+ * @brief Get a version of a node which can be modified by the current writer
+ * @note Published nodes are copied (and retired once the new version is published),
+ *       nodes already created by the writer are returned as-is
+ *
+ * @param write Modification in progress
+ * @param node  Node to modify
+ * @return      Node which can be modified (the original node if an error occurred)
+ */
+static dyndata_t* own_concurrent_AVL_node(cavlwrite_t* write, dyndata_t* node){
+    dyndata_t* copy = NULL;
+
+    if(write->error || (node->flags & CAVL_FRESH))
+        return node;
+
+    copy = malloc(sizeof(dyndata_t));
+    if(!copy)
+    {
+        if(write->meta->doPError)
+            (*write->meta->doPError)("own_concurrent_AVL_node: node could not be copied");
+
+        write->error = 1;
+        return node;
+    }
+
+    //the copy takes over the data, only the original node is retired
+    memcpy(copy, node, sizeof(dyndata_t));
+    copy->flags = CAVL_FRESH;
+    write->fresh[write->nbfresh++] = copy;
+    write->retired[write->nbretired].ptr = node;
+    write->retired[write->nbretired++].doFree = free;
+
+    return copy;
+}
+
+/**
+ * @brief Update a node created by the writer and re-balance it if necessary
+ * @note The children rotated are copied first, as they may be published
+ *
+ * @param write Modification in progress
+ * @param node  Node to re-balance (created by the writer)
+ * @return      New root of the subtree
+ */
+static dyndata_t* rebalance_concurrent_AVL(cavlwrite_t* write, dyndata_t* node){
+    dyndata_t *child = NULL, *grandchild = NULL;
+    int balance = 0;
+
+    update_AVL_node(node);
+    balance = get_AVL_balance(node);
+
+    if(balance > 1){
+        child = own_concurrent_AVL_node(write, node->left);
+
+        //left right case
+        if(get_AVL_balance(child) < 0){
+            grandchild = own_concurrent_AVL_node(write, child->right);
+            if(write->error)
+                return node;
+
+            child->right = grandchild;
+            child = rotate_AVL(child, LEFT);
+        }
+        if(write->error)
+            return node;
+
+        //left left case
+        node->left = child;
+        return rotate_AVL(node, RIGHT);
+    }
+
+    if(balance < -1){
+        child = own_concurrent_AVL_node(write, node->right);
+
+        //right left case
+        if(get_AVL_balance(child) > 0){
+            grandchild = own_concurrent_AVL_node(write, child->left);
+            if(write->error)
+                return node;
+
+            child->left = grandchild;
+            child = rotate_AVL(child, RIGHT);
+        }
+        if(write->error)
+            return node;
+
+        //right right case
+        node->right = child;
+        return rotate_AVL(node, LEFT);
+    }
+
+    return node;
+}
+
+/**
+ * @brief Recursively insert an element in a new version of a subtree
+ *
+ * @param write Modification in progress
+ * @param node  Root of the subtree (published version)
+ * @param toAdd Element to insert
+ * @return      Root of the new version of the subtree (unchanged if nothing inserted)
+ */
+static dyndata_t* insert_concurrent_AVL_node(cavlwrite_t* write, dyndata_t* node, const void* toAdd){
+    dyndata_t *child = NULL, *copy = NULL;
+    int cmp = 0;
+
+    //leaf reached, create the element
+    if(!node){
+        write->added = allocate_dyn(write->meta, toAdd);
+        if(!write->added){
+            write->error = 1;
+            return NULL;
+        }
+
+        write->added->flags |= CAVL_FRESH;
+        write->fresh[write->nbfresh++] = write->added;
+        return write->added;
+    }
+
+    //ignore duplicates (forbidden in AVL trees)
+    cmp = (*write->meta->doCompare)(node->data, toAdd);
+    if(!cmp)
+        return node;
+
+    child = insert_concurrent_AVL_node(write, (cmp < 0 ? node->right : node->left), toAdd);
+    if(!write->added || write->error)
+        return node;
+
+    //copy the node to link the new version of its child
+    copy = own_concurrent_AVL_node(write, node);
+    if(write->error)
+        return node;
+
+    if(cmp < 0)
+        copy->right = child;
+    else
+        copy->left = child;
+
+    return rebalance_concurrent_AVL(write, copy);
+}
+
+/**
+ * @brief Recursively remove an element from a new version of a subtree
+ *
+ * @param write Modification in progress
+ * @param node  Root of the subtree (published version)
+ * @param key   Key of the element to remove
+ * @return      Root of the new version of the subtree (unchanged if nothing removed)
+ */
+static dyndata_t* remove_concurrent_AVL_node(cavlwrite_t* write, dyndata_t* node, const void* key){
+    dyndata_t *child = NULL, *copy = NULL, *successor = NULL;
+    int cmp = 0;
+
+    if(!node)
+        return NULL;
+
+    cmp = (*write->meta->doCompare)(node->data, key);
+    if(cmp){
+        child = remove_concurrent_AVL_node(write, (cmp < 0 ? node->right : node->left), key);
+        if(!write->removed || write->error)
+            return node;
+
+        //copy the node to link the new version of its child
+        copy = own_concurrent_AVL_node(write, node);
+        if(write->error)
+            return node;
+
+        if(cmp < 0)
+            copy->right = child;
+        else
+            copy->left = child;
+
+        return rebalance_concurrent_AVL(write, copy);
+    }
+
+    //less than 2 children nodes, replace the node by its child (if any)
+    write->removed = node;
+    if(!node->left || !node->right)
+        return (node->left ? node->left : node->right);
+
+    //2 children nodes, take the successor out of the right subtree and put it at the place of the node
+    child = remove_concurrent_AVL_min(write, node->right, &successor);
+    if(write->error)
+        return node;
+
+    copy = own_concurrent_AVL_node(write, successor);
+    if(write->error)
+        return node;
+
+    copy->left = node->left;
+    copy->right = child;
+
+    return rebalance_concurrent_AVL(write, copy);
+}
+
+/**
+ * @brief Recursively remove the lowest element from a new version of a subtree
+ *
+ * @param write Modification in progress
+ * @param node  Root of the subtree (published version)
+ * @param min   Lowest element removed (published version)
+ * @return      Root of the new version of the subtree
+ */
+static dyndata_t* remove_concurrent_AVL_min(cavlwrite_t* write, dyndata_t* node, dyndata_t** min){
+    dyndata_t *child = NULL, *copy = NULL;
+
+    if(!node->left){
+        *min = node;
+        return node->right;
+    }
+
+    child = remove_concurrent_AVL_min(write, node->left, min);
+    copy = own_concurrent_AVL_node(write, node);
+    if(write->error)
+        return node;
+
+    copy->left = child;
+    return rebalance_concurrent_AVL(write, copy);
+}
+
+/**
+ * @brief Publish the new version built by a writer, or discard it if an error occurred
+ * @note Must be called within a critical section, with the writers lock held
+ *
+ * @param write Modification in progress
+ * @param slot  Slot of the writer
+ * @param root  Root of the new version
+ * @retval  0 OK
+ * @retval -1 Error (the published version is left unchanged)
+ */
+static int publish_concurrent_AVL(cavlwrite_t* write, int slot, dyndata_t* root){
+    concurrentavl_t* tree = write->meta->structure;
+
+    //discard the nodes created, the published nodes were never modified
+    if(write->error){
+        for(uint32_t i = 0 ; i < write->nbfresh ; i++){
+            if(write->fresh[i] == write->added)
+                free(write->fresh[i]->data);
+
+            free(write->fresh[i]);
+        }
+
+        return -1;
+    }
+
+    //the nodes created become regular published nodes
+    for(uint32_t i = 0 ; i < write->nbfresh ; i++)
+        write->fresh[i]->flags &= (uint16_t)~CAVL_FRESH;
+
+    atomic_store_explicit(&tree->root, root, memory_order_release);
+
+    //the nodes replaced can only be freed once the readers left the previous versions
+    for(uint32_t i = 0 ; i < write->nbretired ; i++)
+        retire_epochs(&tree->epochs, slot, write->retired[i].ptr, write->retired[i].doFree);
+
+    return 0;
+}
+
+/**
+ * @brief Insert an element in a concurrent AVL
+ * @note Writers are serialised, readers are never blocked
+ *
+ * @param meta  Metadata of the AVL
+ * @param slot  Slot of the thread
+ * @param toAdd Element to insert
+ * @retval  0 Added
+ * @retval  1 Already in the AVL
+ * @retval -1 Error
+ */
+int insertConcurrentAVL(meta_t* meta, int slot, const void* toAdd){
+    cavlwrite_t write = {.meta = meta};
+    concurrentavl_t* tree = NULL;
+    dyndata_t* root = NULL;
+    int ret = 0;
+
+    if(!meta || !meta->structure || slot < 0)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("insertConcurrentAVL: new element cannot be NULL");
+
+        return -1;
+    }
+
+    tree = meta->structure;
+    mtx_lock(&tree->writer);
+    enter_epochs(&tree->epochs, slot);
+
+    root = insert_concurrent_AVL_node(&write, atomic_load_explicit(&tree->root, memory_order_relaxed), toAdd);
+    if(write.added || write.error)
+        ret = publish_concurrent_AVL(&write, slot, root);
+    if(!ret)
+        ret = (write.added ? 0 : 1);
+    if(!ret)
+        meta->nbelements++;
+
+    exit_epochs(&tree->epochs, slot);
+    mtx_unlock(&tree->writer);
+
+    return ret;
+}
+
+/**
+ * @brief Remove an element from a concurrent AVL
+ * @note Writers are serialised, readers are never blocked
+ *
+ * @param meta      Metadata of the AVL
+ * @param slot      Slot of the thread
+ * @param toRemove  Key of the element to remove
+ * @retval  1 Removed
+ * @retval  0 Not in the AVL
+ * @retval -1 Error
+ */
+int removeConcurrentAVL(meta_t* meta, int slot, const void* toRemove){
+    cavlwrite_t write = {.meta = meta};
+    concurrentavl_t* tree = NULL;
+    dyndata_t* root = NULL;
+    int ret = 0;
+
+    if(!meta || !meta->structure || !toRemove || slot < 0)
+        return -1;
+
+    tree = meta->structure;
+    mtx_lock(&tree->writer);
+    enter_epochs(&tree->epochs, slot);
+
+    root = remove_concurrent_AVL_node(&write, atomic_load_explicit(&tree->root, memory_order_relaxed), toRemove);
+    if(write.removed && !write.error){
+        //the element removed is retired with its data
+        write.retired[write.nbretired].ptr = write.removed->data;
+        write.retired[write.nbretired++].doFree = free;
+        write.retired[write.nbretired].ptr = write.removed;
+        write.retired[write.nbretired++].doFree = free;
+    }
+    if(write.removed || write.error)
+        ret = publish_concurrent_AVL(&write, slot, root);
+    if(!ret)
+        ret = (write.removed ? 1 : 0);
+    if(ret > 0)
+        meta->nbelements--;
+
+    exit_epochs(&tree->epochs, slot);
+    mtx_unlock(&tree->writer);
+
+    return ret;
+}
+
+/**
+ * @brief Take a snapshot of a concurrent AVL
+ * @note The snapshot is immutable, and can be browsed with any read-only AVL function
+ *       (search_AVL(), foreachAVL(), ...) until exit_concurrent_AVL() is called
+ *
+ * @param meta  Metadata of the AVL
+ * @param slot  Slot of the thread
+ * @return      Root of the snapshot
+ * @retval NULL Empty AVL or error
+ */
+dyndata_t* enter_concurrent_AVL(meta_t* meta, int slot){
+    concurrentavl_t* tree = NULL;
+
+    if(!meta || !meta->structure || slot < 0)
+        return NULL;
+
+    tree = meta->structure;
+    enter_epochs(&tree->epochs, slot);
+
+    return atomic_load_explicit(&tree->root, memory_order_acquire);
+}
+
+/**
+ * @brief Release a snapshot of a concurrent AVL
+ *
+ * @param meta  Metadata of the AVL
+ * @param slot  Slot of the thread
+ */
+void exit_concurrent_AVL(meta_t* meta, int slot){
+    if(meta && meta->structure && slot >= 0)
+        exit_epochs(&((concurrentavl_t*)meta->structure)->epochs, slot);
+}
+
+/**
+ * @brief Search an element in a concurrent AVL
+ *
+ * @param meta  Metadata of the AVL
+ * @param slot  Slot of the thread
+ * @param key   Key to search
+ * @param found Buffer in which copy the element found (can be NULL)
+ * @retval  1 Found
+ * @retval  0 Not found
+ * @retval -1 Error
+ */
+int search_concurrent_AVL(meta_t* meta, int slot, const void* key, void* found){
+    dyndata_t* root = NULL;
+    void* data = NULL;
+
+    if(!meta || !meta->structure || !key || slot < 0)
+        return -1;
+
+    root = enter_concurrent_AVL(meta, slot);
+    data = search_AVL(meta, root, (void*)key);
+    if(data && found)
+        memcpy(found, data, meta->elementsize);
+    exit_concurrent_AVL(meta, slot);
+
+    return (data != NULL);
+}
+
+/**
+ * @brief Get the number of elements in the last version of a concurrent AVL
+ *
+ * @param meta  Metadata of the AVL
+ * @param slot  Slot of the thread
+ * @return      Number of elements
+ */
+uint32_t get_concurrent_AVL_count(meta_t* meta, int slot){
+    dyndata_t* root = NULL;
+    uint32_t count = 0;
+
+    if(!meta || !meta->structure || slot < 0)
+        return 0;
+
+    root = enter_concurrent_AVL(meta, slot);
+    count = (root ? root->count : 0);
+    exit_concurrent_AVL(meta, slot);
+
+    return count;
+}
+
+/**
+ * @brief Perform an action on every element of a snapshot of a concurrent AVL
+ * @note Modifications published during the browsing are not visible
+ *
+ * @param meta      Metadata of the AVL
+ * @param slot      Slot of the thread
+ * @param parameter Parameter for the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int foreachConcurrentAVL(meta_t* meta, int slot, void* parameter, int (*doAction)(void*, void*)){
+    dyndata_t* root = NULL;
+    int ret = 0;
+
+    if(!meta || !meta->structure || slot < 0)
+        return -1;
+
+    if(!doAction)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachConcurrentAVL: action to perform not defined");
+
+        return -1;
+    }
+
+    root = enter_concurrent_AVL(meta, slot);
+    ret = foreachAVL(meta, root, parameter, doAction);
+    exit_concurrent_AVL(meta, slot);
+
+    return ret;
+}
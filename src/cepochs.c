@@ -0,0 +1,209 @@
+/**
+ * @file cepochs.c
+ * @brief Implement epoch-based memory reclamation for the lock-free structures
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note Threads register once in a domain, then wrap every access to shared memory
+ *       between enter_epochs() and exit_epochs(). Memory unlinked from a structure is
+ *       retired instead of being freed, and is only freed once every thread has left
+ *       the critical sections which could still read it.
+ */
+#include "cepochs.h"
+#include <stdlib.h>
+#include <string.h>
+
+//epochs internal functions
+static void flush_limbo(epochslot_t* slot, uint8_t i);
+static void advance_epochs(epochs_t* epochs, uint64_t epoch);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Initialise an epoch domain
+ *
+ * @param epochs Domain to initialise
+ */
+void initialise_epochs(epochs_t* epochs){
+    memset(epochs, 0, sizeof(epochs_t));
+
+    atomic_init(&epochs->global, 0);
+    for(uint32_t i = 0 ; i < EPOCH_MAX_THREADS ; i++)
+    {
+        atomic_init(&epochs->slots[i].local, 0);
+        atomic_init(&epochs->slots[i].used, false);
+    }
+}
+
+/**
+ * @brief Free all the memory still retired in an epoch domain
+ * @warning No thread may use the domain anymore
+ *
+ * @param epochs Domain to free
+ */
+void free_epochs(epochs_t* epochs){
+    for(uint32_t i = 0 ; i < EPOCH_MAX_THREADS ; i++)
+    {
+        for(uint8_t j = 0 ; j < 3 ; j++)
+        {
+            flush_limbo(&epochs->slots[i], j);
+            free(epochs->slots[i].limbo[j]);
+            epochs->slots[i].limbo[j] = NULL;
+            epochs->slots[i].sizelimbo[j] = 0;
+        }
+    }
+}
+
+/**
+ * @brief Register the calling thread in an epoch domain
+ *
+ * @param epochs    Domain in which register
+ * @return          Slot to use in all the subsequent calls of the thread
+ * @retval -1       Too many threads registered
+ */
+int register_epochs(epochs_t* epochs){
+    bool expected = false;
+
+    for(uint32_t i = 0 ; i < EPOCH_MAX_THREADS ; i++)
+    {
+        expected = false;
+        if(atomic_compare_exchange_strong(&epochs->slots[i].used, &expected, true))
+            return (int)i;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Unregister a thread from an epoch domain
+ * @note Memory retired by the thread is kept until the slot is reused or the domain freed
+ *
+ * @param epochs    Domain from which unregister
+ * @param slot      Slot of the thread
+ */
+void unregister_epochs(epochs_t* epochs, int slot){
+    atomic_store(&epochs->slots[slot].local, 0);
+    atomic_store(&epochs->slots[slot].used, false);
+}
+
+/**
+ * @brief Enter a critical section, in which shared memory can be read safely
+ *
+ * @param epochs    Domain of the structure read
+ * @param slot      Slot of the thread
+ */
+void enter_epochs(epochs_t* epochs, int slot){
+    epochslot_t* current = &epochs->slots[slot];
+    uint64_t epoch = 0;
+
+    //publish the epoch observed, making sure it did not move in the meantime
+    do{
+        epoch = atomic_load(&epochs->global);
+        atomic_store(&current->local, (epoch << 1) | 1U);
+    }while(atomic_load(&epochs->global) != epoch);
+
+    //free the memory no thread can read anymore
+    for(uint8_t i = 0 ; i < 3 ; i++)
+    {
+        if(current->nblimbo[i] && current->limboepoch[i] + 2 <= epoch)
+            flush_limbo(current, i);
+    }
+}
+
+/**
+ * @brief Leave a critical section
+ *
+ * @param epochs    Domain of the structure read
+ * @param slot      Slot of the thread
+ */
+void exit_epochs(epochs_t* epochs, int slot){
+    atomic_store_explicit(&epochs->slots[slot].local, 0, memory_order_release);
+}
+
+/**
+ * @brief Retire memory unlinked from a shared structure
+ * @note Must be called within a critical section
+ *
+ * @param epochs    Domain of the structure
+ * @param slot      Slot of the thread
+ * @param ptr       Memory to free once no thread can read it anymore
+ * @param doFree    Method used to free the memory
+ * @retval  0 OK
+ * @retval -1 Error (the memory is leaked)
+ */
+int retire_epochs(epochs_t* epochs, int slot, void* ptr, void (*doFree)(void*)){
+    epochslot_t* current = &epochs->slots[slot];
+    retired_t* tmp = NULL;
+    uint64_t epoch = 0;
+    uint32_t size = 0;
+    uint8_t i = 0;
+
+    //tag the memory with the global epoch, as the thread's own epoch may lag one behind
+    //  and a thread which entered in the meantime could still read it
+    epoch = atomic_load(&epochs->global);
+    i = epoch % 3;
+
+    //the limbo list was filled at least three epochs ago, so it can be freed
+    if(current->limboepoch[i] != epoch)
+    {
+        flush_limbo(current, i);
+        current->limboepoch[i] = epoch;
+    }
+
+    //grow the limbo list if full
+    if(current->nblimbo[i] == current->sizelimbo[i])
+    {
+        size = (current->sizelimbo[i] ? current->sizelimbo[i] * 2U : EPOCH_ADVANCE_PERIOD);
+        tmp = realloc(current->limbo[i], size * sizeof(retired_t));
+        if(!tmp)
+            return -1;
+
+        current->limbo[i] = tmp;
+        current->sizelimbo[i] = size;
+    }
+
+    current->limbo[i][current->nblimbo[i]].ptr = ptr;
+    current->limbo[i][current->nblimbo[i]].doFree = doFree;
+    current->nblimbo[i]++;
+
+    //regularly try to move the epoch forward
+    if(!(current->nblimbo[i] % EPOCH_ADVANCE_PERIOD))
+        advance_epochs(epochs, epoch);
+
+    return 0;
+}
+
+/**
+ * @brief Free all the memory in a limbo list
+ *
+ * @param slot  Slot owning the list
+ * @param i     Index of the list
+ */
+static void flush_limbo(epochslot_t* slot, uint8_t i){
+    for(uint32_t j = 0 ; j < slot->nblimbo[i] ; j++)
+        (*slot->limbo[i][j].doFree)(slot->limbo[i][j].ptr);
+
+    slot->nblimbo[i] = 0;
+}
+
+/**
+ * @brief Move the global epoch forward if every thread in a critical section observed it
+ *
+ * @param epochs    Domain of which move the epoch
+ * @param epoch     Current global epoch
+ */
+static void advance_epochs(epochs_t* epochs, uint64_t epoch){
+    uint_fast64_t local = 0, expected = epoch;
+
+    for(uint32_t i = 0 ; i < EPOCH_MAX_THREADS ; i++)
+    {
+        local = atomic_load(&epochs->slots[i].local);
+        if((local & 1U) && (local >> 1) != epoch)
+            return;
+    }
+
+    atomic_compare_exchange_strong(&epochs->global, &expected, epoch + 1);
+}
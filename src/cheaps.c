@@ -0,0 +1,779 @@
+/**
+ * @file cheaps.c
+ * @brief Implement priority queues stored as array-backed d-ary heaps
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note Pushing and popping cost O(log n) comparisons instead of the O(n) scan
+ *       of pushPriorityQueue(). A higher arity makes the heap shallower, so pushes
+ *       get cheaper and the children compared when popping share cache lines.
+ *       Elements are moved into a hole instead of being swapped when sifting.
+ *       Indexed heaps only move handles, so the position of an element is known
+ *       and it can be updated or removed in O(log n) as well.
+ */
+#include "cheaps.h"
+#include <stdlib.h>
+#include <string.h>
+
+//heaps internal functions
+static uint8_t* get_heapelem(const heap_t* heap, uint32_t i);
+static int reserve_heap(meta_t* meta, heap_t* heap, uint32_t nb);
+static void sift_heap_up(meta_t* meta, heap_t* heap, uint32_t i);
+static void sift_heap_down(meta_t* meta, heap_t* heap, uint32_t i);
+
+//indexed heaps internal functions
+static uint8_t* get_indexed_heapelem(const indexedheap_t* heap, uint32_t handle);
+static int is_indexed_heap_handle(const meta_t* meta, const indexedheap_t* heap, uint32_t handle);
+static void set_indexed_heap_position(indexedheap_t* heap, uint32_t handle, uint32_t i);
+static int reserve_indexed_heap(meta_t* meta, indexedheap_t* heap, uint32_t nb);
+static void sift_indexed_heap_up(meta_t* meta, indexedheap_t* heap, uint32_t i);
+static void sift_indexed_heap_down(meta_t* meta, indexedheap_t* heap, uint32_t i);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Allocate the array of a heap
+ * @note The structure must have been initialised with initialise_structure() beforehand
+ *
+ * @param meta      Metadata of the heap
+ * @param capacity  Number of elements to reserve (the array grows on demand)
+ * @param arity     Number of children per node (2 to HEAP_MAX_ARITY, HEAP_DEFAULT_ARITY if 0)
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_heap(meta_t* meta, uint32_t capacity, uint32_t arity){
+    heap_t* heap = NULL;
+
+    if(!meta || !meta->elementsize)
+        return -1;
+
+    if(arity == 1 || arity > HEAP_MAX_ARITY)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_heap: arity %u not supported", arity);
+
+        return -1;
+    }
+
+    heap = calloc(1, sizeof(heap_t));
+    if(!heap)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_heap: heap could not be allocated");
+
+        return -1;
+    }
+
+    heap->arity = (arity ? arity : HEAP_DEFAULT_ARITY);
+    heap->stride = (meta->elementsize + HEAP_ALIGNMENT - 1) & ~(HEAP_ALIGNMENT - 1);
+    heap->buffer = malloc(heap->stride);
+    if(!heap->buffer)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_heap: buffer could not be allocated");
+
+        free(heap);
+        return -1;
+    }
+
+    meta->structure = heap;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    if(capacity && reserve_heap(meta, heap, capacity) < 0)
+    {
+        free_heap(meta);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Free the memory of a heap and its elements
+ *
+ * @param meta Metadata of the heap
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_heap(meta_t* meta){
+    heap_t* heap = NULL;
+
+    if(!meta)
+        return -1;
+
+    heap = meta->structure;
+    if(heap)
+    {
+        free(heap->elements);
+        free(heap->buffer);
+        free(heap);
+    }
+
+    meta->structure = NULL;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Push a new element in a heap, in O(log n)
+ *
+ * @param meta  Metadata of the heap
+ * @param toAdd Element to push
+ * @retval  0 Element pushed
+ * @retval -1 Error
+ */
+int pushHeap(meta_t* meta, const void* toAdd){
+    heap_t* heap = NULL;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("pushHeap: new element cannot be NULL");
+
+        return -1;
+    }
+
+    heap = meta->structure;
+    if(reserve_heap(meta, heap, meta->nbelements + 1) < 0)
+        return -1;
+
+    //append the element, then move it up to its place
+    memcpy(get_heapelem(heap, meta->nbelements), toAdd, meta->elementsize);
+    meta->nbelements++;
+    sift_heap_up(meta, heap, meta->nbelements - 1);
+
+    return 0;
+}
+
+/**
+ * @brief Pop the element with the highest priority from a heap, in O(log n)
+ *
+ * @param meta      Metadata of the heap
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval  1 Popped
+ * @retval  0 Heap empty
+ * @retval -1 Error
+ */
+int popHeap(meta_t* meta, void* popped){
+    heap_t* heap = NULL;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!meta->nbelements)
+        return 0;
+
+    heap = meta->structure;
+    if(popped)
+        memcpy(popped, get_heapelem(heap, 0), meta->elementsize);
+
+    //move the last element at the top, then down to its place
+    meta->nbelements--;
+    if(meta->nbelements)
+    {
+        memcpy(get_heapelem(heap, 0), get_heapelem(heap, meta->nbelements), meta->elementsize);
+        sift_heap_down(meta, heap, 0);
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Add an array of elements to a heap, in O(n)
+ * @note The elements are appended as-is, then the whole heap is rebuilt bottom-up,
+ *       which is cheaper than pushing them one by one
+ *
+ * @param meta      Metadata of the heap
+ * @param elements  Array of nb elements to add
+ * @param nb        Number of elements
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int heapifyArray(meta_t* meta, const void* elements, uint32_t nb){
+    heap_t* heap = NULL;
+
+    if(!meta || !meta->structure || (nb && !elements))
+        return -1;
+
+    if(!nb)
+        return 0;
+
+    heap = meta->structure;
+    if(nb > UINT32_MAX - meta->nbelements || reserve_heap(meta, heap, meta->nbelements + nb) < 0)
+        return -1;
+
+    for(uint32_t i = 0 ; i < nb ; i++)
+        memcpy(get_heapelem(heap, meta->nbelements + i), (const uint8_t*)elements + ((size_t)i * meta->elementsize), meta->elementsize);
+    meta->nbelements += nb;
+
+    //sift down every parent, from the last one up to the root (none if a single element)
+    for(uint32_t i = (meta->nbelements + heap->arity - 2) / heap->arity ; i-- > 0 ; )
+        sift_heap_down(meta, heap, i);
+
+    return 0;
+}
+
+/**
+ * @brief Allocate the arrays of an indexed heap
+ * @note The structure must have been initialised with initialise_structure() beforehand
+ *
+ * @param meta      Metadata of the indexed heap
+ * @param capacity  Number of elements to reserve (the arrays grow on demand)
+ * @param arity     Number of children per node (2 to HEAP_MAX_ARITY, HEAP_DEFAULT_ARITY if 0)
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_indexed_heap(meta_t* meta, uint32_t capacity, uint32_t arity){
+    indexedheap_t* heap = NULL;
+
+    if(!meta || !meta->elementsize)
+        return -1;
+
+    if(arity == 1 || arity > HEAP_MAX_ARITY)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_indexed_heap: arity %u not supported", arity);
+
+        return -1;
+    }
+
+    heap = calloc(1, sizeof(indexedheap_t));
+    if(!heap)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_indexed_heap: heap could not be allocated");
+
+        return -1;
+    }
+
+    heap->arity = (arity ? arity : HEAP_DEFAULT_ARITY);
+    heap->stride = (meta->elementsize + HEAP_ALIGNMENT - 1) & ~(HEAP_ALIGNMENT - 1);
+
+    meta->structure = heap;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    if(capacity && reserve_indexed_heap(meta, heap, capacity) < 0)
+    {
+        free_indexed_heap(meta);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Free the memory of an indexed heap and its elements
+ *
+ * @param meta Metadata of the indexed heap
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_indexed_heap(meta_t* meta){
+    indexedheap_t* heap = NULL;
+
+    if(!meta)
+        return -1;
+
+    heap = meta->structure;
+    if(heap)
+    {
+        free(heap->elements);
+        free(heap->handles);
+        free(heap->positions);
+        free(heap);
+    }
+
+    meta->structure = NULL;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Push a new element in an indexed heap, in O(log n)
+ * @note The handle stays valid until the element is popped or removed, then gets reused
+ *
+ * @param meta      Metadata of the indexed heap
+ * @param toAdd     Element to push
+ * @param handle    Buffer in which store the handle of the element (can be NULL)
+ * @retval  0 Element pushed
+ * @retval -1 Error
+ */
+int pushIndexedHeap(meta_t* meta, const void* toAdd, uint32_t* handle){
+    indexedheap_t* heap = NULL;
+    uint32_t added = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("pushIndexedHeap: new element cannot be NULL");
+
+        return -1;
+    }
+
+    heap = meta->structure;
+
+    //reuse the first free handle, or allocate a new one
+    if(meta->nbelements < heap->nbhandles)
+        added = heap->handles[meta->nbelements];
+    else
+    {
+        if(reserve_indexed_heap(meta, heap, heap->nbhandles + 1) < 0)
+            return -1;
+
+        added = heap->nbhandles++;
+        set_indexed_heap_position(heap, added, meta->nbelements);
+    }
+
+    memcpy(get_indexed_heapelem(heap, added), toAdd, meta->elementsize);
+    meta->nbelements++;
+    sift_indexed_heap_up(meta, heap, meta->nbelements - 1);
+
+    if(handle)
+        *handle = added;
+
+    return 0;
+}
+
+/**
+ * @brief Pop the element with the highest priority from an indexed heap, in O(log n)
+ *
+ * @param meta      Metadata of the indexed heap
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @param handle    Buffer in which store the handle the element had (can be NULL)
+ * @retval  1 Popped
+ * @retval  0 Heap empty
+ * @retval -1 Error
+ */
+int popIndexedHeap(meta_t* meta, void* popped, uint32_t* handle){
+    indexedheap_t* heap = NULL;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!meta->nbelements)
+        return 0;
+
+    heap = meta->structure;
+    if(handle)
+        *handle = heap->handles[0];
+
+    return (removeIndexedHeap(meta, heap->handles[0], popped) < 0 ? -1 : 1);
+}
+
+/**
+ * @brief Restore the priority order after the element of a handle changed, in O(log n)
+ *
+ * @param meta      Metadata of the indexed heap
+ * @param handle    Handle of the element to update
+ * @param newValue  New value of the element (NULL if it has been modified in place)
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int updateIndexedHeap(meta_t* meta, uint32_t handle, const void* newValue){
+    indexedheap_t* heap = NULL;
+    uint32_t i = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    heap = meta->structure;
+    if(!is_indexed_heap_handle(meta, heap, handle))
+    {
+        if(meta->doPError)
+            (*meta->doPError)("updateIndexedHeap: handle %u not in the heap", handle);
+
+        return -1;
+    }
+
+    if(newValue)
+        memcpy(get_indexed_heapelem(heap, handle), newValue, meta->elementsize);
+
+    //move the element up if it got a higher priority than its parent, down otherwise
+    i = heap->positions[handle];
+    if(i && (*meta->doCompare)(get_indexed_heapelem(heap, handle), get_indexed_heapelem(heap, heap->handles[(i - 1) / heap->arity])) > 0)
+        sift_indexed_heap_up(meta, heap, i);
+    else
+        sift_indexed_heap_down(meta, heap, i);
+
+    return 0;
+}
+
+/**
+ * @brief Remove the element of a handle from an indexed heap, in O(log n)
+ *
+ * @param meta      Metadata of the indexed heap
+ * @param handle    Handle of the element to remove
+ * @param removed   Buffer in which copy the element (can be NULL)
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int removeIndexedHeap(meta_t* meta, uint32_t handle, void* removed){
+    indexedheap_t* heap = NULL;
+    uint32_t i = 0, last = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    heap = meta->structure;
+    if(!is_indexed_heap_handle(meta, heap, handle))
+    {
+        if(meta->doPError)
+            (*meta->doPError)("removeIndexedHeap: handle %u not in the heap", handle);
+
+        return -1;
+    }
+
+    if(removed)
+        memcpy(removed, get_indexed_heapelem(heap, handle), meta->elementsize);
+
+    //swap the handle with the last one of the heap, which makes it the first free one
+    i = heap->positions[handle];
+    meta->nbelements--;
+    if(i == meta->nbelements)
+        return 0;
+
+    last = heap->handles[meta->nbelements];
+    set_indexed_heap_position(heap, last, i);
+    set_indexed_heap_position(heap, handle, meta->nbelements);
+
+    return updateIndexedHeap(meta, last, NULL);
+}
+
+/**
+ * @brief Get the element with the highest priority from a heap, without popping it
+ *
+ * @param meta  Metadata of the heap
+ * @return      Element with the highest priority
+ * @retval NULL Heap empty or error
+ */
+void* peekHeap(meta_t* meta){
+    if(!meta || !meta->structure || !meta->nbelements)
+        return NULL;
+
+    return get_heapelem(meta->structure, 0);
+}
+
+/**
+ * @brief Get the element with the highest priority from an indexed heap, without popping it
+ *
+ * @param meta      Metadata of the indexed heap
+ * @param handle    Buffer in which store the handle of the element (can be NULL)
+ * @return          Element with the highest priority
+ * @retval NULL     Heap empty or error
+ */
+void* peekIndexedHeap(meta_t* meta, uint32_t* handle){
+    indexedheap_t* heap = NULL;
+
+    if(!meta || !meta->structure || !meta->nbelements)
+        return NULL;
+
+    heap = meta->structure;
+    if(handle)
+        *handle = heap->handles[0];
+
+    return get_indexed_heapelem(heap, heap->handles[0]);
+}
+
+/**
+ * @brief Get the element of a handle in an indexed heap
+ * @note The element can be modified in place, as long as updateIndexedHeap()
+ *       is called afterwards if its priority changed
+ *
+ * @param meta      Metadata of the indexed heap
+ * @param handle    Handle of the element
+ * @return          Element of the handle
+ * @retval NULL     Handle not in the heap or error
+ */
+void* get_indexed_heap_elem(meta_t* meta, uint32_t handle){
+    if(!meta || !meta->structure || !is_indexed_heap_handle(meta, meta->structure, handle))
+        return NULL;
+
+    return get_indexed_heapelem(meta->structure, handle);
+}
+
+/**
+ * @brief Perform an action on every element of a heap, in the order of the array
+ *
+ * @param meta      Metadata of the heap
+ * @param parameter Parameter used by the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 Action performed
+ * @retval -1 Error
+ */
+int foreachHeap(meta_t* meta, void* parameter, int (*doAction)(void*, void*)){
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!doAction)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachHeap: action to perform not defined");
+
+        return -1;
+    }
+
+    for(uint32_t i = 0 ; i < meta->nbelements ; i++)
+    {
+        if((*doAction)(get_heapelem(meta->structure, i), parameter) < 0)
+        {
+            if(meta->doPError)
+                (*meta->doPError)("foreachHeap: action specified returned with an error");
+
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get the address of an element in the heap array
+ *
+ * @param heap  Heap in which get the element
+ * @param i     Index of the element
+ * @return      Address of the element
+ */
+static uint8_t* get_heapelem(const heap_t* heap, uint32_t i){
+    return heap->elements + ((size_t)i * heap->stride);
+}
+
+/**
+ * @brief Make sure a heap array can hold a number of elements, doubling its capacity if needed
+ *
+ * @param meta  Metadata of the heap
+ * @param heap  Heap to grow
+ * @param nb    Number of elements to hold
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+static int reserve_heap(meta_t* meta, heap_t* heap, uint32_t nb){
+    uint8_t* elements = NULL;
+    uint32_t capacity = (heap->capacity ? heap->capacity : 1);
+
+    if(nb <= heap->capacity)
+        return 0;
+
+    while(capacity < nb)
+        capacity = (capacity > UINT32_MAX / 2 ? UINT32_MAX : capacity * 2);
+
+    elements = realloc(heap->elements, (size_t)capacity * heap->stride);
+    if(!elements)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("reserve_heap: array of %u elements could not be allocated", capacity);
+
+        return -1;
+    }
+
+    heap->elements = elements;
+    heap->capacity = capacity;
+
+    return 0;
+}
+
+/**
+ * @brief Move an element up until its parent has a higher priority
+ *
+ * @param meta  Metadata of the heap
+ * @param heap  Heap in which move the element
+ * @param i     Index of the element
+ */
+static void sift_heap_up(meta_t* meta, heap_t* heap, uint32_t i){
+    uint32_t parent = 0;
+
+    //take the element out, then move the parents with a lower priority down into the hole
+    memcpy(heap->buffer, get_heapelem(heap, i), meta->elementsize);
+    while(i){
+        parent = (i - 1) / heap->arity;
+        if((*meta->doCompare)(get_heapelem(heap, parent), heap->buffer) >= 0)
+            break;
+
+        memcpy(get_heapelem(heap, i), get_heapelem(heap, parent), meta->elementsize);
+        i = parent;
+    }
+    memcpy(get_heapelem(heap, i), heap->buffer, meta->elementsize);
+}
+
+/**
+ * @brief Move an element down until its children have a lower priority
+ *
+ * @param meta  Metadata of the heap
+ * @param heap  Heap in which move the element
+ * @param i     Index of the element
+ */
+static void sift_heap_down(meta_t* meta, heap_t* heap, uint32_t i){
+    uint32_t child = 0, best = 0, last = 0;
+
+    //take the element out, then move the child with the highest priority up into the hole
+    memcpy(heap->buffer, get_heapelem(heap, i), meta->elementsize);
+    while((uint64_t)i * heap->arity + 1 < meta->nbelements){
+        child = (i * heap->arity) + 1;
+        last = (meta->nbelements - child > heap->arity ? child + heap->arity : meta->nbelements);
+
+        best = child;
+        for(child++ ; child < last ; child++)
+        {
+            if((*meta->doCompare)(get_heapelem(heap, child), get_heapelem(heap, best)) > 0)
+                best = child;
+        }
+
+        if((*meta->doCompare)(get_heapelem(heap, best), heap->buffer) <= 0)
+            break;
+
+        memcpy(get_heapelem(heap, i), get_heapelem(heap, best), meta->elementsize);
+        i = best;
+    }
+    memcpy(get_heapelem(heap, i), heap->buffer, meta->elementsize);
+}
+
+/**
+ * @brief Get the address of the element of a handle in the indexed heap array
+ *
+ * @param heap      Indexed heap in which get the element
+ * @param handle    Handle of the element
+ * @return          Address of the element
+ */
+static uint8_t* get_indexed_heapelem(const indexedheap_t* heap, uint32_t handle){
+    return heap->elements + ((size_t)handle * heap->stride);
+}
+
+/**
+ * @brief Check whether a handle designates an element currently in an indexed heap
+ *
+ * @param meta      Metadata of the indexed heap
+ * @param heap      Indexed heap
+ * @param handle    Handle to check
+ * @retval 1 Handle in the heap
+ * @retval 0 Handle free or never allocated
+ */
+static int is_indexed_heap_handle(const meta_t* meta, const indexedheap_t* heap, uint32_t handle){
+    return (handle < heap->nbhandles && heap->positions[handle] < meta->nbelements);
+}
+
+/**
+ * @brief Place a handle at a position of the indexed heap
+ *
+ * @param heap      Indexed heap
+ * @param handle    Handle to place
+ * @param i         Position at which place the handle
+ */
+static void set_indexed_heap_position(indexedheap_t* heap, uint32_t handle, uint32_t i){
+    heap->handles[i] = handle;
+    heap->positions[handle] = i;
+}
+
+/**
+ * @brief Make sure the indexed heap arrays can hold a number of elements, doubling their capacity if needed
+ *
+ * @param meta  Metadata of the indexed heap
+ * @param heap  Indexed heap to grow
+ * @param nb    Number of elements to hold
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+static int reserve_indexed_heap(meta_t* meta, indexedheap_t* heap, uint32_t nb){
+    uint8_t* elements = NULL;
+    uint32_t* handles = NULL, *positions = NULL;
+    uint32_t capacity = (heap->capacity ? heap->capacity : 1);
+
+    if(nb <= heap->capacity)
+        return 0;
+
+    while(capacity < nb)
+        capacity = (capacity > UINT32_MAX / 2 ? UINT32_MAX : capacity * 2);
+
+    //the arrays already grown are kept if another one fails, the capacity is updated only once all succeeded
+    elements = realloc(heap->elements, (size_t)capacity * heap->stride);
+    if(elements)
+        heap->elements = elements;
+
+    handles = realloc(heap->handles, (size_t)capacity * sizeof(uint32_t));
+    if(handles)
+        heap->handles = handles;
+
+    positions = realloc(heap->positions, (size_t)capacity * sizeof(uint32_t));
+    if(positions)
+        heap->positions = positions;
+
+    if(!elements || !handles || !positions)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("reserve_indexed_heap: arrays of %u elements could not be allocated", capacity);
+
+        return -1;
+    }
+
+    heap->capacity = capacity;
+
+    return 0;
+}
+
+/**
+ * @brief Move a handle up until its parent has a higher priority
+ *
+ * @param meta  Metadata of the indexed heap
+ * @param heap  Indexed heap in which move the handle
+ * @param i     Position of the handle
+ */
+static void sift_indexed_heap_up(meta_t* meta, indexedheap_t* heap, uint32_t i){
+    uint32_t handle = heap->handles[i], parent = 0;
+    const uint8_t* element = get_indexed_heapelem(heap, handle);
+
+    //move the parents with a lower priority down into the hole
+    while(i){
+        parent = (i - 1) / heap->arity;
+        if((*meta->doCompare)(get_indexed_heapelem(heap, heap->handles[parent]), element) >= 0)
+            break;
+
+        set_indexed_heap_position(heap, heap->handles[parent], i);
+        i = parent;
+    }
+    set_indexed_heap_position(heap, handle, i);
+}
+
+/**
+ * @brief Move a handle down until its children have a lower priority
+ *
+ * @param meta  Metadata of the indexed heap
+ * @param heap  Indexed heap in which move the handle
+ * @param i     Position of the handle
+ */
+static void sift_indexed_heap_down(meta_t* meta, indexedheap_t* heap, uint32_t i){
+    uint32_t handle = heap->handles[i], child = 0, best = 0, last = 0;
+    const uint8_t* element = get_indexed_heapelem(heap, handle);
+
+    //move the child with the highest priority up into the hole
+    while((uint64_t)i * heap->arity + 1 < meta->nbelements){
+        child = (i * heap->arity) + 1;
+        last = (meta->nbelements - child > heap->arity ? child + heap->arity : meta->nbelements);
+
+        best = child;
+        for(child++ ; child < last ; child++)
+        {
+            if((*meta->doCompare)(get_indexed_heapelem(heap, heap->handles[child]), get_indexed_heapelem(heap, heap->handles[best])) > 0)
+                best = child;
+        }
+
+        if((*meta->doCompare)(get_indexed_heapelem(heap, heap->handles[best]), element) <= 0)
+            break;
+
+        set_indexed_heap_position(heap, heap->handles[best], i);
+        i = best;
+    }
+    set_indexed_heap_position(heap, handle, i);
+}
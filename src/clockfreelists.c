@@ -0,0 +1,419 @@
+/**
+ * @file clockfreelists.c
+ * @brief Implement lock-free sorted linked lists (Harris-Michael algorithm)
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note An element is removed in two steps : its link is first marked (logical removal),
+ *       then it is unchained from its predecessor (physical removal), possibly by another thread.
+ *       Unchained elements are retired in the epoch domain of the list, so that threads still
+ *       browsing them never read freed memory.
+ */
+#include "clockfreelists.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define LFLIST_MARK ((uintptr_t)1U)  ///< Bit set in the link of an element logically removed
+
+//lock-free lists internal functions
+static lfnode_t* get_lfnode(uintptr_t link);
+static int search_lockfree_list(meta_t* meta, int slot, const void* key, _Atomic(uintptr_t)** previous, lfnode_t** current);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Allocate the header of a lock-free list
+ * @note The structure must have been initialised with initialise_structure() beforehand
+ *
+ * @param meta  Metadata of the list
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_lockfree_list(meta_t* meta){
+    lflist_t* list = NULL;
+
+    if(!meta || !meta->doCompare)
+        return -1;
+
+    list = calloc(1, sizeof(lflist_t));
+    if(!list)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_lockfree_list: list could not be allocated");
+
+        return -1;
+    }
+
+    atomic_init(&list->head, 0);
+    atomic_init(&list->nbelements, 0);
+    initialise_epochs(&list->epochs);
+
+    meta->structure = list;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Free the memory of a lock-free list and its data
+ * @warning No thread may use the list anymore
+ *
+ * @param meta  Metadata of the list
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_lockfree_list(meta_t* meta){
+    lflist_t* list = NULL;
+    lfnode_t *current = NULL, *next = NULL;
+
+    if(!meta)
+        return -1;
+
+    list = meta->structure;
+    if(list)
+    {
+        next = get_lfnode(atomic_load(&list->head));
+        while(next)
+        {
+            current = next;
+            next = get_lfnode(atomic_load(&current->next));
+            free(current);
+        }
+
+        free_epochs(&list->epochs);
+        free(list);
+    }
+
+    meta->structure = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Register the calling thread as a user of a lock-free list
+ *
+ * @param meta  Metadata of the list
+ * @return      Slot to use in all the subsequent calls of the thread
+ * @retval -1   Error
+ */
+int register_lockfree_list(meta_t* meta){
+    int slot = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    slot = register_epochs(&((lflist_t*)meta->structure)->epochs);
+    if(slot < 0 && meta->doPError)
+        (*meta->doPError)("register_lockfree_list: more than %u threads registered", EPOCH_MAX_THREADS);
+
+    return slot;
+}
+
+/**
+ * @brief Unregister a thread from a lock-free list
+ *
+ * @param meta  Metadata of the list
+ * @param slot  Slot of the thread
+ */
+void unregister_lockfree_list(meta_t* meta, int slot){
+    if(meta && meta->structure && slot >= 0)
+        unregister_epochs(&((lflist_t*)meta->structure)->epochs, slot);
+}
+
+/**
+ * @brief Get the address of the element referenced by a link
+ *
+ * @param link  Link to the element (possibly marked)
+ * @return      Address of the element
+ */
+static lfnode_t* get_lfnode(uintptr_t link){
+    return (lfnode_t*)(link & ~LFLIST_MARK);
+}
+
+/**
+ * @brief Find the first element higher or equal to a key, unchaining removed elements on the way
+ * @note Must be called within a critical section
+ *
+ * @param meta      Metadata of the list
+ * @param slot      Slot of the thread
+ * @param key       Key to search
+ * @param previous  Link pointing to the element found
+ * @param current   Element found (NULL if the end of the list is reached)
+ * @retval 1 Element equal to the key found
+ * @retval 0 Key not in the list
+ */
+static int search_lockfree_list(meta_t* meta, int slot, const void* key, _Atomic(uintptr_t)** previous, lfnode_t** current){
+    lflist_t* list = meta->structure;
+    _Atomic(uintptr_t)* prev = NULL;
+    uintptr_t cur = 0, next = 0, expected = 0;
+    int cmp = 0, restart = 0;
+
+    do{
+        restart = 0;
+        prev = &list->head;
+        cur = atomic_load(prev);
+
+        while(cur && !restart)
+        {
+            next = atomic_load(&get_lfnode(cur)->next);
+
+            if(next & LFLIST_MARK)
+            {
+                //element logically removed, help unchaining it (start over if the predecessor changed)
+                expected = cur;
+                if(atomic_compare_exchange_strong(prev, &expected, next & ~LFLIST_MARK))
+                {
+                    retire_epochs(&list->epochs, slot, get_lfnode(cur), free);
+                    cur = next & ~LFLIST_MARK;
+                }
+                else
+                    restart = 1;
+            }
+            else
+            {
+                cmp = (*meta->doCompare)(get_lfnode(cur)->data, key);
+                if(cmp >= 0)
+                {
+                    *previous = prev;
+                    *current = get_lfnode(cur);
+                    return !cmp;
+                }
+
+                prev = &get_lfnode(cur)->next;
+                cur = next;
+            }
+        }
+    }while(restart);
+
+    *previous = prev;
+    *current = NULL;
+
+    return 0;
+}
+
+/**
+ * @brief Insert an element at the right place in a lock-free sorted list
+ * @note Duplicates are ignored
+ *
+ * @param meta  Metadata of the list
+ * @param slot  Slot of the thread
+ * @param toAdd Element to insert
+ * @retval  0 Added
+ * @retval  1 Already in the list
+ * @retval -1 Error
+ */
+int insertLockFreeList(meta_t* meta, int slot, const void* toAdd){
+    lflist_t* list = NULL;
+    lfnode_t *newElement = NULL, *current = NULL;
+    _Atomic(uintptr_t)* previous = NULL;
+    uintptr_t expected = 0;
+
+    if(!meta || !meta->structure || slot < 0)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("insertLockFreeList: new element cannot be NULL");
+
+        return -1;
+    }
+
+    newElement = malloc(sizeof(lfnode_t) + meta->elementsize);
+    if(!newElement)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("insertLockFreeList: new element could not be allocated");
+
+        return -1;
+    }
+    memcpy(newElement->data, toAdd, meta->elementsize);
+
+    list = meta->structure;
+    enter_epochs(&list->epochs, slot);
+
+    do{
+        //element already in the list
+        if(search_lockfree_list(meta, slot, toAdd, &previous, &current))
+        {
+            exit_epochs(&list->epochs, slot);
+            free(newElement);
+            return 1;
+        }
+
+        //chain the new element before the current one, unless the predecessor changed
+        atomic_store_explicit(&newElement->next, (uintptr_t)current, memory_order_relaxed);
+        expected = (uintptr_t)current;
+    }while(!atomic_compare_exchange_strong(previous, &expected, (uintptr_t)newElement));
+
+    exit_epochs(&list->epochs, slot);
+    atomic_fetch_add(&list->nbelements, 1);
+
+    return 0;
+}
+
+/**
+ * @brief Remove an element from a lock-free sorted list
+ *
+ * @param meta      Metadata of the list
+ * @param slot      Slot of the thread
+ * @param toRemove  Element to remove
+ * @retval  1 Removed
+ * @retval  0 Not in the list
+ * @retval -1 Error
+ */
+int removeLockFreeList(meta_t* meta, int slot, const void* toRemove){
+    lflist_t* list = NULL;
+    lfnode_t* current = NULL;
+    _Atomic(uintptr_t)* previous = NULL;
+    uintptr_t next = 0, expected = 0;
+    int marked = 0;
+
+    if(!meta || !meta->structure || !toRemove || slot < 0)
+        return -1;
+
+    list = meta->structure;
+    enter_epochs(&list->epochs, slot);
+
+    //mark the element as removed (only one thread can succeed)
+    while(!marked)
+    {
+        if(!search_lockfree_list(meta, slot, toRemove, &previous, &current))
+        {
+            exit_epochs(&list->epochs, slot);
+            return 0;
+        }
+
+        next = atomic_load(&current->next);
+        if(!(next & LFLIST_MARK))
+            marked = atomic_compare_exchange_strong(&current->next, &next, next | LFLIST_MARK);
+    }
+
+    //unchain the element, or let a search do it if the predecessor changed
+    expected = (uintptr_t)current;
+    if(atomic_compare_exchange_strong(previous, &expected, next))
+        retire_epochs(&list->epochs, slot, current, free);
+    else
+        search_lockfree_list(meta, slot, toRemove, &previous, &current);
+
+    exit_epochs(&list->epochs, slot);
+    atomic_fetch_sub(&list->nbelements, 1);
+
+    return 1;
+}
+
+/**
+ * @brief Search an element in a lock-free sorted list
+ * @note Wait-free, as the search never helps unchaining removed elements
+ *
+ * @param meta      Metadata of the list
+ * @param slot      Slot of the thread
+ * @param toSearch  Element to search
+ * @param found     Buffer in which copy the element found (can be NULL)
+ * @retval  1 Found
+ * @retval  0 Not found
+ * @retval -1 Error
+ */
+int find_lockfree_listelem(meta_t* meta, int slot, const void* toSearch, void* found){
+    lflist_t* list = NULL;
+    lfnode_t* current = NULL;
+    uintptr_t next = 0;
+    int cmp = 0, ret = 0;
+
+    if(!meta || !meta->structure || !toSearch || slot < 0)
+        return -1;
+
+    list = meta->structure;
+    enter_epochs(&list->epochs, slot);
+
+    current = get_lfnode(atomic_load(&list->head));
+    while(current)
+    {
+        next = atomic_load(&current->next);
+        cmp = (*meta->doCompare)(current->data, toSearch);
+        if(cmp >= 0)
+        {
+            //only report elements which are not being removed
+            ret = (!cmp && !(next & LFLIST_MARK));
+            if(ret && found)
+                memcpy(found, current->data, meta->elementsize);
+
+            break;
+        }
+
+        current = get_lfnode(next);
+    }
+
+    exit_epochs(&list->epochs, slot);
+
+    return ret;
+}
+
+/**
+ * @brief Get the number of elements in a lock-free list
+ *
+ * @param meta  Metadata of the list
+ * @return      Number of elements
+ */
+uint32_t get_lockfree_list_count(meta_t* meta){
+    if(!meta || !meta->structure)
+        return 0;
+
+    return (uint32_t)atomic_load(&((lflist_t*)meta->structure)->nbelements);
+}
+
+/**
+ * @brief Perform an action on every element of a lock-free list
+ * @note Elements inserted or removed during the browsing may or may not be visited
+ *
+ * @param meta      Metadata of the list
+ * @param slot      Slot of the thread
+ * @param parameter Parameter for the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int foreachLockFreeList(meta_t* meta, int slot, void* parameter, int (*doAction)(void*, void*)){
+    lflist_t* list = NULL;
+    lfnode_t* current = NULL;
+    uintptr_t next = 0;
+    int ret = 0;
+
+    if(!meta || !meta->structure || slot < 0)
+        return -1;
+
+    if(!doAction)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachLockFreeList: action to perform not defined");
+
+        return -1;
+    }
+
+    list = meta->structure;
+    enter_epochs(&list->epochs, slot);
+
+    current = get_lfnode(atomic_load(&list->head));
+    while(current && !ret)
+    {
+        next = atomic_load(&current->next);
+        if(!(next & LFLIST_MARK) && (*doAction)(current->data, parameter) < 0)
+        {
+            if(meta->doPError)
+                (*meta->doPError)("foreachLockFreeList: action specified returned with an error");
+
+            ret = -1;
+        }
+
+        current = get_lfnode(next);
+    }
+
+    exit_epochs(&list->epochs, slot);
+
+    return ret;
+}
@@ -0,0 +1,378 @@
+/**
+ * @file cmpmcqueues.c
+ * @brief Implement bounded queues shared by several producers and consumers
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note Array queue with a sequence number per slot (D. Vyukov). A producer claims a position
+ *       by incrementing the tail once the slot is free, writes the element, then publishes it
+ *       by advancing the slot sequence. Consumers do the same with the head. Threads thus
+ *       never wait on each other while the queue is neither full nor empty.
+ *       The blocking variants only fall back to a lock and conditions to sleep
+ *       when the queue is full (or empty), and are woken by the opposite operation.
+ */
+#include "cmpmcqueues.h"
+#include <stdlib.h>
+#include <string.h>
+
+//MPMC queues internal functions
+static atomic_uint* get_MPMC_slot(const mpmcqueue_t* queue, uint32_t position);
+static int push_MPMC_slot(meta_t* meta, mpmcqueue_t* queue, const void* toAdd);
+static int pop_MPMC_slot(meta_t* meta, mpmcqueue_t* queue, void* popped);
+static void wake_MPMC_queue(mpmcqueue_t* queue, atomic_uint* waiting, cnd_t* condition);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Allocate a MPMC queue
+ * @note The structure must have been initialised with initialise_structure() beforehand
+ *
+ * @param meta      Metadata of the queue
+ * @param capacity  Number of elements the queue can hold (rounded up to a power of two, 2 at least)
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_MPMC_queue(meta_t* meta, uint32_t capacity){
+    mpmcqueue_t* queue = NULL;
+
+    if(!meta || !meta->elementsize || !capacity)
+        return -1;
+
+    if(capacity > MPMC_MAX_CAPACITY)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_MPMC_queue: capacity %u too high", capacity);
+
+        return -1;
+    }
+
+    queue = aligned_alloc(MPMC_CACHELINE, sizeof(mpmcqueue_t));
+    if(!queue)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_MPMC_queue: queue could not be allocated");
+
+        return -1;
+    }
+    memset(queue, 0, sizeof(mpmcqueue_t));
+
+    //compute the size of a slot, aligned, and the capacity as a power of two
+    queue->stride = (sizeof(atomic_uint) + meta->elementsize + MPMC_ALIGNMENT - 1) & ~(MPMC_ALIGNMENT - 1);
+    queue->capacity = 2;
+    while(queue->capacity < capacity)
+        queue->capacity <<= 1;
+
+    queue->slots = malloc((size_t)queue->capacity * queue->stride);
+    if(!queue->slots)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_MPMC_queue: buffer of %u elements could not be allocated", queue->capacity);
+
+        free(queue);
+        return -1;
+    }
+
+    if(mtx_init(&queue->lock, mtx_plain) != thrd_success)
+        goto errorLock;
+    if(cnd_init(&queue->notEmpty) != thrd_success)
+        goto errorEmpty;
+    if(cnd_init(&queue->notFull) != thrd_success)
+        goto errorFull;
+
+    //each slot is ready to be written at its own position
+    for(uint32_t i = 0 ; i < queue->capacity ; i++)
+        atomic_init(get_MPMC_slot(queue, i), i);
+
+    atomic_init(&queue->pushWaiting, 0);
+    atomic_init(&queue->popWaiting, 0);
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+
+    meta->structure = queue;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+
+errorFull:
+    cnd_destroy(&queue->notEmpty);
+errorEmpty:
+    mtx_destroy(&queue->lock);
+errorLock:
+    if(meta->doPError)
+        (*meta->doPError)("initialise_MPMC_queue: lock could not be initialised");
+
+    free(queue->slots);
+    free(queue);
+    return -1;
+}
+
+/**
+ * @brief Free the memory of a MPMC queue and its elements
+ * @warning No thread may use the queue anymore
+ *
+ * @param meta Metadata of the queue
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_MPMC_queue(meta_t* meta){
+    mpmcqueue_t* queue = NULL;
+
+    if(!meta)
+        return -1;
+
+    queue = meta->structure;
+    if(queue)
+    {
+        cnd_destroy(&queue->notFull);
+        cnd_destroy(&queue->notEmpty);
+        mtx_destroy(&queue->lock);
+        free(queue->slots);
+        free(queue);
+    }
+
+    meta->structure = NULL;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Push an element at the back of a MPMC queue, without waiting
+ *
+ * @param meta  Metadata of the queue
+ * @param toAdd Element to push
+ * @retval  0 Element pushed
+ * @retval  1 Queue full
+ * @retval -1 Error
+ */
+int tryPushMPMCQueue(meta_t* meta, const void* toAdd){
+    mpmcqueue_t* queue = NULL;
+
+    if(!meta || !meta->structure || !toAdd)
+        return -1;
+
+    queue = meta->structure;
+    if(push_MPMC_slot(meta, queue, toAdd))
+        return 1;
+
+    wake_MPMC_queue(queue, &queue->popWaiting, &queue->notEmpty);
+    return 0;
+}
+
+/**
+ * @brief Pop the first element from a MPMC queue, without waiting
+ *
+ * @param meta      Metadata of the queue
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval  1 Popped
+ * @retval  0 Queue empty
+ * @retval -1 Error
+ */
+int tryPopMPMCQueue(meta_t* meta, void* popped){
+    mpmcqueue_t* queue = NULL;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    queue = meta->structure;
+    if(!pop_MPMC_slot(meta, queue, popped))
+        return 0;
+
+    wake_MPMC_queue(queue, &queue->pushWaiting, &queue->notFull);
+    return 1;
+}
+
+/**
+ * @brief Push an element at the back of a MPMC queue, sleeping while it is full
+ *
+ * @param meta  Metadata of the queue
+ * @param toAdd Element to push
+ * @retval  0 Element pushed
+ * @retval -1 Error
+ */
+int pushMPMCQueue(meta_t* meta, const void* toAdd){
+    mpmcqueue_t* queue = NULL;
+
+    if(!meta || !meta->structure || !toAdd)
+        return -1;
+
+    queue = meta->structure;
+    if(push_MPMC_slot(meta, queue, toAdd))
+    {
+        //queue full, announce the sleep before checking again, so a consumer cannot miss it
+        mtx_lock(&queue->lock);
+        atomic_fetch_add(&queue->pushWaiting, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        while(push_MPMC_slot(meta, queue, toAdd))
+            cnd_wait(&queue->notFull, &queue->lock);
+
+        atomic_fetch_sub(&queue->pushWaiting, 1);
+        mtx_unlock(&queue->lock);
+    }
+
+    wake_MPMC_queue(queue, &queue->popWaiting, &queue->notEmpty);
+    return 0;
+}
+
+/**
+ * @brief Pop the first element from a MPMC queue, sleeping while it is empty
+ *
+ * @param meta      Metadata of the queue
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval  1 Popped
+ * @retval -1 Error
+ */
+int popMPMCQueue(meta_t* meta, void* popped){
+    mpmcqueue_t* queue = NULL;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    queue = meta->structure;
+    if(!pop_MPMC_slot(meta, queue, popped))
+    {
+        //queue empty, announce the sleep before checking again, so a producer cannot miss it
+        mtx_lock(&queue->lock);
+        atomic_fetch_add(&queue->popWaiting, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        while(!pop_MPMC_slot(meta, queue, popped))
+            cnd_wait(&queue->notEmpty, &queue->lock);
+
+        atomic_fetch_sub(&queue->popWaiting, 1);
+        mtx_unlock(&queue->lock);
+    }
+
+    wake_MPMC_queue(queue, &queue->pushWaiting, &queue->notFull);
+    return 1;
+}
+
+/**
+ * @brief Get the number of elements in a MPMC queue
+ * @note The count is only a snapshot while other threads are running
+ *
+ * @param meta  Metadata of the queue
+ * @return      Number of elements in the queue (including the ones being pushed)
+ */
+uint32_t get_MPMC_queue_count(meta_t* meta){
+    mpmcqueue_t* queue = NULL;
+    uint32_t head = 0, tail = 0;
+
+    if(!meta || !meta->structure)
+        return 0;
+
+    queue = meta->structure;
+    head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+    return ((int32_t)(tail - head) > 0 ? tail - head : 0);
+}
+
+/**
+ * @brief Get the sequence number of the slot of a position (followed by its element)
+ *
+ * @param queue     Queue in which get the slot
+ * @param position  Position (not wrapped) of the element
+ * @return          Sequence number of the slot
+ */
+static atomic_uint* get_MPMC_slot(const mpmcqueue_t* queue, uint32_t position){
+    return (atomic_uint*)(queue->slots + ((size_t)(position & (queue->capacity - 1)) * queue->stride));
+}
+
+/**
+ * @brief Claim the tail position, then write and publish an element in its slot
+ *
+ * @param meta  Metadata of the queue
+ * @param queue Queue in which push the element
+ * @param toAdd Element to push
+ * @retval 0 Element pushed
+ * @retval 1 Queue full
+ */
+static int push_MPMC_slot(meta_t* meta, mpmcqueue_t* queue, const void* toAdd){
+    atomic_uint* slot = NULL;
+    uint32_t position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    int32_t diff = 0;
+
+    for(;;){
+        slot = get_MPMC_slot(queue, position);
+        diff = (int32_t)(atomic_load_explicit(slot, memory_order_acquire) - position);
+
+        //slot free at this position, try to claim it (position reloaded on failure)
+        if(!diff){
+            if(atomic_compare_exchange_weak_explicit(&queue->tail, &position, position + 1, memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        //slot still holding the element of the previous lap
+        else if(diff < 0)
+            return 1;
+        //another producer claimed the position meanwhile
+        else
+            position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    }
+
+    memcpy((uint8_t*)slot + sizeof(atomic_uint), toAdd, meta->elementsize);
+    atomic_store_explicit(slot, position + 1, memory_order_release);
+
+    return 0;
+}
+
+/**
+ * @brief Claim the head position, then read an element and free its slot for the next lap
+ *
+ * @param meta      Metadata of the queue
+ * @param queue     Queue from which pop the element
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval 1 Popped
+ * @retval 0 Queue empty
+ */
+static int pop_MPMC_slot(meta_t* meta, mpmcqueue_t* queue, void* popped){
+    atomic_uint* slot = NULL;
+    uint32_t position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    int32_t diff = 0;
+
+    for(;;){
+        slot = get_MPMC_slot(queue, position);
+        diff = (int32_t)(atomic_load_explicit(slot, memory_order_acquire) - (position + 1));
+
+        //element published at this position, try to claim it (position reloaded on failure)
+        if(!diff){
+            if(atomic_compare_exchange_weak_explicit(&queue->head, &position, position + 1, memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        //no element published yet
+        else if(diff < 0)
+            return 0;
+        //another consumer claimed the position meanwhile
+        else
+            position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    }
+
+    if(popped)
+        memcpy(popped, (uint8_t*)slot + sizeof(atomic_uint), meta->elementsize);
+    atomic_store_explicit(slot, position + queue->capacity, memory_order_release);
+
+    return 1;
+}
+
+/**
+ * @brief Wake a thread sleeping on a condition of the queue, if any
+ * @note The fence pairs with the one of the sleeping thread : either it sees
+ *       the operation just performed, or this thread sees it announced its sleep
+ *
+ * @param queue     Queue on which the threads sleep
+ * @param waiting   Number of threads sleeping on the condition
+ * @param condition Condition to signal
+ */
+static void wake_MPMC_queue(mpmcqueue_t* queue, atomic_uint* waiting, cnd_t* condition){
+    atomic_thread_fence(memory_order_seq_cst);
+    if(!atomic_load_explicit(waiting, memory_order_relaxed))
+        return;
+
+    mtx_lock(&queue->lock);
+    cnd_signal(condition);
+    mtx_unlock(&queue->lock);
+}
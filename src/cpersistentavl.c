@@ -0,0 +1,504 @@
+/**
+ * @file cpersistentavl.c
+ * @brief Implement persistent AVL trees, in which every update creates a new version
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note Nodes are never modified once built : an update rebuilds the path from the root
+ *       to the element (and the nodes rotated), and shares all the other subtrees with
+ *       the previous version. Taking a snapshot therefore costs a reference, and each
+ *       update O(log n) nodes, instead of a deep copy of the whole tree.
+ *       The current version is kept in meta->structure.
+ */
+#include "cpersistentavl.h"
+#include <stdlib.h>
+#include <string.h>
+
+//persistent AVL internal functions
+static pavlnode_t* retain_pavlnode(pavlnode_t* node);
+static int16_t get_pavl_height(pavlnode_t* node);
+static pavlnode_t* make_pavlnode(meta_t* meta, const void* data, pavlnode_t* left, pavlnode_t* right);
+static pavlnode_t* balance_pavlnode(meta_t* meta, const void* data, pavlnode_t* left, pavlnode_t* right);
+static pavlnode_t* insert_pavlnode(meta_t* meta, pavlnode_t* node, const void* toAdd, int* status);
+static pavlnode_t* remove_pavlnode(meta_t* meta, pavlnode_t* node, const void* key, int* status);
+static pavlnode_t* remove_pavlnode_min(meta_t* meta, pavlnode_t* node, pavlnode_t** min, int* status);
+static int foreach_pavlnode(meta_t* meta, pavlnode_t* node, void* parameter, int (*doAction)(void*, void*));
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Add a reference to a node
+ *
+ * @param node  Node to reference (can be NULL)
+ * @return      Node referenced
+ */
+static pavlnode_t* retain_pavlnode(pavlnode_t* node){
+    if(node)
+        atomic_fetch_add_explicit(&node->refs, 1, memory_order_relaxed);
+
+    return node;
+}
+
+/**
+ * @brief Release a version of a persistent AVL (or a reference to a node)
+ * @note The nodes which are not referenced anymore are freed with their data
+ *
+ * @param version   Version to release (can be NULL)
+ */
+void release_persistent_AVL(pavlnode_t* version){
+    if(version && atomic_fetch_sub_explicit(&version->refs, 1, memory_order_acq_rel) == 1)
+    {
+        release_persistent_AVL(version->left);
+        release_persistent_AVL(version->right);
+        free(version);
+    }
+}
+
+/**
+ * @brief Get the height of a subtree
+ *
+ * @param node  Root of the subtree
+ * @return      Height of the subtree
+ */
+static int16_t get_pavl_height(pavlnode_t* node){
+    return (node ? node->height : 0);
+}
+
+/**
+ * @brief Build a node above two subtrees
+ * @note The references to the subtrees are handed over to the new node,
+ *       and released if an error occurs
+ *
+ * @param meta  Metadata of the AVL
+ * @param data  Data to copy in the node
+ * @param left  Reference to the left subtree
+ * @param right Reference to the right subtree
+ * @return      Reference to the new node
+ * @retval NULL Error
+ */
+static pavlnode_t* make_pavlnode(meta_t* meta, const void* data, pavlnode_t* left, pavlnode_t* right){
+    pavlnode_t* node = NULL;
+    int16_t height_left = get_pavl_height(left), height_right = get_pavl_height(right);
+
+    node = malloc(sizeof(pavlnode_t) + meta->elementsize);
+    if(!node)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("make_pavlnode: node could not be allocated");
+
+        release_persistent_AVL(left);
+        release_persistent_AVL(right);
+        return NULL;
+    }
+
+    memcpy(node->data, data, meta->elementsize);
+    node->left = left;
+    node->right = right;
+    node->height = 1 + (height_left > height_right ? height_left : height_right);
+    node->count = 1 + (left ? left->count : 0) + (right ? right->count : 0);
+    atomic_init(&node->refs, 1);
+
+    return node;
+}
+
+/**
+ * @brief Build a node above two subtrees, rotating them if their heights differ by 2
+ * @note The references to the subtrees are handed over, and released if an error occurs.
+ *       The subtrees may be shared, so rotations build new nodes instead of relinking them.
+ *
+ * @param meta  Metadata of the AVL
+ * @param data  Data to copy in the node
+ * @param left  Reference to the left subtree
+ * @param right Reference to the right subtree
+ * @return      Reference to the root of the balanced subtree
+ * @retval NULL Error
+ */
+static pavlnode_t* balance_pavlnode(meta_t* meta, const void* data, pavlnode_t* left, pavlnode_t* right){
+    pavlnode_t *inner = NULL, *newLeft = NULL, *newRight = NULL, *root = NULL;
+
+    if(get_pavl_height(left) > get_pavl_height(right) + 1){
+        //left left case
+        if(get_pavl_height(left->left) >= get_pavl_height(left->right)){
+            newRight = make_pavlnode(meta, data, retain_pavlnode(left->right), right);
+            if(newRight)
+                root = make_pavlnode(meta, left->data, retain_pavlnode(left->left), newRight);
+
+            release_persistent_AVL(left);
+            return root;
+        }
+
+        //left right case
+        inner = left->right;
+        newLeft = make_pavlnode(meta, left->data, retain_pavlnode(left->left), retain_pavlnode(inner->left));
+        newRight = make_pavlnode(meta, data, retain_pavlnode(inner->right), right);
+        if(newLeft && newRight)
+            root = make_pavlnode(meta, inner->data, newLeft, newRight);
+        else{
+            release_persistent_AVL(newLeft);
+            release_persistent_AVL(newRight);
+        }
+
+        release_persistent_AVL(left);
+        return root;
+    }
+
+    if(get_pavl_height(right) > get_pavl_height(left) + 1){
+        //right right case
+        if(get_pavl_height(right->right) >= get_pavl_height(right->left)){
+            newLeft = make_pavlnode(meta, data, left, retain_pavlnode(right->left));
+            if(newLeft)
+                root = make_pavlnode(meta, right->data, newLeft, retain_pavlnode(right->right));
+
+            release_persistent_AVL(right);
+            return root;
+        }
+
+        //right left case
+        inner = right->left;
+        newLeft = make_pavlnode(meta, data, left, retain_pavlnode(inner->left));
+        newRight = make_pavlnode(meta, right->data, retain_pavlnode(inner->right), retain_pavlnode(right->right));
+        if(newLeft && newRight)
+            root = make_pavlnode(meta, inner->data, newLeft, newRight);
+        else{
+            release_persistent_AVL(newLeft);
+            release_persistent_AVL(newRight);
+        }
+
+        release_persistent_AVL(right);
+        return root;
+    }
+
+    return make_pavlnode(meta, data, left, right);
+}
+
+/**
+ * @brief Recursively build a new version of a subtree with an element inserted
+ *
+ * @param meta      Metadata of the AVL
+ * @param node      Root of the subtree
+ * @param toAdd     Element to insert
+ * @param status    Set to 1 if the element already is in the subtree, -1 if an error occurred
+ * @return          Reference to the root of the new version
+ * @retval NULL     Nothing inserted (see status)
+ */
+static pavlnode_t* insert_pavlnode(meta_t* meta, pavlnode_t* node, const void* toAdd, int* status){
+    pavlnode_t* child = NULL;
+    int cmp = 0;
+
+    //leaf reached, create the element
+    if(!node){
+        child = make_pavlnode(meta, toAdd, NULL, NULL);
+        *status = (child ? 0 : -1);
+        return child;
+    }
+
+    //ignore duplicates (forbidden in AVL trees)
+    cmp = (*meta->doCompare)(node->data, toAdd);
+    if(!cmp){
+        *status = 1;
+        return NULL;
+    }
+
+    //rebuild the node above the new version of its child, sharing the other one
+    if(cmp < 0){
+        child = insert_pavlnode(meta, node->right, toAdd, status);
+        if(!child)
+            return NULL;
+
+        child = balance_pavlnode(meta, node->data, retain_pavlnode(node->left), child);
+    }
+    else{
+        child = insert_pavlnode(meta, node->left, toAdd, status);
+        if(!child)
+            return NULL;
+
+        child = balance_pavlnode(meta, node->data, child, retain_pavlnode(node->right));
+    }
+
+    if(!child)
+        *status = -1;
+
+    return child;
+}
+
+/**
+ * @brief Recursively build a new version of a subtree with an element removed
+ *
+ * @param meta      Metadata of the AVL
+ * @param node      Root of the subtree
+ * @param key       Key of the element to remove
+ * @param status    Set to 1 if the element was removed, 0 if not found, -1 if an error occurred
+ * @return          Reference to the root of the new version (NULL if empty or nothing removed)
+ */
+static pavlnode_t* remove_pavlnode(meta_t* meta, pavlnode_t* node, const void* key, int* status){
+    pavlnode_t *child = NULL, *min = NULL;
+    int cmp = 0;
+
+    if(!node){
+        *status = 0;
+        return NULL;
+    }
+
+    cmp = (*meta->doCompare)(node->data, key);
+    if(cmp){
+        //rebuild the node above the new version of its child, sharing the other one
+        if(cmp < 0){
+            child = remove_pavlnode(meta, node->right, key, status);
+            if(*status != 1)
+                return NULL;
+
+            child = balance_pavlnode(meta, node->data, retain_pavlnode(node->left), child);
+        }
+        else{
+            child = remove_pavlnode(meta, node->left, key, status);
+            if(*status != 1)
+                return NULL;
+
+            child = balance_pavlnode(meta, node->data, child, retain_pavlnode(node->right));
+        }
+
+        if(!child)
+            *status = -1;
+
+        return child;
+    }
+
+    //less than 2 children nodes, replace the node by its child (if any)
+    *status = 1;
+    if(!node->left || !node->right)
+        return retain_pavlnode(node->left ? node->left : node->right);
+
+    //2 children nodes, take the successor out of the right subtree and put it at the place of the node
+    child = remove_pavlnode_min(meta, node->right, &min, status);
+    if(*status < 0)
+        return NULL;
+
+    child = balance_pavlnode(meta, min->data, retain_pavlnode(node->left), child);
+    if(!child)
+        *status = -1;
+
+    return child;
+}
+
+/**
+ * @brief Recursively build a new version of a subtree with its lowest element removed
+ *
+ * @param meta      Metadata of the AVL
+ * @param node      Root of the subtree
+ * @param min       Lowest element removed (still referenced by the previous version)
+ * @param status    Set to -1 if an error occurred
+ * @return          Reference to the root of the new version (NULL if empty or error)
+ */
+static pavlnode_t* remove_pavlnode_min(meta_t* meta, pavlnode_t* node, pavlnode_t** min, int* status){
+    pavlnode_t* child = NULL;
+
+    if(!node->left){
+        *min = node;
+        return retain_pavlnode(node->right);
+    }
+
+    child = remove_pavlnode_min(meta, node->left, min, status);
+    if(*status < 0)
+        return NULL;
+
+    child = balance_pavlnode(meta, node->data, child, retain_pavlnode(node->right));
+    if(!child)
+        *status = -1;
+
+    return child;
+}
+
+/**
+ * @brief Insert an element in a persistent AVL, creating a new current version
+ * @note The previous versions still referenced by snapshots are left unchanged
+ *
+ * @param meta  Metadata of the AVL
+ * @param toAdd Element to insert
+ * @retval  0 Added
+ * @retval  1 Already in the AVL
+ * @retval -1 Error
+ */
+int insertPersistentAVL(meta_t* meta, const void* toAdd){
+    pavlnode_t* version = NULL;
+    int status = 0;
+
+    if(!meta || !meta->elementsize)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("insertPersistentAVL: new element cannot be NULL");
+
+        return -1;
+    }
+
+    //empty AVL
+    if(!meta->structure)
+        meta->nbelements = 0;
+
+    version = insert_pavlnode(meta, meta->structure, toAdd, &status);
+    if(!version)
+        return status;
+
+    release_persistent_AVL(meta->structure);
+    meta->structure = version;
+    meta->nbelements++;
+
+    return 0;
+}
+
+/**
+ * @brief Remove an element from a persistent AVL, creating a new current version
+ * @note The previous versions still referenced by snapshots are left unchanged
+ *
+ * @param meta      Metadata of the AVL
+ * @param toRemove  Key of the element to remove
+ * @retval  1 Removed
+ * @retval  0 Not in the AVL
+ * @retval -1 Error
+ */
+int removePersistentAVL(meta_t* meta, const void* toRemove){
+    pavlnode_t* version = NULL;
+    int status = 0;
+
+    if(!meta || !toRemove)
+        return -1;
+
+    version = remove_pavlnode(meta, meta->structure, toRemove, &status);
+    if(status != 1)
+        return status;
+
+    release_persistent_AVL(meta->structure);
+    meta->structure = version;
+    meta->nbelements--;
+
+    return 1;
+}
+
+/**
+ * @brief Release the current version of a persistent AVL
+ * @note The nodes still referenced by snapshots are only freed once they are released
+ *
+ * @param meta  Metadata of the AVL
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_persistent_AVL(meta_t* meta){
+    if(!meta)
+        return -1;
+
+    release_persistent_AVL(meta->structure);
+    meta->structure = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Take a snapshot of the current version of a persistent AVL, in O(1)
+ * @note The snapshot must be released with release_persistent_AVL()
+ *
+ * @param meta  Metadata of the AVL
+ * @return      Version snapshot
+ * @retval NULL Empty AVL
+ */
+pavlnode_t* snapshot_persistent_AVL(meta_t* meta){
+    if(!meta)
+        return NULL;
+
+    return retain_pavlnode(meta->structure);
+}
+
+/**
+ * @brief Search for a key in a version of a persistent AVL
+ *
+ * @param meta      Metadata of the AVL
+ * @param version   Version in which search (meta->structure for the current one)
+ * @param key       Key to search
+ * @return          Data of the element found (valid as long as the version is referenced)
+ * @retval NULL     Key not found
+ */
+void* search_persistent_AVL(meta_t* meta, pavlnode_t* version, const void* key){
+    pavlnode_t* current = version;
+    int cmp = 0;
+
+    if(!meta || !key)
+        return NULL;
+
+    while(current){
+        cmp = (*meta->doCompare)(current->data, key);
+        if(!cmp)
+            return current->data;
+
+        current = (cmp < 0 ? current->right : current->left);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Get the number of elements in a version of a persistent AVL
+ *
+ * @param version   Version of which get the size
+ * @return          Number of elements
+ */
+uint32_t get_persistent_AVL_count(pavlnode_t* version){
+    return (version ? version->count : 0);
+}
+
+/**
+ * @brief Recursively perform an action on every element of a subtree, in ascending order
+ *
+ * @param meta      Metadata of the AVL
+ * @param node      Root of the subtree
+ * @param parameter Parameter for the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+static int foreach_pavlnode(meta_t* meta, pavlnode_t* node, void* parameter, int (*doAction)(void*, void*)){
+    if(!node)
+        return 0;
+
+    if(foreach_pavlnode(meta, node->left, parameter, doAction) < 0 || (*doAction)(node->data, parameter) < 0)
+        return -1;
+
+    return foreach_pavlnode(meta, node->right, parameter, doAction);
+}
+
+/**
+ * @brief Perform an action on every element of a version of a persistent AVL
+ *
+ * @param meta      Metadata of the AVL
+ * @param version   Version to browse (meta->structure for the current one)
+ * @param parameter Parameter for the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int foreachPersistentAVL(meta_t* meta, pavlnode_t* version, void* parameter, int (*doAction)(void*, void*)){
+    if(!meta)
+        return -1;
+
+    if(!doAction)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachPersistentAVL: action to perform not defined");
+
+        return -1;
+    }
+
+    if(foreach_pavlnode(meta, version, parameter, doAction) < 0)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachPersistentAVL: action specified returned with an error");
+
+        return -1;
+    }
+
+    return 0;
+}
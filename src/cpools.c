@@ -0,0 +1,571 @@
+/**
+ * @file cpools.c
+ * @brief Implement compact lists, queues and stacks stored in a contiguous pool
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note Elements are linked with 32-bit indices instead of pointers,
+ *       and their payload is stored right after their links.
+ *       This costs 8 bytes per element instead of a dyndata_t and two allocations.
+ */
+#include "cpools.h"
+#include <stdlib.h>
+#include <string.h>
+
+//pools internal functions
+static poolnode_t* get_poolnode(const pool_t* pool, uint32_t i);
+static void* get_pooldata(poolnode_t* node);
+static uint8_t* grow_pool(meta_t* meta, const pool_t* pool, uint32_t* capacity);
+static uint32_t allocate_poolnode(meta_t* meta, pool_t* pool, const void* elem);
+static void release_poolnode(pool_t* pool, uint32_t i);
+static void link_poolnode(pool_t* pool, uint32_t i, uint32_t next);
+static int unlink_poolnode(meta_t* meta, uint32_t i, void* popped);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Allocate the pool of a structure
+ * @note The structure must have been initialised with initialise_structure() beforehand
+ *
+ * @param meta      Metadata of the structure
+ * @param capacity  Number of elements to reserve (the pool grows on demand)
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_pool(meta_t* meta, uint32_t capacity){
+    pool_t* pool = NULL;
+
+    if(!meta || !meta->elementsize)
+        return -1;
+
+    if(capacity >= POOL_NONE)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_pool: capacity %u too high", capacity);
+
+        return -1;
+    }
+
+    pool = calloc(1, sizeof(pool_t));
+    if(!pool)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_pool: pool could not be allocated");
+
+        return -1;
+    }
+
+    //compute the size of an element, with its payload aligned
+    pool->stride = sizeof(poolnode_t) + meta->elementsize;
+    pool->stride = (pool->stride + POOL_ALIGNMENT - 1) & ~(POOL_ALIGNMENT - 1);
+
+    //allocate the block of elements
+    if(capacity)
+    {
+        pool->nodes = malloc((size_t)capacity * pool->stride);
+        if(!pool->nodes)
+        {
+            if(meta->doPError)
+                (*meta->doPError)("initialise_pool: block of %u elements could not be allocated", capacity);
+
+            free(pool);
+            return -1;
+        }
+    }
+
+    pool->capacity = capacity;
+    pool->head = POOL_NONE;
+    pool->tail = POOL_NONE;
+    pool->freelist = POOL_NONE;
+
+    meta->structure = pool;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Free the memory of a pool and its data
+ *
+ * @param meta Metadata of the structure
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_pool(meta_t* meta){
+    pool_t* pool = NULL;
+
+    if(!meta)
+        return -1;
+
+    pool = meta->structure;
+    if(pool)
+    {
+        free(pool->nodes);
+        free(pool);
+    }
+
+    meta->structure = NULL;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Get the address of an element in the pool
+ *
+ * @param pool  Pool in which get the element
+ * @param i     Index of the element
+ * @return      Links of the element
+ */
+static poolnode_t* get_poolnode(const pool_t* pool, uint32_t i){
+    return (poolnode_t*)(pool->nodes + ((size_t)i * pool->stride));
+}
+
+/**
+ * @brief Get the payload of an element in the pool
+ *
+ * @param node  Element of which get the payload
+ * @return      Address of the payload
+ */
+static void* get_pooldata(poolnode_t* node){
+    return (uint8_t*)node + sizeof(poolnode_t);
+}
+
+/**
+ * @brief Reallocate the block of a pool with twice its capacity
+ * @note As elements are linked with indices, moving the block is harmless.
+ *       The caller stores the block and capacity returned in the pool.
+ *
+ * @param meta      Metadata of the structure
+ * @param pool      Pool to grow
+ * @param capacity  Buffer in which store the new capacity
+ * @return          Block grown
+ * @retval NULL     Error (the former block is left untouched)
+ */
+static uint8_t* grow_pool(meta_t* meta, const pool_t* pool, uint32_t* capacity){
+    uint8_t* tmp = NULL;
+
+    *capacity = (pool->capacity ? pool->capacity : 1U);
+    *capacity = (*capacity < POOL_NONE / 2U ? *capacity * 2U : POOL_NONE - 1U);
+    if(*capacity == pool->capacity)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("grow_pool: pool is full");
+
+        return NULL;
+    }
+
+    tmp = realloc(pool->nodes, (size_t)*capacity * pool->stride);
+    if(!tmp)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("grow_pool: block could not be grown to %u elements", *capacity);
+    }
+
+    return tmp;
+}
+
+/**
+ * @brief Take an element from the pool (growing it if full) and copy data in it
+ *
+ * @param meta  Metadata of the structure
+ * @param pool  Pool from which take the element
+ * @param elem  Data to copy in the new element
+ * @return      Index of the new element
+ * @retval POOL_NONE Error
+ */
+static uint32_t allocate_poolnode(meta_t* meta, pool_t* pool, const void* elem){
+    poolnode_t* node = NULL;
+    uint8_t* nodes = NULL;
+    uint32_t i = 0, capacity = 0;
+
+    if(pool->freelist != POOL_NONE)
+    {
+        //reuse the last element released
+        i = pool->freelist;
+        pool->freelist = get_poolnode(pool, i)->right;
+    }
+    else
+    {
+        //block full, double its capacity
+        if(pool->used == pool->capacity)
+        {
+            nodes = grow_pool(meta, pool, &capacity);
+            if(!nodes)
+                return POOL_NONE;
+
+            pool->nodes = nodes;
+            pool->capacity = capacity;
+        }
+
+        i = pool->used++;
+    }
+
+    //set the links and copy the payload
+    node = get_poolnode(pool, i);
+    node->left = POOL_NONE;
+    node->right = POOL_NONE;
+    memcpy(get_pooldata(node), elem, meta->elementsize);
+
+    return i;
+}
+
+/**
+ * @brief Give an element back to the pool
+ *
+ * @param pool  Pool to which give the element
+ * @param i     Index of the element
+ */
+static void release_poolnode(pool_t* pool, uint32_t i){
+    get_poolnode(pool, i)->right = pool->freelist;
+    pool->freelist = i;
+}
+
+/**
+ * @brief Chain an element of the pool before another one in the pool list
+ *
+ * @param pool  Pool holding the list
+ * @param i     Index of the element to chain
+ * @param next  Index of the element before which chain it (POOL_NONE to chain it at the bottom)
+ */
+static void link_poolnode(pool_t* pool, uint32_t i, uint32_t next){
+    poolnode_t* node = get_poolnode(pool, i);
+
+    node->right = next;
+    node->left = (next != POOL_NONE ? get_poolnode(pool, next)->left : pool->tail);
+
+    //rechain the neighbours, or the ends of the list
+    if(node->left != POOL_NONE)
+        get_poolnode(pool, node->left)->right = i;
+    else
+        pool->head = i;
+
+    if(next != POOL_NONE)
+        get_poolnode(pool, next)->left = i;
+    else
+        pool->tail = i;
+}
+
+/**
+ * @brief Insert an element at the top of a pool list
+ *
+ * @param meta  Metadata of the structure
+ * @param toAdd Element to insert
+ * @retval  0 Added
+ * @retval -1 Error
+ */
+int insertPoolTop(meta_t* meta, const void* toAdd){
+    pool_t* pool = NULL;
+    uint32_t i = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("insertPoolTop: new element cannot be NULL");
+
+        return -1;
+    }
+
+    pool = meta->structure;
+    i = allocate_poolnode(meta, pool, toAdd);
+    if(i == POOL_NONE)
+        return -1;
+
+    //chain the element before the head
+    link_poolnode(pool, i, pool->head);
+    meta->nbelements++;
+
+    return 0;
+}
+
+/**
+ * @brief Insert an element at the bottom of a pool list
+ *
+ * @param meta  Metadata of the structure
+ * @param toAdd Element to insert
+ * @retval  0 Added
+ * @retval -1 Error
+ */
+int insertPoolBottom(meta_t* meta, const void* toAdd){
+    pool_t* pool = NULL;
+    uint32_t i = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("insertPoolBottom: new element cannot be NULL");
+
+        return -1;
+    }
+
+    pool = meta->structure;
+    i = allocate_poolnode(meta, pool, toAdd);
+    if(i == POOL_NONE)
+        return -1;
+
+    //chain the element after the tail
+    link_poolnode(pool, i, POOL_NONE);
+    meta->nbelements++;
+
+    return 0;
+}
+
+/**
+ * @brief Insert an element at the right place in a sorted pool list
+ *
+ * @param meta  Metadata of the structure
+ * @param toAdd Element to insert
+ * @retval  0 Added
+ * @retval -1 Error
+ */
+int insertPoolSorted(meta_t* meta, const void* toAdd){
+    pool_t* pool = NULL;
+    uint32_t i = 0, current = 0;
+
+    if(!meta || !meta->structure || !meta->doCompare)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("insertPoolSorted: new element cannot be NULL");
+
+        return -1;
+    }
+
+    pool = meta->structure;
+
+    //walk through the list until the right place is found
+    current = pool->head;
+    while(current != POOL_NONE && (*meta->doCompare)(toAdd, get_pooldata(get_poolnode(pool, current))) > 0)
+        current = get_poolnode(pool, current)->right;
+
+    //allocate the element (might move the block, so get the nodes afterwards)
+    i = allocate_poolnode(meta, pool, toAdd);
+    if(i == POOL_NONE)
+        return -1;
+
+    //chain the new element before the current one (or at the bottom if none)
+    link_poolnode(pool, i, current);
+    meta->nbelements++;
+
+    return 0;
+}
+
+/**
+ * @brief Unchain an element from a pool list and give it back to the pool
+ *
+ * @param meta      Metadata of the structure
+ * @param i         Index of the element to unchain
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval  0 OK
+ */
+static int unlink_poolnode(meta_t* meta, uint32_t i, void* popped){
+    pool_t* pool = meta->structure;
+    poolnode_t* node = get_poolnode(pool, i);
+
+    if(popped)
+        memcpy(popped, get_pooldata(node), meta->elementsize);
+
+    //rechain the neighbours
+    if(node->left != POOL_NONE)
+        get_poolnode(pool, node->left)->right = node->right;
+    else
+        pool->head = node->right;
+
+    if(node->right != POOL_NONE)
+        get_poolnode(pool, node->right)->left = node->left;
+    else
+        pool->tail = node->left;
+
+    release_poolnode(pool, i);
+    meta->nbelements--;
+
+    return 0;
+}
+
+/**
+ * @brief Remove the first element of a pool list
+ *
+ * @param meta      Metadata of the structure
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval  1 Popped
+ * @retval  0 List empty
+ * @retval -1 Error
+ */
+int popPoolTop(meta_t* meta, void* popped){
+    pool_t* pool = NULL;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    pool = meta->structure;
+    if(pool->head == POOL_NONE)
+        return 0;
+
+    unlink_poolnode(meta, pool->head, popped);
+    return 1;
+}
+
+/**
+ * @brief Remove the last element of a pool list
+ *
+ * @param meta      Metadata of the structure
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval  1 Popped
+ * @retval  0 List empty
+ * @retval -1 Error
+ */
+int popPoolBottom(meta_t* meta, void* popped){
+    pool_t* pool = NULL;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    pool = meta->structure;
+    if(pool->tail == POOL_NONE)
+        return 0;
+
+    unlink_poolnode(meta, pool->tail, popped);
+    return 1;
+}
+
+/**
+ * @brief Push a new element at the back of a pool queue
+ *
+ * @param meta  Metadata of the queue
+ * @param toAdd Element to push
+ * @retval  0 Element pushed
+ * @retval -1 Error
+ */
+int pushPoolQueue(meta_t* meta, const void* toAdd){
+    return insertPoolBottom(meta, toAdd);
+}
+
+/**
+ * @brief Pop the first element from a pool queue
+ *
+ * @param meta      Metadata of the queue
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval  1 Popped
+ * @retval  0 Queue empty
+ * @retval -1 Error
+ */
+int popPoolQueue(meta_t* meta, void* popped){
+    return popPoolTop(meta, popped);
+}
+
+/**
+ * @brief Push a new element at the head of a pool stack
+ *
+ * @param meta  Metadata of the stack
+ * @param toAdd Element to push
+ * @retval  0 Element pushed
+ * @retval -1 Error
+ */
+int pushPoolStack(meta_t* meta, const void* toAdd){
+    return insertPoolTop(meta, toAdd);
+}
+
+/**
+ * @brief Pop the head from a pool stack
+ *
+ * @param meta      Metadata of the stack
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval  1 Popped
+ * @retval  0 Stack empty
+ * @retval -1 Error
+ */
+int popPoolStack(meta_t* meta, void* popped){
+    return popPoolTop(meta, popped);
+}
+
+/**
+ * @brief Get the nth element of a pool list
+ *
+ * @param meta  Metadata of the structure
+ * @param i     Index of the element to get
+ * @return Element sought after
+ * @retval NULL Not found
+ */
+void* get_poolelem(meta_t* meta, uint32_t i){
+    pool_t* pool = NULL;
+    uint32_t current = 0;
+
+    if(!meta || !meta->structure)
+        return NULL;
+
+    if(i >= meta->nbelements)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("get_poolelem: no element at index %u", i);
+
+        return NULL;
+    }
+
+    pool = meta->structure;
+
+    //last element requested
+    if(i == meta->nbelements - 1)
+        return get_pooldata(get_poolnode(pool, pool->tail));
+
+    current = pool->head;
+    while(i--)
+        current = get_poolnode(pool, current)->right;
+
+    return get_pooldata(get_poolnode(pool, current));
+}
+
+/**
+ * @brief Perform an action on every element of a pool list
+ *
+ * @param meta      Metadata of the structure
+ * @param parameter Parameter for the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int foreachPool(meta_t* meta, void* parameter, int (*doAction)(void*, void*)){
+    pool_t* pool = NULL;
+    poolnode_t* node = NULL;
+    uint32_t current = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!doAction)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachPool: action to perform not defined");
+
+        return -1;
+    }
+
+    pool = meta->structure;
+    current = pool->head;
+
+    while(current != POOL_NONE){
+        node = get_poolnode(pool, current);
+        current = node->right;
+        if((*doAction)(get_pooldata(node), parameter) < 0)
+        {
+            if(meta->doPError)
+                (*meta->doPError)("foreachPool: action specified returned with an error");
+
+            return -1;
+        }
+    }
+
+    return 0;
+}
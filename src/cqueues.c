@@ -6,6 +6,7 @@
  */
 #include "cqueues.h"
 #include <stdlib.h>
+#include <string.h>
 
 /**
  * @brief Push a new element at the back of the queue
@@ -166,6 +167,102 @@ void* popQueue(meta_t* meta){
     return tmp;
 }
 
+/**
+ * @brief Push several elements at the back of the queue, in one allocation
+ * @note The elements are allocated in a single block (see allocate_dyn_block()),
+ *       linked together, then chained to the queue at once
+ * 
+ * @param meta  Metadata used by the queue
+ * @param toAdd Array of nb elements to push, the first one being popped first
+ * @param nb    Number of elements to push
+ * @retval  0 Elements pushed
+ * @retval -1 Error (nothing pushed)
+ */
+int pushQueueBatch(meta_t* meta, const void* toAdd, uint32_t nb){
+    dyndata_t *newElements = NULL;
+
+    //check if meta data available
+    if(!meta)
+        return -1;
+
+    if(!nb)
+        return 0;
+
+    //check if elements added are available
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("pushQueueBatch: new elements cannot be NULL");
+
+        return -1;
+    }
+
+    //allocate memory for all the new elements at once
+    if((newElements = allocate_dyn_block(meta, toAdd, nb)) == NULL)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("pushQueueBatch: new elements could not be allocated");
+        return -1;
+    }
+
+    //link the new elements together
+    for(uint32_t i = 1 ; i < nb ; i++)
+    {
+        newElements[i - 1].right = &newElements[i];
+        newElements[i].left = &newElements[i - 1];
+    }
+
+    //chain them to the back of the queue, or make them the queue
+    if(meta->structure){
+        newElements[0].left = meta->last;
+        ((dyndata_t*)meta->last)->right = &newElements[0];
+    }
+    else
+        meta->structure = &newElements[0];
+
+    meta->last = &newElements[nb - 1];
+    meta->nbelements += nb;
+
+    return 0;
+}
+
+/**
+ * @brief Pop several elements from the head of the queue, copying them in an array
+ * 
+ * @param meta      Metadata used by the queue
+ * @param popped    Array in which copy the elements, in the order they are popped (can be NULL)
+ * @param nb        Maximum number of elements to pop
+ * @return          Number of elements popped
+ */
+uint32_t popQueueBatch(meta_t* meta, void* popped, uint32_t nb){
+    dyndata_t *tmp = NULL;
+    uint32_t i = 0;
+
+    //check if meta data available
+    if(!meta)
+        return 0;
+
+    //copy and free each element from the head of the queue
+    for(i = 0 ; i < nb && meta->structure ; i++)
+    {
+        tmp = meta->structure;
+        meta->structure = tmp->right;
+
+        if(popped)
+            memcpy((uint8_t*)popped + ((size_t)i * meta->elementsize), tmp->data, meta->elementsize);
+        free_dyn(&tmp);
+    }
+
+    //update the elements counter and the pointers once
+    meta->nbelements -= i;
+    if(meta->structure)
+        ((dyndata_t*)meta->structure)->left = NULL;
+    else
+        meta->last = NULL;
+
+    return i;
+}
+
 /**
  * @brief Perform an action on every element of the queue
  * 
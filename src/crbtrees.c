@@ -0,0 +1,382 @@
+/**
+ * @file crbtrees.c
+ * @brief Implement red-black trees
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note The trees are balanced more loosely than AVL trees : a node only holds its colour,
+ *       and an insertion or a deletion performs at most three rotations, the rest of the
+ *       re-balancing being recolourings. Write-heavy workloads therefore restructure
+ *       the tree less, at the cost of a slightly deeper tree (up to 2 * log2(n)).
+ */
+#include "crbtrees.h"
+#include "cavl.h"
+
+//red-black tree internal functions
+static int is_RBT_red(dyndata_t* rbt);
+static dyndata_t* rotate_RBT(dyndata_t* rbt, e_rotation side);
+static dyndata_t** get_RBT_link(dyndata_t** root, dyndata_t** path, uint8_t depth);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Insert an element in a red-black tree
+ * @note The path is kept in a stack instead of recursing, and is only browsed back up
+ *       while red nodes follow each other
+ *
+ * @param meta  Metadata necessary to the algorithm
+ * @param rbt   Red-black tree to which add the element
+ * @param toAdd Element to insert in the tree
+ * @return Root of the tree
+ * @retval NULL Failure
+ */
+dyndata_t* insertRBT(meta_t* meta, dyndata_t* rbt, void* toAdd){
+    dyndata_t *path[RBT_MAX_HEIGHT] = {0}, **link = &rbt, *node = NULL;
+    dyndata_t *parent = NULL, *grandparent = NULL, *uncle = NULL, *top = NULL;
+    uint8_t depth = 0;
+    int cmp = 0;
+
+    if(!meta)
+        return NULL;
+
+    //if tree is empty
+    if(!rbt && !meta->structure)
+        meta->nbelements = 0;
+
+    //go down to the leaf where the element belongs, saving the nodes browsed
+    while(*link){
+        cmp = (*meta->doCompare)((*link)->data, toAdd);
+
+        //ignore duplicates
+        if(!cmp)
+            return rbt;
+
+        path[depth++] = *link;
+        link = (cmp < 0 ? &(*link)->right : &(*link)->left);
+    }
+
+    //memory allocation for the new element (always red)
+    node = allocate_dyn(meta, toAdd);
+    if(!node)
+        return rbt;
+
+    node->flags |= RBT_RED;
+    *link = node;
+    meta->nbelements++;
+
+    //go back up while a red node has a red parent (the root being black, the parent has a parent)
+    while(depth > 1 && is_RBT_red(path[depth - 1])){
+        parent = path[depth - 1];
+        grandparent = path[depth - 2];
+        uncle = (grandparent->left == parent ? grandparent->right : grandparent->left);
+
+        //red uncle, push the red up to the grandparent and carry on from there
+        if(is_RBT_red(uncle)){
+            parent->flags &= ~RBT_RED;
+            uncle->flags &= ~RBT_RED;
+            grandparent->flags |= RBT_RED;
+            node = grandparent;
+            depth -= 2;
+            continue;
+        }
+
+        //black uncle, one or two rotations put the middle node on top of the other two
+        link = get_RBT_link(&rbt, path, depth - 2);
+        if(grandparent->left == parent){
+            //left right case
+            if(parent->right == node)
+                grandparent->left = rotate_RBT(parent, LEFT);
+
+            //left left case
+            top = rotate_RBT(grandparent, RIGHT);
+        }
+        else{
+            //right left case
+            if(parent->left == node)
+                grandparent->right = rotate_RBT(parent, RIGHT);
+
+            //right right case
+            top = rotate_RBT(grandparent, LEFT);
+        }
+
+        top->flags &= ~RBT_RED;
+        grandparent->flags |= RBT_RED;
+        *link = top;
+        break;
+    }
+
+    rbt->flags &= ~RBT_RED;
+    return rbt;
+}
+
+/**
+ * @brief Remove an element from the red-black tree provided
+ * @note Nodes are relinked instead of having their data copied,
+ *       so the data of the other elements never moves
+ *
+ * @param meta  Metadata necessary to the algorithm
+ * @param root  Root of the tree from which remove an element
+ * @param key   Key to remove from the tree
+ * @return Root of the tree
+ */
+dyndata_t* delete_RBT(meta_t* meta, dyndata_t* root, void* key){
+    dyndata_t *path[RBT_MAX_HEIGHT + 1] = {0}, **link = &root, **successorLink = NULL;
+    dyndata_t *node = NULL, *successor = NULL, *child = NULL, *parent = NULL, *sibling = NULL;
+    uint8_t depth = 0, nodeDepth = 0;
+    int cmp = 0, left = 0, removedRed = 0;
+
+    //go down to the key, saving the nodes browsed
+    while(*link && (cmp = (*meta->doCompare)((*link)->data, key)) != 0){
+        path[depth++] = *link;
+        link = (cmp < 0 ? &(*link)->right : &(*link)->left);
+    }
+
+    //key not found
+    if(!*link)
+        return root;
+
+    node = *link;
+    if(node->left==NULL || node->right==NULL){
+        //less than 2 children nodes, replace the node by its child (if any)
+        left = (depth && path[depth - 1]->left == node);
+        child = (node->left ? node->left : node->right);
+        removedRed = is_RBT_red(node);
+        *link = child;
+    }
+    else{
+        //2 children nodes, find the successor (most left node of the right subtree)
+        nodeDepth = depth;
+        path[depth++] = node;
+        successorLink = &node->right;
+        while((*successorLink)->left){
+            path[depth++] = *successorLink;
+            successorLink = &(*successorLink)->left;
+        }
+
+        //unchain the successor, then put it at the place of the node, with its colour
+        successor = *successorLink;
+        left = (successorLink != &node->right);
+        child = successor->right;
+        removedRed = is_RBT_red(successor);
+        *successorLink = child;
+        successor->left = node->left;
+        successor->right = node->right;
+        successor->flags = (successor->flags & ~RBT_RED) | (node->flags & RBT_RED);
+        *link = successor;
+        path[nodeDepth] = successor;
+    }
+
+    //free the memory of the node and update the elements counter
+    free_dyn(&node);
+    meta->nbelements--;
+
+    //a red node removed does not change the number of black nodes on any path
+    if(removedRed)
+        return root;
+
+    //go back up while the child lacks a black node on its paths
+    while(depth && !is_RBT_red(child)){
+        parent = path[depth - 1];
+        link = get_RBT_link(&root, path, depth - 1);
+        sibling = (left ? parent->right : parent->left);
+
+        //the sibling subtree holds at least one black node more than the child
+        if(!sibling)
+            break;
+
+        //red sibling, rotate it on top to get a black sibling
+        if(is_RBT_red(sibling)){
+            sibling->flags &= ~RBT_RED;
+            parent->flags |= RBT_RED;
+            *link = rotate_RBT(parent, (left ? LEFT : RIGHT));
+            path[depth - 1] = sibling;
+            path[depth++] = parent;
+            link = (left ? &sibling->left : &sibling->right);
+            sibling = (left ? parent->right : parent->left);
+            if(!sibling)
+                break;
+        }
+
+        //black sibling with black children, remove a black node on its side and carry on from the parent
+        if(!is_RBT_red(sibling->left) && !is_RBT_red(sibling->right)){
+            sibling->flags |= RBT_RED;
+            child = parent;
+            depth--;
+            left = (depth && path[depth - 1]->left == child);
+            continue;
+        }
+
+        //black sibling with a red child on the far side (rotated there if needed)
+        if(left && !is_RBT_red(sibling->right))
+            parent->right = sibling = rotate_RBT(sibling, RIGHT);
+        else if(!left && !is_RBT_red(sibling->left))
+            parent->left = sibling = rotate_RBT(sibling, LEFT);
+
+        //rotate the sibling on top, its far child taking the black node missing on the child side
+        sibling->flags = (sibling->flags & ~RBT_RED) | (parent->flags & RBT_RED);
+        parent->flags &= ~RBT_RED;
+        if(left && sibling->right)
+            sibling->right->flags &= ~RBT_RED;
+        else if(!left && sibling->left)
+            sibling->left->flags &= ~RBT_RED;
+
+        *link = rotate_RBT(parent, (left ? LEFT : RIGHT));
+        child = root;
+        break;
+    }
+
+    if(child)
+        child->flags &= ~RBT_RED;
+
+    return root;
+}
+
+/**
+ * @brief Remove the root from the red-black tree provided
+ *
+ * @param meta Metadata necessary to the algorithm
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int delete_RBT_root(meta_t* meta){
+    dyndata_t* tmp = meta->structure;
+
+    if(meta->structure)
+        meta->structure = delete_RBT(meta, meta->structure, tmp->data);
+
+    return 0;
+}
+
+/**
+ * @brief Remove the element matching a key from the red-black tree
+ *
+ * @param meta  Metadata necessary to the algorithm
+ * @param key   Key of the element to remove
+ * @retval  1 Removed
+ * @retval  0 Key not found
+ * @retval -1 Error
+ */
+int delete_RBT_key(meta_t* meta, const void* key){
+    uint32_t nbelements = 0;
+
+    if(!meta || !key)
+        return -1;
+
+    if(!meta->structure)
+        return 0;
+
+    nbelements = meta->nbelements;
+    meta->structure = delete_RBT(meta, meta->structure, (void*)key);
+
+    return (meta->nbelements != nbelements);
+}
+
+/**
+ * @brief Search for a key in the red-black tree
+ *
+ * @param meta  Metadata necessary to the algorithm
+ * @param rbt   Tree in which search for the key
+ * @param key   Key to search in the tree
+ * @return Element found
+ * @retval NULL Key not found
+ */
+void* search_RBT(meta_t* meta, dyndata_t* rbt, void* key){
+    int cmp = 0;
+
+    while(rbt && (cmp = (*meta->doCompare)(rbt->data, key)) != 0)
+        rbt = (cmp < 0 ? rbt->right : rbt->left);
+
+    return (rbt ? rbt->data : NULL);
+}
+
+/**
+ * @brief Perform an action on every element of the red-black tree, in ascending order
+ * @note The browsing stops as soon as the action returns something else than 0
+ *
+ * @param meta      Metadata necessary to the algorithm
+ * @param rbt       Root of the tree to which perform the action
+ * @param parameter Parameter for the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 OK
+ * @retval  1 Browsing stopped by the action
+ * @retval -1 Error
+ */
+int foreachRBT(meta_t* meta, dyndata_t* rbt, void* parameter, int (*doAction)(void*, void*)){
+    int ret = 0;
+
+    if(!rbt)
+        return 0;
+
+    //perform action on left child
+    ret = foreachRBT(meta, rbt->left, parameter, doAction);
+    if(ret)
+        return ret;
+
+    //perform action on root
+    ret = (*doAction)(rbt->data, parameter);
+    if(ret < 0)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachRBT: action specified returned with an error");
+
+        return -1;
+    }
+    if(ret)
+        return 1;
+
+    //perform action on right child
+    return foreachRBT(meta, rbt->right, parameter, doAction);
+}
+
+/**
+ * @brief Tell whether a node is red
+ *
+ * @param rbt   Node to check (NULL leaves are black)
+ * @retval 1 Red
+ * @retval 0 Black
+ */
+static int is_RBT_red(dyndata_t* rbt){
+    return (rbt && (rbt->flags & RBT_RED));
+}
+
+/**
+ * @brief Rotate a red-black subtree, without changing the colours
+ *
+ * @param rbt   Root of the subtree to rotate
+ * @param side  Side to which rotate
+ * @return New root of the subtree
+ */
+static dyndata_t* rotate_RBT(dyndata_t* rbt, e_rotation side){
+    dyndata_t* newRoot = NULL;
+
+    if(side == RIGHT){
+        newRoot = rbt->left;
+        rbt->left = newRoot->right;
+        newRoot->right = rbt;
+    }
+    else{
+        newRoot = rbt->right;
+        rbt->right = newRoot->left;
+        newRoot->left = rbt;
+    }
+
+    return newRoot;
+}
+
+/**
+ * @brief Get the link pointing to a node of a path
+ *
+ * @param root  Address of the root of the tree
+ * @param path  Nodes from the root
+ * @param depth Index of the node in the path
+ * @return Link pointing to the node
+ */
+static dyndata_t** get_RBT_link(dyndata_t** root, dyndata_t** path, uint8_t depth){
+    if(!depth)
+        return root;
+
+    return (path[depth - 1]->left == path[depth] ? &path[depth - 1]->left : &path[depth - 1]->right);
+}
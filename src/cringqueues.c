@@ -0,0 +1,281 @@
+/**
+ * @file cringqueues.c
+ * @brief Implement queues stored in a contiguous circular buffer
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note Elements are copied inline in the buffer, and popped elements are copied
+ *       in a buffer provided by the caller. Once the buffer is large enough,
+ *       pushing and popping therefore never allocate nor free any memory.
+ */
+#include "cringqueues.h"
+#include <stdlib.h>
+#include <string.h>
+
+//ring queues internal functions
+static uint8_t* get_ringslot(const ringqueue_t* ring, uint32_t index);
+static int grow_ring_queue(meta_t* meta, ringqueue_t* ring);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Allocate the circular buffer of a queue
+ * @note The structure must have been initialised with initialise_structure() beforehand
+ *
+ * @param meta      Metadata of the queue
+ * @param capacity  Number of elements to reserve (rounded up to a power of two, the buffer grows on demand)
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_ring_queue(meta_t* meta, uint32_t capacity){
+    ringqueue_t* ring = NULL;
+
+    if(!meta || !meta->elementsize)
+        return -1;
+
+    if(capacity > RING_MAX_CAPACITY)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_ring_queue: capacity %u too high", capacity);
+
+        return -1;
+    }
+
+    ring = calloc(1, sizeof(ringqueue_t));
+    if(!ring)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_ring_queue: queue could not be allocated");
+
+        return -1;
+    }
+
+    //compute the size of an element, aligned, and the capacity as a power of two
+    ring->stride = (meta->elementsize + RING_ALIGNMENT - 1) & ~(RING_ALIGNMENT - 1);
+    ring->capacity = 1;
+    while(ring->capacity < capacity)
+        ring->capacity <<= 1;
+
+    ring->elements = malloc((size_t)ring->capacity * ring->stride);
+    if(!ring->elements)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_ring_queue: buffer of %u elements could not be allocated", ring->capacity);
+
+        free(ring);
+        return -1;
+    }
+
+    meta->structure = ring;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Free the memory of a ring queue and its elements
+ *
+ * @param meta Metadata of the queue
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_ring_queue(meta_t* meta){
+    ringqueue_t* ring = NULL;
+
+    if(!meta)
+        return -1;
+
+    ring = meta->structure;
+    if(ring)
+    {
+        free(ring->elements);
+        free(ring);
+    }
+
+    meta->structure = NULL;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Push a new element at the back of a ring queue
+ *
+ * @param meta  Metadata of the queue
+ * @param toAdd Element to push
+ * @retval  0 Element pushed
+ * @retval -1 Error
+ */
+int pushRingQueue(meta_t* meta, const void* toAdd){
+    ringqueue_t* ring = NULL;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("pushRingQueue: new element cannot be NULL");
+
+        return -1;
+    }
+
+    ring = meta->structure;
+    if(ring->tail - ring->head == ring->capacity && grow_ring_queue(meta, ring) < 0)
+        return -1;
+
+    memcpy(get_ringslot(ring, ring->tail), toAdd, meta->elementsize);
+    ring->tail++;
+    meta->nbelements++;
+
+    return 0;
+}
+
+/**
+ * @brief Pop the first element from a ring queue
+ *
+ * @param meta      Metadata of the queue
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval  1 Popped
+ * @retval  0 Queue empty
+ * @retval -1 Error
+ */
+int popRingQueue(meta_t* meta, void* popped){
+    ringqueue_t* ring = NULL;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    ring = meta->structure;
+    if(ring->head == ring->tail)
+        return 0;
+
+    if(popped)
+        memcpy(popped, get_ringslot(ring, ring->head), meta->elementsize);
+
+    ring->head++;
+    meta->nbelements--;
+
+    return 1;
+}
+
+/**
+ * @brief Get the nth element of a ring queue, from its head
+ *
+ * @param meta  Metadata of the queue
+ * @param i     Index of the element to get
+ * @return Element sought after
+ * @retval NULL Not found
+ */
+void* get_ringelem(meta_t* meta, uint32_t i){
+    ringqueue_t* ring = NULL;
+
+    if(!meta || !meta->structure)
+        return NULL;
+
+    ring = meta->structure;
+    if(i >= ring->tail - ring->head)
+        return NULL;
+
+    return get_ringslot(ring, ring->head + i);
+}
+
+/**
+ * @brief Perform an action on every element of a ring queue, from its head
+ *
+ * @param meta      Metadata of the queue
+ * @param parameter Parameter used by the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 Action performed
+ * @retval -1 Error
+ */
+int foreachRingQueue(meta_t* meta, void* parameter, int (*doAction)(void*, void*)){
+    ringqueue_t* ring = NULL;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!doAction)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachRingQueue: action to perform not defined");
+
+        return -1;
+    }
+
+    ring = meta->structure;
+    for(uint32_t i = ring->head ; i != ring->tail ; i++)
+    {
+        if((*doAction)(get_ringslot(ring, i), parameter) < 0)
+        {
+            if(meta->doPError)
+                (*meta->doPError)("foreachRingQueue: action specified returned with an error");
+
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get the address of the slot of an index in the buffer
+ *
+ * @param ring  Ring queue in which get the slot
+ * @param index Index (not wrapped) of the element
+ * @return      Address of the slot
+ */
+static uint8_t* get_ringslot(const ringqueue_t* ring, uint32_t index){
+    return ring->elements + ((size_t)(index & (ring->capacity - 1)) * ring->stride);
+}
+
+/**
+ * @brief Double the capacity of a full ring queue
+ * @note The elements are unwrapped at the beginning of the new buffer
+ *
+ * @param meta  Metadata of the queue
+ * @param ring  Ring queue to grow
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+static int grow_ring_queue(meta_t* meta, ringqueue_t* ring){
+    uint8_t* elements = NULL;
+    uint32_t first = 0, nb = ring->tail - ring->head;
+
+    if(ring->capacity >= RING_MAX_CAPACITY)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("grow_ring_queue: capacity %u cannot be doubled", ring->capacity);
+
+        return -1;
+    }
+
+    elements = malloc((size_t)ring->capacity * 2 * ring->stride);
+    if(!elements)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("grow_ring_queue: buffer of %u elements could not be allocated", ring->capacity * 2);
+
+        return -1;
+    }
+
+    //copy the elements from the head to the end of the buffer, then the ones wrapped at its beginning
+    first = ring->capacity - (ring->head & (ring->capacity - 1));
+    if(first > nb)
+        first = nb;
+    memcpy(elements, get_ringslot(ring, ring->head), (size_t)first * ring->stride);
+    memcpy(elements + ((size_t)first * ring->stride), ring->elements, (size_t)(nb - first) * ring->stride);
+
+    free(ring->elements);
+    ring->elements = elements;
+    ring->capacity *= 2;
+    ring->head = 0;
+    ring->tail = nb;
+
+    return 0;
+}
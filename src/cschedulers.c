@@ -0,0 +1,339 @@
+/**
+ * @file cschedulers.c
+ * @brief Implement a fixed pool of worker threads balancing their tasks by work stealing
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note Each worker runs the tasks of its own deque in LIFO order, so the tasks it
+ *       spawns run on the core whose cache they share, then takes the tasks submitted
+ *       from outside, then steals the oldest tasks of the other workers.
+ *       A submitter only takes the lock if a worker is sleeping.
+ * @warning wait_scheduler() and free_scheduler() may not be called from a task
+ */
+#include "cschedulers.h"
+#include "cworkdeques.h"
+#include "cmpmcqueues.h"
+#include <stdlib.h>
+#include <string.h>
+
+//schedulers internal functions
+static int run_scheduler_worker(void* arg);
+static int find_scheduler_task(schedworker_t* worker, task_t* task);
+static int has_scheduler_tasks(scheduler_t* scheduler);
+static void wake_scheduler(scheduler_t* scheduler);
+static void stop_scheduler(scheduler_t* scheduler, uint32_t nbstarted);
+
+static _Thread_local schedworker_t* current_worker = NULL;  ///< Worker running on the current thread (NULL if none)
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Initialise a scheduler and start its worker threads
+ *
+ * @param scheduler Scheduler to initialise
+ * @param nbworkers Number of worker threads (usually the number of cores)
+ * @param doPError  Error printing method (can be NULL)
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_scheduler(scheduler_t* scheduler, uint32_t nbworkers, void (*doPError)(const char*, ...)){
+    if(!scheduler)
+        return -1;
+
+    memset(scheduler, 0, sizeof(scheduler_t));
+    scheduler->doPError = doPError;
+
+    if(!nbworkers || nbworkers > SCHEDULER_MAX_WORKERS)
+    {
+        if(doPError)
+            (*doPError)("initialise_scheduler: %u workers not supported", nbworkers);
+
+        return -1;
+    }
+
+    atomic_init(&scheduler->pending, 0);
+    atomic_init(&scheduler->sleeping, 0);
+    atomic_init(&scheduler->status, 0);
+    atomic_init(&scheduler->stop, false);
+
+    scheduler->workers = aligned_alloc(SCHEDULER_CACHELINE, nbworkers * sizeof(schedworker_t));
+    if(!scheduler->workers)
+    {
+        if(doPError)
+            (*doPError)("initialise_scheduler: workers could not be allocated");
+
+        return -1;
+    }
+
+    initialise_structure(&scheduler->inbox, sizeof(task_t), NULL, doPError);
+    if(initialise_MPMC_queue(&scheduler->inbox, SCHEDULER_INBOX_SIZE) < 0)
+    {
+        free(scheduler->workers);
+        return -1;
+    }
+
+    if(mtx_init(&scheduler->lock, mtx_plain) != thrd_success || cnd_init(&scheduler->wake) != thrd_success || cnd_init(&scheduler->idle) != thrd_success)
+    {
+        if(doPError)
+            (*doPError)("initialise_scheduler: synchronisation primitives could not be initialised");
+
+        free_MPMC_queue(&scheduler->inbox);
+        free(scheduler->workers);
+        return -1;
+    }
+
+    //create all the deques before starting any worker, as they steal from each other
+    for(uint32_t i = 0 ; i < nbworkers ; i++)
+    {
+        scheduler->workers[i].scheduler = scheduler;
+        scheduler->workers[i].index = i;
+        scheduler->workers[i].seed = (i * 2654435761U) | 1U;
+
+        initialise_structure(&scheduler->workers[i].deque, sizeof(task_t), NULL, doPError);
+        if(initialise_work_deque(&scheduler->workers[i].deque, SCHEDULER_DEQUE_SIZE) < 0)
+        {
+            scheduler->nbworkers = i;
+            stop_scheduler(scheduler, 0);
+            return -1;
+        }
+    }
+    scheduler->nbworkers = nbworkers;
+
+    for(uint32_t i = 0 ; i < nbworkers ; i++)
+    {
+        if(thrd_create(&scheduler->workers[i].thread, run_scheduler_worker, &scheduler->workers[i]) != thrd_success)
+        {
+            if(doPError)
+                (*doPError)("initialise_scheduler: worker %u could not be started", i);
+
+            stop_scheduler(scheduler, i);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Wait for the tasks submitted, then stop the workers and free a scheduler
+ *
+ * @param scheduler Scheduler to free
+ * @retval  0 OK
+ * @retval -1 Error, or a task failed since the last wait
+ */
+int free_scheduler(scheduler_t* scheduler){
+    int ret = 0;
+
+    if(!scheduler || !scheduler->workers)
+        return -1;
+
+    ret = wait_scheduler(scheduler);
+    stop_scheduler(scheduler, scheduler->nbworkers);
+
+    return ret;
+}
+
+/**
+ * @brief Submit a task to a scheduler
+ * @note From a task, the new task goes to the deque of the current worker,
+ *       otherwise it goes to the inbox (blocking while full)
+ *
+ * @param scheduler Scheduler which runs the task
+ * @param doTask    Function to run
+ * @param argument  Argument given to the function
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int submit_scheduler(scheduler_t* scheduler, int (*doTask)(void*), void* argument){
+    task_t task = {doTask, argument};
+    int ret = 0;
+
+    if(!scheduler || !scheduler->workers)
+        return -1;
+
+    if(!doTask)
+    {
+        if(scheduler->doPError)
+            (*scheduler->doPError)("submit_scheduler: task to run not defined");
+
+        return -1;
+    }
+
+    //count the task before publishing it, so the count never drops to 0 while it is queued
+    atomic_fetch_add(&scheduler->pending, 1);
+    if(current_worker && current_worker->scheduler == scheduler)
+        ret = pushWorkDeque(&current_worker->deque, &task);
+    else
+        ret = pushMPMCQueue(&scheduler->inbox, &task);
+
+    if(ret < 0)
+    {
+        atomic_fetch_sub(&scheduler->pending, 1);
+        return -1;
+    }
+
+    wake_scheduler(scheduler);
+    return 0;
+}
+
+/**
+ * @brief Wait until every task submitted to a scheduler is done, including the ones they submitted
+ *
+ * @param scheduler Scheduler to wait for
+ * @retval  0 OK
+ * @retval -1 Error, or a task failed since the last wait
+ */
+int wait_scheduler(scheduler_t* scheduler){
+    if(!scheduler || !scheduler->workers)
+        return -1;
+
+    mtx_lock(&scheduler->lock);
+    while(atomic_load(&scheduler->pending))
+        cnd_wait(&scheduler->idle, &scheduler->lock);
+    mtx_unlock(&scheduler->lock);
+
+    return atomic_exchange(&scheduler->status, 0);
+}
+
+/**
+ * @brief Run the tasks of a worker until the scheduler stops
+ *
+ * @param arg Worker to run
+ * @retval  0 OK
+ */
+static int run_scheduler_worker(void* arg){
+    schedworker_t* worker = (schedworker_t*)arg;
+    scheduler_t* scheduler = worker->scheduler;
+    task_t task = {0};
+
+    current_worker = worker;
+    while(true){
+        if(find_scheduler_task(worker, &task))
+        {
+            if((*task.doTask)(task.argument) < 0)
+                atomic_store(&scheduler->status, -1);
+
+            //the last task done wakes the waiters up
+            if(atomic_fetch_sub(&scheduler->pending, 1) == 1)
+            {
+                mtx_lock(&scheduler->lock);
+                cnd_broadcast(&scheduler->idle);
+                mtx_unlock(&scheduler->lock);
+            }
+            continue;
+        }
+
+        //declare the sleep before checking the queues again, so a submitter either sees it or its task is seen
+        mtx_lock(&scheduler->lock);
+        atomic_fetch_add(&scheduler->sleeping, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        while(!atomic_load(&scheduler->stop) && !has_scheduler_tasks(scheduler))
+            cnd_wait(&scheduler->wake, &scheduler->lock);
+        atomic_fetch_sub(&scheduler->sleeping, 1);
+        mtx_unlock(&scheduler->lock);
+
+        if(atomic_load(&scheduler->stop))
+            break;
+    }
+
+    current_worker = NULL;
+    return 0;
+}
+
+/**
+ * @brief Find the next task of a worker : its own latest one, then one from the inbox, then one stolen
+ *
+ * @param worker    Worker looking for a task
+ * @param task      Buffer in which copy the task
+ * @retval 1 Task found
+ * @retval 0 No task found
+ */
+static int find_scheduler_task(schedworker_t* worker, task_t* task){
+    scheduler_t* scheduler = worker->scheduler;
+    uint32_t victim = 0;
+
+    if(popWorkDeque(&worker->deque, task) == 1 || tryPopMPMCQueue(&scheduler->inbox, task) == 1)
+        return 1;
+
+    //start stealing from a random worker, so the thieves spread over the victims
+    worker->seed ^= worker->seed << 13;
+    worker->seed ^= worker->seed >> 17;
+    worker->seed ^= worker->seed << 5;
+    victim = worker->seed % scheduler->nbworkers;
+
+    for(uint32_t i = 0 ; i < scheduler->nbworkers ; i++)
+    {
+        if(victim != worker->index && stealWorkDeque(&scheduler->workers[victim].deque, task) == 1)
+            return 1;
+
+        victim = (victim + 1 < scheduler->nbworkers ? victim + 1 : 0);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Check whether a task is queued anywhere in a scheduler
+ *
+ * @param scheduler Scheduler to check
+ * @retval 1 Task queued
+ * @retval 0 Nothing queued
+ */
+static int has_scheduler_tasks(scheduler_t* scheduler){
+    if(get_MPMC_queue_count(&scheduler->inbox))
+        return 1;
+
+    for(uint32_t i = 0 ; i < scheduler->nbworkers ; i++)
+    {
+        if(get_work_deque_count(&scheduler->workers[i].deque))
+            return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Wake a sleeping worker up after a task got submitted
+ *
+ * @param scheduler Scheduler to wake up
+ */
+static void wake_scheduler(scheduler_t* scheduler){
+    //order the task publication before the check of the sleepers (paired with the increment in the worker)
+    atomic_thread_fence(memory_order_seq_cst);
+    if(!atomic_load(&scheduler->sleeping))
+        return;
+
+    mtx_lock(&scheduler->lock);
+    cnd_signal(&scheduler->wake);
+    mtx_unlock(&scheduler->lock);
+}
+
+/**
+ * @brief Stop the workers started, then free the deques and the synchronisation primitives of a scheduler
+ *
+ * @param scheduler Scheduler to stop
+ * @param nbstarted Number of workers started
+ */
+static void stop_scheduler(scheduler_t* scheduler, uint32_t nbstarted){
+    mtx_lock(&scheduler->lock);
+    atomic_store(&scheduler->stop, true);
+    cnd_broadcast(&scheduler->wake);
+    mtx_unlock(&scheduler->lock);
+
+    for(uint32_t i = 0 ; i < nbstarted ; i++)
+        thrd_join(scheduler->workers[i].thread, NULL);
+
+    for(uint32_t i = 0 ; i < scheduler->nbworkers ; i++)
+        free_work_deque(&scheduler->workers[i].deque);
+
+    cnd_destroy(&scheduler->idle);
+    cnd_destroy(&scheduler->wake);
+    mtx_destroy(&scheduler->lock);
+    free_MPMC_queue(&scheduler->inbox);
+    free(scheduler->workers);
+    scheduler->workers = NULL;
+    scheduler->nbworkers = 0;
+}
@@ -0,0 +1,287 @@
+/**
+ * @file csplaytrees.c
+ * @brief Implement self-adjusting (splay) trees
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note Every access brings the element reached to the root, halving the depth of the
+ *       nodes on its path. Frequently accessed keys therefore stay near the root, and
+ *       a sequence of accesses costs O(log n) amortised per access whatever their
+ *       distribution (less when a few keys get most of the accesses).
+ *       The trees are splayed top-down, so no path nor recursion is needed.
+ * @warning Searches modify the tree, they must not run concurrently with any other access
+ */
+#include "csplaytrees.h"
+
+//splay tree internal functions
+static dyndata_t* splay_tree(meta_t* meta, dyndata_t* tree, const void* key);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Insert an element in a splay tree, which becomes its root
+ *
+ * @param meta  Metadata necessary to the algorithm
+ * @param toAdd Element to insert in the tree
+ * @retval  1 Key already in the tree (brought to the root)
+ * @retval  0 Element inserted
+ * @retval -1 Error
+ */
+int insertSplay(meta_t* meta, const void* toAdd){
+    dyndata_t *root = NULL, *node = NULL;
+    int cmp = 0;
+
+    if(!meta || !toAdd)
+        return -1;
+
+    //if tree is empty
+    if(!meta->structure)
+        meta->nbelements = 0;
+
+    //bring the closest element to the root
+    root = splay_tree(meta, meta->structure, toAdd);
+    meta->structure = root;
+    if(root && !(cmp = (*meta->doCompare)(root->data, toAdd)))
+        return 1;
+
+    //memory allocation for the new element
+    node = allocate_dyn(meta, toAdd);
+    if(!node)
+        return -1;
+
+    //split the tree around the new element, which becomes the root
+    if(root){
+        if(cmp > 0){
+            node->left = root->left;
+            node->right = root;
+            root->left = NULL;
+        }
+        else{
+            node->right = root->right;
+            node->left = root;
+            root->right = NULL;
+        }
+    }
+
+    meta->structure = node;
+    meta->nbelements++;
+
+    return 0;
+}
+
+/**
+ * @brief Remove the element matching a key from the splay tree
+ *
+ * @param meta  Metadata necessary to the algorithm
+ * @param key   Key of the element to remove
+ * @retval  1 Removed
+ * @retval  0 Key not found
+ * @retval -1 Error
+ */
+int delete_Splay_key(meta_t* meta, const void* key){
+    dyndata_t *root = NULL, *newRoot = NULL;
+
+    if(!meta || !key)
+        return -1;
+
+    if(!meta->structure)
+        return 0;
+
+    //bring the element to the root
+    root = splay_tree(meta, meta->structure, key);
+    meta->structure = root;
+    if((*meta->doCompare)(root->data, key))
+        return 0;
+
+    //the greatest element of the left subtree, splayed up, has no right child left
+    if(!root->left)
+        newRoot = root->right;
+    else{
+        newRoot = splay_tree(meta, root->left, key);
+        newRoot->right = root->right;
+    }
+
+    free_dyn(&root);
+    meta->structure = newRoot;
+    meta->nbelements--;
+
+    return 1;
+}
+
+/**
+ * @brief Remove the root from the splay tree
+ *
+ * @param meta Metadata necessary to the algorithm
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int delete_Splay_root(meta_t* meta){
+    dyndata_t* tmp = NULL;
+
+    if(!meta)
+        return -1;
+
+    tmp = meta->structure;
+    if(tmp)
+        delete_Splay_key(meta, tmp->data);
+
+    return 0;
+}
+
+/**
+ * @brief Search for a key in the splay tree, and bring the element found to the root
+ * @note The last element reached is brought to the root even if the key is not found
+ *
+ * @param meta  Metadata necessary to the algorithm
+ * @param key   Key to search in the tree
+ * @return Element found
+ * @retval NULL Key not found
+ */
+void* search_Splay(meta_t* meta, const void* key){
+    dyndata_t* root = NULL;
+
+    if(!meta || !key)
+        return NULL;
+
+    root = splay_tree(meta, meta->structure, key);
+    meta->structure = root;
+
+    return (root && !(*meta->doCompare)(root->data, key) ? root->data : NULL);
+}
+
+/**
+ * @brief Perform an action on every element of the splay tree, in ascending order
+ * @note The tree is browsed by threading temporarily each node to its successor (Morris traversal),
+ *       so degenerate trees are browsed without stack nor recursion. The browsing
+ *       stops calling the action as soon as it returns something else than 0.
+ *
+ * @param meta      Metadata necessary to the algorithm
+ * @param parameter Parameter for the action to perform
+ * @param doAction  Action to perform
+ * @retval  0 OK
+ * @retval  1 Browsing stopped by the action
+ * @retval -1 Error
+ */
+int foreachSplay(meta_t* meta, void* parameter, int (*doAction)(void*, void*)){
+    dyndata_t *cur = NULL, *pred = NULL;
+    int ret = 0;
+
+    if(!meta)
+        return -1;
+
+    if(!doAction)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachSplay: action to perform not defined");
+
+        return -1;
+    }
+
+    cur = meta->structure;
+    while(cur){
+        if(cur->left){
+            //find the predecessor, and thread it to the current node on the first visit
+            pred = cur->left;
+            while(pred->right && pred->right != cur)
+                pred = pred->right;
+
+            if(!pred->right){
+                pred->right = cur;
+                cur = cur->left;
+                continue;
+            }
+
+            //second visit, the left subtree is done : remove the thread
+            pred->right = NULL;
+        }
+
+        //once stopped, keep browsing only to remove the remaining threads
+        if(!ret)
+            ret = (*doAction)(cur->data, parameter);
+
+        cur = cur->right;
+    }
+
+    if(ret < 0)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("foreachSplay: action specified returned with an error");
+
+        return -1;
+    }
+
+    return (ret ? 1 : 0);
+}
+
+/**
+ * @brief Bring the element matching a key (or the last element reached) to the root of a subtree
+ * @note Top-down splaying : the nodes browsed are hung to a left tree (lower keys)
+ *       or a right tree (greater keys) on the way down, zig-zig steps being rotated first.
+ *       Both trees then become the children of the element reached.
+ *
+ * @param meta  Metadata necessary to the algorithm
+ * @param tree  Root of the subtree to splay
+ * @param key   Key to bring to the root
+ * @return New root of the subtree
+ */
+static dyndata_t* splay_tree(meta_t* meta, dyndata_t* tree, const void* key){
+    dyndata_t header = {0}, *left = &header, *right = &header, *tmp = NULL;
+    int cmp = 0;
+
+    if(!tree)
+        return NULL;
+
+    while((cmp = (*meta->doCompare)(tree->data, key)) != 0){
+        if(cmp > 0){
+            //key in the left subtree
+            if(!tree->left)
+                break;
+
+            //zig-zig, rotate right first
+            if((*meta->doCompare)(tree->left->data, key) > 0){
+                tmp = tree->left;
+                tree->left = tmp->right;
+                tmp->right = tree;
+                tree = tmp;
+                if(!tree->left)
+                    break;
+            }
+
+            //hang the current node to the right tree
+            right->left = tree;
+            right = tree;
+            tree = tree->left;
+        }
+        else{
+            //key in the right subtree
+            if(!tree->right)
+                break;
+
+            //zag-zag, rotate left first
+            if((*meta->doCompare)(tree->right->data, key) < 0){
+                tmp = tree->right;
+                tree->right = tmp->left;
+                tmp->left = tree;
+                tree = tmp;
+                if(!tree->right)
+                    break;
+            }
+
+            //hang the current node to the left tree
+            left->right = tree;
+            left = tree;
+            tree = tree->right;
+        }
+    }
+
+    //re-assemble the left tree, the element reached, and the right tree
+    left->right = tree->left;
+    right->left = tree->right;
+    tree->left = header.right;
+    tree->right = header.left;
+
+    return tree;
+}
@@ -0,0 +1,289 @@
+/**
+ * @file cspscqueues.c
+ * @brief Implement wait-free bounded queues between a single producer and a single consumer
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note Elements are copied inline in a circular buffer. The producer publishes them by
+ *       storing the tail with release semantics once they are written, and the consumer
+ *       releases their slots the same way with the head. No operation ever waits
+ *       for the other thread : a full (or empty) queue is reported immediately.
+ *       The batch variants publish several elements with a single store.
+ * @warning Only one thread may push, and only one thread may pop
+ */
+#include "cspscqueues.h"
+#include <stdlib.h>
+#include <string.h>
+
+//SPSC queues internal functions
+static uint8_t* get_SPSC_slot(const spscqueue_t* queue, uint32_t index);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Allocate a SPSC queue
+ * @note The structure must have been initialised with initialise_structure() beforehand
+ *
+ * @param meta      Metadata of the queue
+ * @param capacity  Number of elements the queue can hold (rounded up to a power of two)
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_SPSC_queue(meta_t* meta, uint32_t capacity){
+    spscqueue_t* queue = NULL;
+    size_t size = 0;
+
+    if(!meta || !meta->elementsize || !capacity)
+        return -1;
+
+    if(capacity > SPSC_MAX_CAPACITY)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_SPSC_queue: capacity %u too high", capacity);
+
+        return -1;
+    }
+
+    queue = aligned_alloc(SPSC_CACHELINE, sizeof(spscqueue_t));
+    if(!queue)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_SPSC_queue: queue could not be allocated");
+
+        return -1;
+    }
+    memset(queue, 0, sizeof(spscqueue_t));
+
+    //compute the size of an element, aligned, and the capacity as a power of two
+    queue->stride = (meta->elementsize + SPSC_ALIGNMENT - 1) & ~(SPSC_ALIGNMENT - 1);
+    queue->capacity = 1;
+    while(queue->capacity < capacity)
+        queue->capacity <<= 1;
+
+    size = (size_t)queue->capacity * queue->stride;
+    size = (size + SPSC_CACHELINE - 1) & ~((size_t)SPSC_CACHELINE - 1);
+    queue->elements = aligned_alloc(SPSC_CACHELINE, size);
+    if(!queue->elements)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_SPSC_queue: buffer of %u elements could not be allocated", queue->capacity);
+
+        free(queue);
+        return -1;
+    }
+
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+
+    meta->structure = queue;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Free the memory of a SPSC queue and its elements
+ * @warning Neither the producer nor the consumer may use the queue anymore
+ *
+ * @param meta Metadata of the queue
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_SPSC_queue(meta_t* meta){
+    spscqueue_t* queue = NULL;
+
+    if(!meta)
+        return -1;
+
+    queue = meta->structure;
+    if(queue)
+    {
+        free(queue->elements);
+        free(queue);
+    }
+
+    meta->structure = NULL;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Push an element at the back of a SPSC queue (producer only)
+ *
+ * @param meta  Metadata of the queue
+ * @param toAdd Element to push
+ * @retval  0 Element pushed
+ * @retval  1 Queue full
+ * @retval -1 Error
+ */
+int pushSPSCQueue(meta_t* meta, const void* toAdd){
+    spscqueue_t* queue = NULL;
+    uint32_t tail = 0;
+
+    if(!meta || !meta->structure || !toAdd)
+        return -1;
+
+    queue = meta->structure;
+    tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+    //queue full as far as the producer knows, read the head again
+    if(tail - queue->headcache == queue->capacity)
+    {
+        queue->headcache = atomic_load_explicit(&queue->head, memory_order_acquire);
+        if(tail - queue->headcache == queue->capacity)
+            return 1;
+    }
+
+    memcpy(get_SPSC_slot(queue, tail), toAdd, meta->elementsize);
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+
+    return 0;
+}
+
+/**
+ * @brief Push several elements at the back of a SPSC queue, and publish them at once (producer only)
+ *
+ * @param meta  Metadata of the queue
+ * @param toAdd Array of nb elements to push
+ * @param nb    Number of elements to push
+ * @return      Number of elements pushed (less than nb if the queue gets full)
+ */
+uint32_t pushSPSCQueueBatch(meta_t* meta, const void* toAdd, uint32_t nb){
+    spscqueue_t* queue = NULL;
+    uint32_t tail = 0, room = 0;
+
+    if(!meta || !meta->structure || !toAdd)
+        return 0;
+
+    queue = meta->structure;
+    tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+    //not enough room as far as the producer knows, read the head again
+    room = queue->capacity - (tail - queue->headcache);
+    if(room < nb)
+    {
+        queue->headcache = atomic_load_explicit(&queue->head, memory_order_acquire);
+        room = queue->capacity - (tail - queue->headcache);
+    }
+    if(nb > room)
+        nb = room;
+
+    for(uint32_t i = 0 ; i < nb ; i++)
+        memcpy(get_SPSC_slot(queue, tail + i), (const uint8_t*)toAdd + ((size_t)i * meta->elementsize), meta->elementsize);
+
+    if(nb)
+        atomic_store_explicit(&queue->tail, tail + nb, memory_order_release);
+
+    return nb;
+}
+
+/**
+ * @brief Pop the first element from a SPSC queue (consumer only)
+ *
+ * @param meta      Metadata of the queue
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval  1 Popped
+ * @retval  0 Queue empty
+ * @retval -1 Error
+ */
+int popSPSCQueue(meta_t* meta, void* popped){
+    spscqueue_t* queue = NULL;
+    uint32_t head = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    queue = meta->structure;
+    head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+    //queue empty as far as the consumer knows, read the tail again
+    if(head == queue->tailcache)
+    {
+        queue->tailcache = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        if(head == queue->tailcache)
+            return 0;
+    }
+
+    if(popped)
+        memcpy(popped, get_SPSC_slot(queue, head), meta->elementsize);
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+
+    return 1;
+}
+
+/**
+ * @brief Pop several elements from a SPSC queue, and release their slots at once (consumer only)
+ *
+ * @param meta      Metadata of the queue
+ * @param popped    Array in which copy the nb elements (can be NULL)
+ * @param nb        Maximum number of elements to pop
+ * @return          Number of elements popped
+ */
+uint32_t popSPSCQueueBatch(meta_t* meta, void* popped, uint32_t nb){
+    spscqueue_t* queue = NULL;
+    uint32_t head = 0, available = 0;
+
+    if(!meta || !meta->structure)
+        return 0;
+
+    queue = meta->structure;
+    head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+    //not enough elements as far as the consumer knows, read the tail again
+    available = queue->tailcache - head;
+    if(available < nb)
+    {
+        queue->tailcache = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        available = queue->tailcache - head;
+    }
+    if(nb > available)
+        nb = available;
+
+    if(popped)
+    {
+        for(uint32_t i = 0 ; i < nb ; i++)
+            memcpy((uint8_t*)popped + ((size_t)i * meta->elementsize), get_SPSC_slot(queue, head + i), meta->elementsize);
+    }
+
+    if(nb)
+        atomic_store_explicit(&queue->head, head + nb, memory_order_release);
+
+    return nb;
+}
+
+/**
+ * @brief Get the number of elements in a SPSC queue
+ * @note The count is only a snapshot if the other thread is running
+ *
+ * @param meta  Metadata of the queue
+ * @return      Number of elements in the queue
+ */
+uint32_t get_SPSC_queue_count(meta_t* meta){
+    spscqueue_t* queue = NULL;
+    uint32_t head = 0;
+
+    if(!meta || !meta->structure)
+        return 0;
+
+    queue = meta->structure;
+    head = atomic_load_explicit(&queue->head, memory_order_acquire);
+
+    return atomic_load_explicit(&queue->tail, memory_order_acquire) - head;
+}
+
+/**
+ * @brief Get the address of the slot of an index in the buffer
+ *
+ * @param queue Queue in which get the slot
+ * @param index Index (not wrapped) of the element
+ * @return      Address of the slot
+ */
+static uint8_t* get_SPSC_slot(const spscqueue_t* queue, uint32_t index){
+    return queue->elements + ((size_t)(index & (queue->capacity - 1)) * queue->stride);
+}
@@ -6,6 +6,7 @@
  */
 #include "cstacks.h"
 #include <stdlib.h>
+#include <string.h>
 
 /**
  * @brief Push a new element at the head of the stack
@@ -93,6 +94,106 @@ void* popStack(meta_t* meta){
     return tmp;
 }
 
+/**
+ * @brief Push several elements at the head of the stack, in one allocation
+ * @note The elements are allocated in a single block (see allocate_dyn_block()),
+ *       linked together, then chained to the stack at once
+ * 
+ * @param meta  Metadata used by the stack
+ * @param toAdd Array of nb elements to push, the last one ending up at the head
+ * @param nb    Number of elements to push
+ * @retval  0 Elements pushed
+ * @retval -1 Error (nothing pushed)
+ */
+int pushStackBatch(meta_t* meta, const void* toAdd, uint32_t nb){
+    dyndata_t *newElements = NULL;
+
+    //check if meta data available
+    if(!meta)
+        return -1;
+
+    if(!nb)
+        return 0;
+
+    //check if elements added are available
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("pushStackBatch: new elements cannot be NULL");
+
+        return -1;
+    }
+
+    //allocate memory for all the new elements at once
+    if((newElements = allocate_dyn_block(meta, toAdd, nb)) == NULL)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("pushStackBatch: new elements could not be allocated");
+        return -1;
+    }
+
+    //link the new elements together, from the last one (new head) to the first one
+    for(uint32_t i = 1 ; i < nb ; i++)
+    {
+        newElements[i].right = &newElements[i - 1];
+        newElements[i - 1].left = &newElements[i];
+    }
+
+    //chain them to the head of the stack, or make them the stack
+    if(meta->structure){
+        newElements[0].right = meta->structure;
+        ((dyndata_t*)meta->structure)->left = &newElements[0];
+    }
+    else
+        meta->last = &newElements[0];
+
+    meta->structure = &newElements[nb - 1];
+    meta->nbelements += nb;
+
+    return 0;
+}
+
+/**
+ * @brief Pop several elements from the head of the stack, copying them in an array
+ * @note The elements are copied in the order they were pushed (the former head last),
+ *       so popping a batch gives back the array of the matching pushStackBatch()
+ * 
+ * @param meta      Metadata used by the stack
+ * @param popped    Array in which copy the elements (can be NULL)
+ * @param nb        Maximum number of elements to pop
+ * @return          Number of elements popped
+ */
+uint32_t popStackBatch(meta_t* meta, void* popped, uint32_t nb){
+    dyndata_t *tmp = NULL;
+
+    //check if meta data available
+    if(!meta)
+        return 0;
+
+    if(nb > meta->nbelements)
+        nb = meta->nbelements;
+
+    //copy and free each element from the head of the stack, filling the array backwards
+    for(uint32_t i = nb ; i > 0 ; i--)
+    {
+        tmp = meta->structure;
+        meta->structure = tmp->right;
+
+        if(popped)
+            memcpy((uint8_t*)popped + ((size_t)(i - 1) * meta->elementsize), tmp->data, meta->elementsize);
+        free_dyn(&tmp);
+    }
+
+    //update the elements counter and the pointers once
+    meta->nbelements -= nb;
+    if(meta->structure)
+        ((dyndata_t*)meta->structure)->left = NULL;
+    else
+        meta->last = NULL;
+
+    return nb;
+}
+
 /**
  * @brief Perform an action on every element of the stack
  * 
@@ -8,6 +8,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+//structures internal functions
+static int fillAVLBlock(meta_t* dAVL, dyndata_t* nodes, uint32_t* nb, const void* elem);
+static int buildAVLBlock(meta_t* dAVL, dyndata_t* nodes, uint32_t nb, uint32_t capacity);
+
 /**
  * @brief Allocates memory an array and copies a list into it
  * 
@@ -124,3 +128,175 @@ int arrayToAVL(meta_t* dArray, meta_t* dAVL, e_listtoarray action){
 
     return 0;
 }
+
+/**
+ * @brief Copy the next element of a sorted sequence in a block of AVL nodes
+ * @note Duplicates are skipped, as they are forbidden in AVL trees
+ * 
+ * @param dAVL  AVL being built
+ * @param nodes Block of nodes
+ * @param nb    Number of nodes already filled
+ * @param elem  Element to copy
+ * @retval  0 OK
+ * @retval -1 Sequence not sorted
+ */
+static int fillAVLBlock(meta_t* dAVL, dyndata_t* nodes, uint32_t* nb, const void* elem){
+    int cmp = 0;
+
+    if(*nb)
+    {
+        cmp = (*dAVL->doCompare)(nodes[*nb - 1].data, elem);
+        if(cmp > 0)
+        {
+            if(dAVL->doPError)
+                (*dAVL->doPError)("fillAVLBlock: element %u is not sorted", *nb);
+
+            return -1;
+        }
+
+        if(!cmp)
+            return 0;
+
+        //chain the previous node to this one, making a vine
+        nodes[*nb - 1].right = &nodes[*nb];
+    }
+
+    memcpy(nodes[*nb].data, elem, dAVL->elementsize);
+    (*nb)++;
+
+    return 0;
+}
+
+/**
+ * @brief Build an AVL from a block of nodes, and release the nodes not used
+ * 
+ * @param dAVL      AVL to build
+ * @param nodes     Block of nodes, chained as a vine
+ * @param nb        Number of nodes filled
+ * @param capacity  Number of nodes in the block
+ * @retval  0 OK
+ */
+static int buildAVLBlock(meta_t* dAVL, dyndata_t* nodes, uint32_t nb, uint32_t capacity){
+    dyndata_t* tmp = NULL;
+
+    //release the nodes left over by duplicates
+    for(uint32_t i = nb ; i < capacity ; i++)
+    {
+        tmp = &nodes[i];
+        free_dyn(&tmp);
+    }
+
+    tmp = nodes;
+    dAVL->structure = buildAVL(&tmp, nb);
+    dAVL->nbelements = nb;
+
+    return 0;
+}
+
+/**
+ * @brief Build a perfectly balanced AVL from a sorted array, in linear time
+ * @note All the nodes are allocated in a single block
+ * 
+ * @param dArray    Array to copy, sorted with the AVL comparison method
+ * @param dAVL      AVL to create @warning MUST BE EMPTY
+ * @param action    Action to perform on the array @note free or not
+ * @retval  0 AVL created
+ * @retval -1 Error
+ */
+int sortedArrayToAVL(meta_t* dArray, meta_t* dAVL, e_listtoarray action){
+    dyndata_t *nodes = NULL, *tmp = NULL;
+    uint32_t nb = 0;
+
+    //check if the AVL doesn't exist
+    if(dAVL->structure)
+    {
+        if(dAVL->doPError)
+            (*dAVL->doPError)("sortedArrayToAVL: AVL is not NULL");
+
+        return -1;
+    }
+
+    if(dArray->nbelements)
+    {
+        nodes = allocate_dyn_block(dAVL, NULL, dArray->nbelements);
+        if(!nodes)
+            return -1;
+
+        //copy elements one by one in the block
+        for(uint32_t i=0 ; i<dArray->nbelements ; i++){
+            if(fillAVLBlock(dAVL, nodes, &nb, get_arrayelem(dArray, i)) < 0)
+            {
+                for(uint32_t j = 0 ; j < dArray->nbelements ; j++)
+                {
+                    tmp = &nodes[j];
+                    free_dyn(&tmp);
+                }
+
+                return -1;
+            }
+        }
+
+        buildAVLBlock(dAVL, nodes, nb, dArray->nbelements);
+    }
+
+    //if desired, free the freshly copied element
+    if(action == REPLACE)
+        empty_array(dArray);
+
+    return 0;
+}
+
+/**
+ * @brief Build a perfectly balanced AVL from a sorted list, in linear time
+ * @note All the nodes are allocated in a single block
+ * 
+ * @param dList     List to copy, sorted with the AVL comparison method
+ * @param dAVL      AVL to create @warning MUST BE EMPTY
+ * @param action    Action to perform on the list members @note free or not
+ * @retval  0 AVL created
+ * @retval -1 Error
+ */
+int sortedListToAVL(meta_t* dList, meta_t* dAVL, e_listtoarray action){
+    dyndata_t *nodes = NULL, *tmp = NULL, *tmp_list = NULL;
+    uint32_t nb = 0, i = 0;
+
+    //check if the AVL doesn't exist
+    if(dAVL->structure)
+    {
+        if(dAVL->doPError)
+            (*dAVL->doPError)("sortedListToAVL: AVL is not NULL");
+
+        return -1;
+    }
+
+    if(dList->structure)
+    {
+        nodes = allocate_dyn_block(dAVL, NULL, dList->nbelements);
+        if(!nodes)
+            return -1;
+
+        //copy elements one by one in the block
+        tmp_list = dList->structure;
+        for(i = 0 ; tmp_list && i < dList->nbelements ; i++){
+            if(fillAVLBlock(dAVL, nodes, &nb, tmp_list->data) < 0)
+            {
+                for(uint32_t j = 0 ; j < dList->nbelements ; j++)
+                {
+                    tmp = &nodes[j];
+                    free_dyn(&tmp);
+                }
+
+                return -1;
+            }
+            tmp_list = tmp_list->right;
+        }
+
+        buildAVLBlock(dAVL, nodes, nb, dList->nbelements);
+    }
+
+    //if desired, free the list
+    if(action == REPLACE)
+        freeDynList(dList);
+
+    return 0;
+}
@@ -14,9 +14,24 @@
 *       if doPError is set as NULL, error printing will be ignored
 */
 #include "cstructurescommon.h"
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
+#define DYN_ALIGN(size) (((size) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))   ///< Size rounded up to the alignment of any data
+
+/********************************************************
+ * @brief Header of a block of elements
+ * @note Each element data is preceded by the address of its block
+********************************************************/
+typedef struct
+{
+    uint32_t    refs;   ///< Number of elements of the block still allocated
+} dynblock_t;
+
+//common internal functions
+static dynblock_t* get_dyn_block(dyndata_t* elem);
+
 
 /*********************************************************************************************/
 /*********************************************************************************************/
@@ -71,13 +86,81 @@ dyndata_t* allocate_dyn(meta_t* meta, const void* elem)
         return NULL;
     }
 
-    //copy new element data and set AVL leaf height
+    //copy new element data and set AVL leaf height and size
     memcpy(tmp->data, elem, meta->elementsize);
     tmp->height = 1;
+    tmp->count = 1;
 
     return tmp;
 }
 
+/**
+ * @brief Allocate several structure elements in a single block
+ * @note The elements are contiguous, and each can still be freed with free_dyn().
+ *       The block itself is freed with its last element.
+ * 
+ * @param meta  Metadata used by the current structure
+ * @param elems Array of nb data to copy in the new elements (left zeroed if NULL)
+ * @param nb    Number of elements to allocate
+ * @return      Address of the first element
+ * @retval NULL Error
+*/
+dyndata_t* allocate_dyn_block(meta_t* meta, const void* elems, uint32_t nb)
+{
+    dynblock_t* block = NULL;
+    dyndata_t* tmp = NULL;
+    uint8_t* cell = NULL;
+    size_t nodesOffset = DYN_ALIGN(sizeof(dynblock_t));
+    size_t cellsOffset = nodesOffset + DYN_ALIGN((size_t)nb * sizeof(dyndata_t));
+    size_t dataOffset = DYN_ALIGN(sizeof(dynblock_t*));
+    size_t cellSize = dataOffset + DYN_ALIGN((size_t)meta->elementsize);
+
+    if(!nb)
+        return NULL;
+
+    //memory allocation for the header, the elements and their data
+    block = calloc(1, cellsOffset + (nb * cellSize));
+    if(!block)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("allocate_dyn_block: block of %u elements could not be allocated", nb);
+
+        return NULL;
+    }
+    block->refs = nb;
+    tmp = (dyndata_t*)((uint8_t*)block + nodesOffset);
+
+    //prepend each data with the address of the block, then copy new element data
+    for(uint32_t i = 0 ; i < nb ; i++)
+    {
+        cell = (uint8_t*)block + cellsOffset + (i * cellSize);
+        memcpy(cell, &block, sizeof(dynblock_t*));
+
+        tmp[i].data = cell + dataOffset;
+        tmp[i].height = 1;
+        tmp[i].count = 1;
+        tmp[i].flags = DYN_BLOCK;
+        if(elems)
+            memcpy(tmp[i].data, (const uint8_t*)elems + ((size_t)i * meta->elementsize), meta->elementsize);
+    }
+
+    return tmp;
+}
+
+/**
+ * @brief Get the block in which an element was allocated
+ * 
+ * @param elem  Element allocated with allocate_dyn_block()
+ * @return      Header of the block
+*/
+static dynblock_t* get_dyn_block(dyndata_t* elem)
+{
+    dynblock_t* block = NULL;
+
+    memcpy(&block, (uint8_t*)elem->data - DYN_ALIGN(sizeof(dynblock_t*)), sizeof(dynblock_t*));
+    return block;
+}
+
 /**
  * @brief Free the memory used by a dynamic element
  * 
@@ -86,8 +169,20 @@ dyndata_t* allocate_dyn(meta_t* meta, const void* elem)
 */
 int free_dyn(dyndata_t** elem)
 {
-    free((*elem)->data);
-    free(*elem);
+    dynblock_t* block = NULL;
+
+    if((*elem)->flags & DYN_BLOCK)
+    {
+        //element within a block, free the block with its last element
+        block = get_dyn_block(*elem);
+        if(!--block->refs)
+            free(block);
+    }
+    else
+    {
+        free((*elem)->data);
+        free(*elem);
+    }
     *elem = NULL;
 
     return 0;
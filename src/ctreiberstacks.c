@@ -0,0 +1,289 @@
+/**
+ * @file ctreiberstacks.c
+ * @brief Implement lock-free stacks shared by any number of threads (Treiber algorithm)
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note The nodes are never returned to the allocator before free_treiber_stack(),
+ *       so a thread reading the link of a node popped in the meantime only gets a
+ *       stale index, which the tag of the head makes its CAS reject.
+ *       The links are atomic only to keep those stale reads well-defined.
+ * @warning The stack is bounded : pushing fails (returns 1) when every node of the pool is used
+ */
+#include "ctreiberstacks.h"
+#include <stdlib.h>
+#include <string.h>
+
+//Treiber stacks internal functions
+static _Atomic(uint32_t)* get_treiber_next(const treiberstack_t* stack, uint32_t node);
+static uint8_t* get_treiber_elem(const treiberstack_t* stack, uint32_t node);
+static uint32_t pop_treiber_node(const treiberstack_t* stack, _Atomic(uint64_t)* head);
+static void push_treiber_nodes(const treiberstack_t* stack, _Atomic(uint64_t)* head, uint32_t first, uint32_t last);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Allocate the pool of nodes of a Treiber stack
+ * @note The structure must have been initialised with initialise_structure() beforehand
+ *
+ * @param meta      Metadata of the stack
+ * @param capacity  Maximum number of elements in the stack
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_treiber_stack(meta_t* meta, uint32_t capacity){
+    treiberstack_t* stack = NULL;
+
+    if(!meta || !meta->elementsize)
+        return -1;
+
+    if(!capacity || capacity > TREIBER_MAX_CAPACITY)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_treiber_stack: capacity %u not supported", capacity);
+
+        return -1;
+    }
+
+    stack = aligned_alloc(TREIBER_CACHELINE, sizeof(treiberstack_t));
+    if(!stack)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_treiber_stack: stack could not be allocated");
+
+        return -1;
+    }
+
+    stack->capacity = capacity;
+    stack->stride = TREIBER_ALIGNMENT + ((meta->elementsize + TREIBER_ALIGNMENT - 1) & ~(TREIBER_ALIGNMENT - 1));
+    stack->nodes = malloc((size_t)capacity * stack->stride);
+    if(!stack->nodes)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_treiber_stack: pool of %u nodes could not be allocated", capacity);
+
+        free(stack);
+        return -1;
+    }
+
+    //chain all the nodes in the free stack
+    for(uint32_t i = 0 ; i < capacity ; i++)
+        atomic_init(get_treiber_next(stack, i), (i + 1 < capacity ? i + 1 : TREIBER_NONE));
+    atomic_init(&stack->top, TREIBER_NONE);
+    atomic_init(&stack->freenodes, 0);
+
+    meta->structure = stack;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Free the memory of a Treiber stack and its elements
+ * @note No other thread may use the stack anymore
+ *
+ * @param meta Metadata of the stack
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_treiber_stack(meta_t* meta){
+    treiberstack_t* stack = NULL;
+
+    if(!meta)
+        return -1;
+
+    stack = meta->structure;
+    if(stack)
+    {
+        free(stack->nodes);
+        free(stack);
+    }
+
+    meta->structure = NULL;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Push a new element on top of a Treiber stack
+ *
+ * @param meta  Metadata of the stack
+ * @param toAdd Element to push
+ * @retval  0 Element pushed
+ * @retval  1 Stack full
+ * @retval -1 Error
+ */
+int pushTreiberStack(meta_t* meta, const void* toAdd){
+    treiberstack_t* stack = NULL;
+    uint32_t node = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("pushTreiberStack: new element cannot be NULL");
+
+        return -1;
+    }
+
+    stack = meta->structure;
+    node = pop_treiber_node(stack, &stack->freenodes);
+    if(node == TREIBER_NONE)
+        return 1;
+
+    //the node is owned until published by the CAS of the push
+    memcpy(get_treiber_elem(stack, node), toAdd, meta->elementsize);
+    push_treiber_nodes(stack, &stack->top, node, node);
+
+    return 0;
+}
+
+/**
+ * @brief Pop the element on top of a Treiber stack
+ *
+ * @param meta      Metadata of the stack
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval  1 Popped
+ * @retval  0 Stack empty
+ * @retval -1 Error
+ */
+int popTreiberStack(meta_t* meta, void* popped){
+    treiberstack_t* stack = NULL;
+    uint32_t node = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    stack = meta->structure;
+    node = pop_treiber_node(stack, &stack->top);
+    if(node == TREIBER_NONE)
+        return 0;
+
+    //the node is owned until given back to the free stack
+    if(popped)
+        memcpy(popped, get_treiber_elem(stack, node), meta->elementsize);
+    push_treiber_nodes(stack, &stack->freenodes, node, node);
+
+    return 1;
+}
+
+/**
+ * @brief Detach every element of a Treiber stack at once, then perform an action on each of them
+ * @note The elements are browsed from the top to the bottom, then all the nodes are
+ *       given back to the pool with a single CAS
+ *
+ * @param meta      Metadata of the stack
+ * @param parameter Parameter used by the action to perform
+ * @param doAction  Action to perform on each element popped (can be NULL to discard them)
+ * @return          Number of elements popped
+ * @retval -1       Error (the elements are popped anyway)
+ */
+int popAllTreiberStack(meta_t* meta, void* parameter, int (*doAction)(void*, void*)){
+    treiberstack_t* stack = NULL;
+    uint64_t head = 0, empty = 0;
+    uint32_t node = 0, last = 0;
+    int nb = 0, ret = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    stack = meta->structure;
+
+    //swap the top for an empty one, tagged so that the CAS of stale pops fail
+    head = atomic_load_explicit(&stack->top, memory_order_relaxed);
+    do{
+        empty = (((head >> 32) + 1) << 32) | TREIBER_NONE;
+    }while(!atomic_compare_exchange_weak_explicit(&stack->top, &head, empty, memory_order_acquire, memory_order_relaxed));
+
+    node = (uint32_t)head;
+    if(node == TREIBER_NONE)
+        return 0;
+
+    for( ; node != TREIBER_NONE ; node = atomic_load_explicit(get_treiber_next(stack, node), memory_order_relaxed))
+    {
+        if(doAction && !ret && (*doAction)(get_treiber_elem(stack, node), parameter) < 0)
+        {
+            if(meta->doPError)
+                (*meta->doPError)("popAllTreiberStack: action specified returned with an error");
+
+            ret = -1;
+        }
+
+        last = node;
+        nb++;
+    }
+
+    //the detached chain is still linked, so it is spliced on the free stack as is
+    push_treiber_nodes(stack, &stack->freenodes, (uint32_t)head, last);
+
+    return (ret ? ret : nb);
+}
+
+/**
+ * @brief Get the address of the link of a node
+ *
+ * @param stack Stack in which get the node
+ * @param node  Index of the node
+ * @return      Address of the index of the next node
+ */
+static _Atomic(uint32_t)* get_treiber_next(const treiberstack_t* stack, uint32_t node){
+    return (_Atomic(uint32_t)*)(stack->nodes + ((size_t)node * stack->stride));
+}
+
+/**
+ * @brief Get the address of the element of a node
+ *
+ * @param stack Stack in which get the element
+ * @param node  Index of the node
+ * @return      Address of the element
+ */
+static uint8_t* get_treiber_elem(const treiberstack_t* stack, uint32_t node){
+    return stack->nodes + ((size_t)node * stack->stride) + TREIBER_ALIGNMENT;
+}
+
+/**
+ * @brief Detach the top node of a tagged stack
+ *
+ * @param stack Stack holding the nodes
+ * @param head  Tagged head of the stack (top or free)
+ * @return      Index of the node detached
+ * @retval TREIBER_NONE Stack empty
+ */
+static uint32_t pop_treiber_node(const treiberstack_t* stack, _Atomic(uint64_t)* head){
+    uint64_t current = atomic_load_explicit(head, memory_order_acquire), next = 0;
+
+    do{
+        if((uint32_t)current == TREIBER_NONE)
+            return TREIBER_NONE;
+
+        //the link read may be stale if the node got popped meanwhile, the tag makes the CAS fail then
+        next = atomic_load_explicit(get_treiber_next(stack, (uint32_t)current), memory_order_relaxed);
+        next |= ((current >> 32) + 1) << 32;
+    }while(!atomic_compare_exchange_weak_explicit(head, &current, next, memory_order_acquire, memory_order_acquire));
+
+    return (uint32_t)current;
+}
+
+/**
+ * @brief Attach a chain of nodes on top of a tagged stack
+ *
+ * @param stack Stack holding the nodes
+ * @param head  Tagged head of the stack (top or free)
+ * @param first First node of the chain
+ * @param last  Last node of the chain (linked to the former top)
+ */
+static void push_treiber_nodes(const treiberstack_t* stack, _Atomic(uint64_t)* head, uint32_t first, uint32_t last){
+    uint64_t current = atomic_load_explicit(head, memory_order_relaxed);
+
+    do{
+        atomic_store_explicit(get_treiber_next(stack, last), (uint32_t)current, memory_order_relaxed);
+    }while(!atomic_compare_exchange_weak_explicit(head, &current, (((current >> 32) + 1) << 32) | first, memory_order_release, memory_order_relaxed));
+}
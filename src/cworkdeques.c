@@ -0,0 +1,374 @@
+/**
+ * @file cworkdeques.c
+ * @brief Implement work-stealing deques (Chase-Lev algorithm, with C11 atomics)
+ * @author Gilles Henrard
+ * @date 19/10/2026
+ *
+ * @note The owner works at the bottom in LIFO order, which keeps the tasks it just
+ *       created hot in its cache, while thieves take the oldest ones at the top.
+ *       The array doubles when full. Thieves may still be reading the former one,
+ *       so it is kept until the deque is freed.
+ */
+#include "cworkdeques.h"
+#include <stdlib.h>
+#include <string.h>
+
+//work-stealing deques internal functions
+static workarray_t* allocate_work_array(uint32_t capacity, uint32_t nbwords);
+static void store_work_elem(workarray_t* array, uint32_t nbwords, int64_t i, const void* element, uint32_t size);
+static void load_work_elem(workarray_t* array, uint32_t nbwords, int64_t i, void* element, uint32_t size);
+static workarray_t* grow_work_deque(meta_t* meta, workdeque_t* deque, workarray_t* array, int64_t top, int64_t bottom);
+
+
+/*********************************************************************************************/
+/*********************************************************************************************/
+
+
+/**
+ * @brief Allocate the array of a work-stealing deque
+ * @note The structure must have been initialised with initialise_structure() beforehand
+ *
+ * @param meta      Metadata of the deque
+ * @param capacity  Number of elements to reserve (rounded up to a power of two, grows on demand)
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int initialise_work_deque(meta_t* meta, uint32_t capacity){
+    workdeque_t* deque = NULL;
+    workarray_t* array = NULL;
+    uint32_t size = 2;
+
+    if(!meta || !meta->elementsize)
+        return -1;
+
+    if(capacity > WORKDEQUE_MAX_CAPACITY)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_work_deque: capacity %u not supported", capacity);
+
+        return -1;
+    }
+
+    while(size < capacity)
+        size <<= 1;
+
+    deque = aligned_alloc(WORKDEQUE_CACHELINE, sizeof(workdeque_t));
+    if(!deque)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_work_deque: deque could not be allocated");
+
+        return -1;
+    }
+
+    deque->nbwords = (meta->elementsize + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    array = allocate_work_array(size, deque->nbwords);
+    if(!array)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("initialise_work_deque: array of %u elements could not be allocated", size);
+
+        free(deque);
+        return -1;
+    }
+
+    atomic_init(&deque->array, array);
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+
+    meta->structure = deque;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Free the memory of a work-stealing deque, its elements and its former arrays
+ * @note No other thread may use the deque anymore
+ *
+ * @param meta Metadata of the deque
+ * @retval  0 OK
+ * @retval -1 Error
+ */
+int free_work_deque(meta_t* meta){
+    workdeque_t* deque = NULL;
+    workarray_t* array = NULL, *retired = NULL;
+
+    if(!meta)
+        return -1;
+
+    deque = meta->structure;
+    if(deque)
+    {
+        array = atomic_load(&deque->array);
+        while(array)
+        {
+            retired = array->retired;
+            free(array);
+            array = retired;
+        }
+        free(deque);
+    }
+
+    meta->structure = NULL;
+    meta->last = NULL;
+    meta->nbelements = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Push a new element at the bottom of a work-stealing deque (owner only)
+ *
+ * @param meta  Metadata of the deque
+ * @param toAdd Element to push
+ * @retval  0 Element pushed
+ * @retval -1 Error
+ */
+int pushWorkDeque(meta_t* meta, const void* toAdd){
+    workdeque_t* deque = NULL;
+    workarray_t* array = NULL;
+    int64_t top = 0, bottom = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    if(!toAdd)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("pushWorkDeque: new element cannot be NULL");
+
+        return -1;
+    }
+
+    deque = meta->structure;
+    bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+    if(bottom - top >= (int64_t)array->capacity)
+    {
+        array = grow_work_deque(meta, deque, array, top, bottom);
+        if(!array)
+            return -1;
+    }
+
+    //publish the element before the new bottom, so a thief seeing the bottom sees the element
+    store_work_elem(array, deque->nbwords, bottom, toAdd, meta->elementsize);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+
+    return 0;
+}
+
+/**
+ * @brief Pop the element at the bottom of a work-stealing deque, the latest pushed (owner only)
+ *
+ * @param meta      Metadata of the deque
+ * @param popped    Buffer in which copy the element (can be NULL)
+ * @retval  1 Popped
+ * @retval  0 Deque empty
+ * @retval -1 Error
+ */
+int popWorkDeque(meta_t* meta, void* popped){
+    workdeque_t* deque = NULL;
+    workarray_t* array = NULL;
+    int64_t top = 0, bottom = 0;
+    int ret = 1;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    deque = meta->structure;
+
+    //reserve the bottom element first, then check whether thieves took it
+    bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if(top > bottom)
+    {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return 0;
+    }
+
+    //the last element is raced for with the thieves, on the top
+    if(top == bottom)
+    {
+        if(!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+            ret = 0;
+
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+
+    if(ret && popped)
+        load_work_elem(array, deque->nbwords, bottom, popped, meta->elementsize);
+
+    return ret;
+}
+
+/**
+ * @brief Steal the element at the top of a work-stealing deque, the oldest pushed (any thread)
+ * @note The element is copied before being claimed, so the buffer content is undefined if 0 is returned
+ *
+ * @param meta      Metadata of the deque
+ * @param stolen    Buffer in which copy the element (can be NULL)
+ * @retval  1 Stolen
+ * @retval  0 Deque empty, or element taken by another thread meanwhile
+ * @retval -1 Error
+ */
+int stealWorkDeque(meta_t* meta, void* stolen){
+    workdeque_t* deque = NULL;
+    int64_t top = 0, bottom = 0;
+
+    if(!meta || !meta->structure)
+        return -1;
+
+    deque = meta->structure;
+    top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if(top >= bottom)
+        return 0;
+
+    //copy the element before claiming it, as the owner may overwrite its slot right after
+    if(stolen)
+        load_work_elem(atomic_load_explicit(&deque->array, memory_order_acquire), deque->nbwords, top, stolen, meta->elementsize);
+
+    return (atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed) ? 1 : 0);
+}
+
+/**
+ * @brief Get the number of elements in a work-stealing deque
+ * @note Only an estimate while other threads use the deque
+ *
+ * @param meta  Metadata of the deque
+ * @return      Number of elements
+ */
+uint32_t get_work_deque_count(meta_t* meta){
+    workdeque_t* deque = NULL;
+    int64_t top = 0, bottom = 0;
+
+    if(!meta || !meta->structure)
+        return 0;
+
+    deque = meta->structure;
+    top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    return (bottom > top ? (uint32_t)(bottom - top) : 0);
+}
+
+/**
+ * @brief Allocate a circular array of a work-stealing deque
+ *
+ * @param capacity  Number of elements (power of two)
+ * @param nbwords   Number of words per element
+ * @return          Array allocated
+ * @retval NULL     Error
+ */
+static workarray_t* allocate_work_array(uint32_t capacity, uint32_t nbwords){
+    workarray_t* array = malloc(sizeof(workarray_t) + ((size_t)capacity * nbwords * sizeof(_Atomic(uint64_t))));
+
+    if(!array)
+        return NULL;
+
+    array->retired = NULL;
+    array->capacity = capacity;
+    for(size_t i = 0 ; i < (size_t)capacity * nbwords ; i++)
+        atomic_init(&array->words[i], 0);
+
+    return array;
+}
+
+/**
+ * @brief Copy an element in its slot of a circular array, word by word
+ *
+ * @param array     Array in which store the element
+ * @param nbwords   Number of words per element
+ * @param i         Position of the element
+ * @param element   Element to copy
+ * @param size      Size of the element
+ */
+static void store_work_elem(workarray_t* array, uint32_t nbwords, int64_t i, const void* element, uint32_t size){
+    _Atomic(uint64_t)* words = &array->words[((uint64_t)i & (array->capacity - 1)) * nbwords];
+    uint64_t word = 0;
+
+    for(uint32_t j = 0 ; j < nbwords ; j++)
+    {
+        word = 0;
+        memcpy(&word, (const uint8_t*)element + (j * sizeof(uint64_t)), (size - (j * sizeof(uint64_t)) < sizeof(uint64_t) ? size - (j * sizeof(uint64_t)) : sizeof(uint64_t)));
+        atomic_store_explicit(&words[j], word, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Copy an element out of its slot of a circular array, word by word
+ *
+ * @param array     Array from which load the element
+ * @param nbwords   Number of words per element
+ * @param i         Position of the element
+ * @param element   Buffer in which copy the element
+ * @param size      Size of the element
+ */
+static void load_work_elem(workarray_t* array, uint32_t nbwords, int64_t i, void* element, uint32_t size){
+    _Atomic(uint64_t)* words = &array->words[((uint64_t)i & (array->capacity - 1)) * nbwords];
+    uint64_t word = 0;
+
+    for(uint32_t j = 0 ; j < nbwords ; j++)
+    {
+        word = atomic_load_explicit(&words[j], memory_order_relaxed);
+        memcpy((uint8_t*)element + (j * sizeof(uint64_t)), &word, (size - (j * sizeof(uint64_t)) < sizeof(uint64_t) ? size - (j * sizeof(uint64_t)) : sizeof(uint64_t)));
+    }
+}
+
+/**
+ * @brief Replace the array of a work-stealing deque by one twice as large (owner only)
+ *
+ * @param meta      Metadata of the deque
+ * @param deque     Deque to grow
+ * @param array     Current array
+ * @param top       Position of the first element
+ * @param bottom    Position following the last element
+ * @return          New array
+ * @retval NULL     Error
+ */
+static workarray_t* grow_work_deque(meta_t* meta, workdeque_t* deque, workarray_t* array, int64_t top, int64_t bottom){
+    workarray_t* grown = NULL;
+
+    if(array->capacity >= WORKDEQUE_MAX_CAPACITY)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("grow_work_deque: maximum capacity reached");
+
+        return NULL;
+    }
+
+    grown = allocate_work_array(array->capacity * 2, deque->nbwords);
+    if(!grown)
+    {
+        if(meta->doPError)
+            (*meta->doPError)("grow_work_deque: array of %u elements could not be allocated", array->capacity * 2);
+
+        return NULL;
+    }
+
+    //the elements keep their positions, only their slots change with the capacity
+    for(int64_t i = top ; i < bottom ; i++)
+    {
+        for(uint32_t j = 0 ; j < deque->nbwords ; j++)
+        {
+            atomic_store_explicit(&grown->words[(((uint64_t)i & (grown->capacity - 1)) * deque->nbwords) + j],
+                atomic_load_explicit(&array->words[(((uint64_t)i & (array->capacity - 1)) * deque->nbwords) + j], memory_order_relaxed), memory_order_relaxed);
+        }
+    }
+
+    grown->retired = array;
+    atomic_store_explicit(&deque->array, grown, memory_order_release);
+
+    return grown;
+}
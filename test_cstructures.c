@@ -8,6 +8,9 @@
 #include <time.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <threads.h>
+#include <stdatomic.h>
 #include "cstructures.h"
 #include "dataset_test.h"
 #include "screen.h"
@@ -29,6 +32,32 @@ int tst_searchavl(void);
 int tst_insertqueue(void);
 int tst_insertPriorityQueue(void);
 int tst_insertstack(void);
+int tst_pool(void);
+int tst_lockfreelist(void);
+int tst_avlintegrity(void);
+int tst_bulkavl(void);
+int tst_orderstatavl(void);
+int tst_avliterator(void);
+int tst_btree(void);
+int tst_concurrentavl(void);
+int tst_persistentavl(void);
+int tst_batchdeleteavl(void);
+int tst_setopsavl(void);
+int tst_upsertavl(void);
+int tst_parallelavl(void);
+int tst_rbtree(void);
+int tst_splaytree(void);
+int tst_ringqueue(void);
+int tst_spscqueue(void);
+int tst_mpmcqueue(void);
+int tst_heap(void);
+int tst_indexedheap(void);
+int tst_bucketqueue(void);
+int tst_arraystack(void);
+int tst_treiberstack(void);
+int tst_workdeque(void);
+int tst_scheduler(void);
+int tst_batchqueuestack(void);
 
 #ifdef __GNUC__
 # pragma GCC diagnostic ignored "-Wunused-parameter"
@@ -53,6 +82,32 @@ int main(int argc, char *argv[])
     tst_insertqueue();
     tst_insertPriorityQueue();
     tst_insertstack();
+    tst_pool();
+    tst_lockfreelist();
+    tst_avlintegrity();
+    tst_bulkavl();
+    tst_orderstatavl();
+    tst_avliterator();
+    tst_btree();
+    tst_concurrentavl();
+    tst_persistentavl();
+    tst_batchdeleteavl();
+    tst_setopsavl();
+    tst_upsertavl();
+    tst_parallelavl();
+    tst_rbtree();
+    tst_splaytree();
+    tst_ringqueue();
+    tst_spscqueue();
+    tst_mpmcqueue();
+    tst_heap();
+    tst_indexedheap();
+    tst_bucketqueue();
+    tst_arraystack();
+    tst_treiberstack();
+    tst_workdeque();
+    tst_scheduler();
+    tst_batchqueuestack();
 
 	exit(EXIT_SUCCESS);
 }
@@ -971,3 +1026,2470 @@ int tst_insertstack()
 
     return 0;
 }
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the index-linked pool lists and queues    */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_pool()
+{
+    meta_t arr, pool;
+    dataset_t tmp;
+
+    printf("/*********************************************************************/\n");
+    printf("/****************************** tst_pool *****************************/\n");
+    printf("/*********************************************************************/\n");
+
+    //initialise the structures (pool purposely too small to test its growth)
+    initialise_structure(&arr, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&pool, sizeof(dataset_t), compare_dataset, printError);
+    arr.nbelements = 20;
+    if(initialise_pool(&pool, 4) == -1)
+    {
+        fprintf(stderr, "tst_pool : error while allocating the pool\n");
+        return -1;
+    }
+
+    //generate 20 random datasets
+    if(setup_data((dataset_t**)&arr.structure, 20) == -1)
+    {
+        fprintf(stderr, "tst_pool : error while allocating the data\n");
+        free_pool(&pool);
+        return -1;
+    }
+
+    printf("Insert all array elements in a sorted pool list :\n");
+    for(uint32_t i = 0 ; i < arr.nbelements ; i++)
+        insertPoolSorted(&pool, get_arrayelem(&arr, i));
+
+    foreachPool(&pool, NULL, Print_dataset);
+    printf("Element at index 10 :\n");
+    Print_dataset(get_poolelem(&pool, 10), NULL);
+
+    printf("Pop elements from pool queue, one by one :\n");
+    while(popPoolQueue(&pool, &tmp) > 0)
+        Print_dataset(&tmp, NULL);
+
+    if(pool.nbelements)
+        printf("tst_pool : Error : %u elements remaining in the pool\n", pool.nbelements);
+    else
+        printf("tst_pool : All elements properly popped from the pool\n");
+
+    free_pool(&pool);
+    empty_array(&arr);
+
+    return 0;
+}
+
+/************************************************************/
+/*  I : Metadata of the list shared between the threads     */
+/*  P : Inserts 1000 datasets in a lock-free list, then     */
+/*          removes the ones with an even ID                */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+static int lockfreelist_worker(void* arg)
+{
+    meta_t* lis = (meta_t*)arg;
+    dataset_t tmp = {0, "", 0.0};
+    int slot = register_lockfree_list(lis);
+
+    if(slot < 0)
+        return -1;
+
+    //each thread inserts the same IDs, to make them compete on every element
+    for(int i = 1 ; i <= 1000 ; i++)
+    {
+        tmp.id = i;
+        insertLockFreeList(lis, slot, &tmp);
+    }
+
+    for(int i = 2 ; i <= 1000 ; i += 2)
+    {
+        tmp.id = i;
+        removeLockFreeList(lis, slot, &tmp);
+    }
+
+    unregister_lockfree_list(lis, slot);
+    return 0;
+}
+
+/************************************************************/
+/*  I : Dataset to check                                    */
+/*      Previous dataset browsed                            */
+/*  P : Checks the dataset is higher than the previous one  */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+static int check_ascending(void* elem, void* previous)
+{
+    dataset_t *A = (dataset_t*)elem, *B = (dataset_t*)previous;
+
+    if(compare_dataset(B, A) >= 0)
+        return -1;
+
+    memcpy(B, A, sizeof(dataset_t));
+    return 0;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the lock-free sorted list with 4 threads  */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_lockfreelist()
+{
+    meta_t lis;
+    thrd_t threads[4];
+    dataset_t previous = {0, "", 0.0}, tmp = {1, "", 0.0};
+    int slot = 0, ret = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/************************* tst_lockfreelist **************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&lis, sizeof(dataset_t), compare_dataset, printError);
+    if(initialise_lockfree_list(&lis) == -1)
+    {
+        fprintf(stderr, "tst_lockfreelist : error while allocating the list\n");
+        return -1;
+    }
+
+    //insert and remove elements concurrently
+    for(int i = 0 ; i < 4 ; i++)
+        thrd_create(&threads[i], lockfreelist_worker, &lis);
+    for(int i = 0 ; i < 4 ; i++)
+        thrd_join(threads[i], NULL);
+
+    //check the list contents
+    slot = register_lockfree_list(&lis);
+    printf("Nb of elements: %u\n", get_lockfree_list_count(&lis));
+    if(foreachLockFreeList(&lis, slot, &previous, check_ascending) < 0 || get_lockfree_list_count(&lis) != 500)
+    {
+        printf("tst_lockfreelist : Error : list not properly built\n");
+        ret = -1;
+    }
+    else if(find_lockfree_listelem(&lis, slot, &tmp, NULL) != 1 || (tmp.id = 2, find_lockfree_listelem(&lis, slot, &tmp, NULL)) != 0)
+    {
+        printf("tst_lockfreelist : Error : search returned wrong results\n");
+        ret = -1;
+    }
+    else
+        printf("tst_lockfreelist : All odd elements kept in ascending order\n");
+
+    unregister_lockfree_list(&lis, slot);
+    free_lockfree_list(&lis);
+
+    return ret;
+}
+
+/************************************************************/
+/*  I : Metadata of the AVL                                 */
+/*      Subtree to check                                    */
+/*      Number of nodes counted so far                      */
+/*  P : Checks the order, heights, balances and subtree     */
+/*          sizes of an AVL                                 */
+/*  O : Height of the subtree                               */
+/*      -1 -> Error                                         */
+/************************************************************/
+static int check_avl(meta_t* meta, dyndata_t* avl, uint32_t* count)
+{
+    uint32_t before = *count;
+    int left = 0, right = 0;
+
+    if(!avl)
+        return 0;
+
+    if(avl->left && (*meta->doCompare)(avl->left->data, avl->data) >= 0)
+        return -1;
+    if(avl->right && (*meta->doCompare)(avl->right->data, avl->data) <= 0)
+        return -1;
+
+    left = check_avl(meta, avl->left, count);
+    right = check_avl(meta, avl->right, count);
+    if(left < 0 || right < 0 || left - right > 1 || right - left > 1)
+        return -1;
+    if(avl->height != 1 + (left > right ? left : right))
+        return -1;
+
+    (*count)++;
+    if(avl->count != *count - before)
+        return -1;
+
+    return avl->height;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the AVL invariants after random inserts   */
+/*          and root removals                               */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_avlintegrity()
+{
+    meta_t arr, avl;
+    uint32_t count = 0;
+    int ret = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/************************* tst_avlintegrity **************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&arr, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&avl, sizeof(dataset_t), compare_dataset, printError);
+    arr.nbelements = 5000;
+
+    //generate 5000 random datasets
+    if(setup_data((dataset_t**)&arr.structure, arr.nbelements) == -1)
+    {
+        fprintf(stderr, "tst_avlintegrity : error while allocating the data\n");
+        return -1;
+    }
+
+    //insert them all, then remove the root until the tree is empty
+    arrayToAVL(&arr, &avl, COPY);
+    while(avl.structure && !ret)
+    {
+        count = 0;
+        if(check_avl(&avl, avl.structure, &count) < 0 || count != avl.nbelements)
+            ret = -1;
+
+        delete_AVL_root(&avl);
+    }
+
+    if(ret)
+        printf("tst_avlintegrity : Error : AVL invariants broken with %u elements left\n", avl.nbelements);
+    else
+        printf("tst_avlintegrity : AVL invariants kept through all insertions and removals\n");
+
+    while(avl.structure)
+        delete_AVL_root(&avl);
+    empty_array(&arr);
+
+    return ret;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the linear-time build of an AVL from a    */
+/*          sorted array and a sorted list                  */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_bulkavl()
+{
+    meta_t arr, lis, avl, avl2;
+    uint32_t count = 0;
+    clock_t start = 0;
+    int ret = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/**************************** tst_bulkavl ****************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&arr, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&lis, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&avl, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&avl2, sizeof(dataset_t), compare_dataset, printError);
+    arr.nbelements = 100000;
+
+    //generate 100000 random datasets and sort them
+    if(setup_data((dataset_t**)&arr.structure, arr.nbelements) == -1)
+    {
+        fprintf(stderr, "tst_bulkavl : error while allocating the data\n");
+        return -1;
+    }
+    quickSortArray(&arr, 0, arr.nbelements-1);
+    arrayToList(&arr, &lis, COPY);
+
+    //build an AVL by inserting the elements one by one
+    start = clock();
+    arrayToAVL(&arr, &avl2, COPY);
+    printf("arrayToAVL : %u elements inserted in %.3f ms\n", avl2.nbelements, (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+
+    //build the same AVL in one pass
+    start = clock();
+    if(sortedArrayToAVL(&arr, &avl, COPY) < 0)
+        ret = -1;
+    printf("sortedArrayToAVL : %u elements built in %.3f ms\n", avl.nbelements, (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+
+    if(!ret && (check_avl(&avl, avl.structure, &count) < 0 || count != avl.nbelements || count != avl2.nbelements))
+        ret = -1;
+
+    //remove all the elements one by one from the block
+    while(avl.structure)
+        delete_AVL_root(&avl);
+
+    //build it again from the list
+    if(!ret && sortedListToAVL(&lis, &avl, REPLACE) < 0)
+        ret = -1;
+
+    count = 0;
+    if(!ret && (check_avl(&avl, avl.structure, &count) < 0 || count != avl2.nbelements))
+        ret = -1;
+
+    if(ret)
+        printf("tst_bulkavl : Error : AVL not properly built\n");
+    else
+        printf("tst_bulkavl : AVL built from sorted array and list, height %d\n", ((dyndata_t*)avl.structure)->height);
+
+    while(avl.structure)
+        delete_AVL_root(&avl);
+    while(avl2.structure)
+        delete_AVL_root(&avl2);
+    empty_array(&arr);
+
+    return ret;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the selection, rank and range count in    */
+/*          an AVL against a linear browsing                */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_orderstatavl()
+{
+    meta_t arr, avl;
+    dataset_t *current = NULL, *previous = NULL, low = {0}, high = {0};
+    uint32_t count = 0, expected = 0;
+    int ret = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/************************* tst_orderstatavl **************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&arr, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&avl, sizeof(dataset_t), compare_dataset, printError);
+    arr.nbelements = 5000;
+
+    //generate 5000 random datasets and insert them in an AVL
+    if(setup_data((dataset_t**)&arr.structure, arr.nbelements) == -1)
+    {
+        fprintf(stderr, "tst_orderstatavl : error while allocating the data\n");
+        return -1;
+    }
+    arrayToAVL(&arr, &avl, COPY);
+
+    //each element selected must be higher than the previous one, and ranked at its position
+    for(uint32_t i = 0 ; i < avl.nbelements && !ret ; i++)
+    {
+        current = select_AVL(&avl, i);
+        if(!current || (previous && compare_dataset(previous, current) >= 0) || rank_AVL(&avl, current) != i)
+            ret = -1;
+
+        previous = current;
+    }
+    if(select_AVL(&avl, avl.nbelements))
+        ret = -1;
+
+    //compare random range counts with a linear browsing
+    for(uint32_t i = 0 ; i < 100 && !ret ; i++)
+    {
+        low.id = rand() % (2 * arr.nbelements) + 1;
+        high.id = low.id + rand() % (arr.nbelements / 2);
+
+        expected = 0;
+        for(uint32_t j = 0 ; j < avl.nbelements ; j++)
+        {
+            current = select_AVL(&avl, j);
+            if(compare_dataset(current, &low) >= 0 && compare_dataset(current, &high) <= 0)
+                expected++;
+        }
+
+        count = count_AVL_range(&avl, &low, &high);
+        if(count != expected)
+            ret = -1;
+    }
+
+    if(ret)
+        printf("tst_orderstatavl : Error : order statistics do not match the AVL content\n");
+    else
+        printf("tst_orderstatavl : select, rank and range count match on %u elements\n", avl.nbelements);
+
+    while(avl.structure)
+        delete_AVL_root(&avl);
+    empty_array(&arr);
+
+    return ret;
+}
+
+/************************************************************/
+/*  I : Element visited                                     */
+/*      Number of elements visited so far                   */
+/*  P : Counts the elements visited, and stops after 10     */
+/*  O :  0 -> Continue                                      */
+/*       1 -> Stop                                          */
+/************************************************************/
+static int count_until_ten(void* elem, void* visited)
+{
+    (void)elem;
+    (*(uint32_t*)visited)++;
+
+    return (*(uint32_t*)visited >= 10);
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the bounds, the iterators and the range   */
+/*          browsing of an AVL                              */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_avliterator()
+{
+    meta_t arr, avl;
+    avliterator_t it;
+    dataset_t *current = NULL, low = {0}, high = {0};
+    uint32_t i = 0, visited = 0;
+    int ret = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/************************** tst_avliterator **************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&arr, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&avl, sizeof(dataset_t), compare_dataset, printError);
+    arr.nbelements = 5000;
+
+    //generate 5000 random datasets and insert them in an AVL
+    if(setup_data((dataset_t**)&arr.structure, arr.nbelements) == -1)
+    {
+        fprintf(stderr, "tst_avliterator : error while allocating the data\n");
+        return -1;
+    }
+    arrayToAVL(&arr, &avl, COPY);
+
+    //browse the AVL forwards, then backwards
+    for(current = first_AVL_iterator(&avl, &it), i = 0 ; current && !ret ; current = next_AVL_iterator(&it), i++)
+        ret = (current != select_AVL(&avl, i) ? -1 : 0);
+    if(i != avl.nbelements)
+        ret = -1;
+
+    for(current = last_AVL_iterator(&avl, &it), i = avl.nbelements ; current && !ret ; current = prev_AVL_iterator(&it), i--)
+        ret = (current != select_AVL(&avl, i - 1) ? -1 : 0);
+    if(i)
+        ret = -1;
+
+    //bounds of existing elements, and moves from there
+    for(i = 0 ; i < avl.nbelements && !ret ; i++)
+    {
+        current = select_AVL(&avl, i);
+        if(lower_bound_AVL(&avl, current, &it) != current || prev_AVL_iterator(&it) != select_AVL(&avl, i - 1))
+            ret = -1;
+        if(upper_bound_AVL(&avl, current, &it) != select_AVL(&avl, i + 1))
+            ret = -1;
+    }
+
+    //bounds of random keys, which are never in the AVL
+    for(i = 0 ; i < 1000 && !ret ; i++)
+    {
+        low.id = rand() % (2 * arr.nbelements + 2);
+        current = select_AVL(&avl, rank_AVL(&avl, &low));
+        if(lower_bound_AVL(&avl, &low, NULL) != current || upper_bound_AVL(&avl, &low, NULL) != current)
+            ret = -1;
+    }
+
+    //browse a whole range, then stop after 10 elements
+    low.id = arr.nbelements / 2;
+    high.id = arr.nbelements;
+    if(!ret && (foreachAVLRange(&avl, &low, &high, &visited, count_until_ten) != 1 || visited != 10))
+        ret = -1;
+
+    visited = 0;
+    high.id = low.id + 2;
+    if(!ret && (foreachAVLRange(&avl, &low, &high, &visited, count_until_ten) != 0 || visited != count_AVL_range(&avl, &low, &high)))
+        ret = -1;
+
+    if(ret)
+        printf("tst_avliterator : Error : AVL browsed in the wrong order\n");
+    else
+        printf("tst_avliterator : AVL browsed both ways, bounds and ranges match\n");
+
+    while(avl.structure)
+        delete_AVL_root(&avl);
+    empty_array(&arr);
+
+    return ret;
+}
+
+/************************************************************/
+/*  I : Element visited                                     */
+/*      Number of elements visited so far                   */
+/*  P : Counts the elements visited                         */
+/*  O :  0 -> Continue                                      */
+/************************************************************/
+static int count_elements(void* elem, void* visited)
+{
+    (void)elem;
+    (*(uint32_t*)visited)++;
+
+    return 0;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the insertion, search, range browsing and */
+/*          removal in a B-tree, compared with an AVL       */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_btree()
+{
+    meta_t arr, avl, btree;
+    dataset_t *data = NULL, previous = {0}, low = {0}, high = {0};
+    uint32_t found = 0, visited = 0, removed = 0;
+    clock_t start = 0;
+    int ret = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/***************************** tst_btree *****************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&arr, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&avl, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&btree, sizeof(dataset_t), compare_dataset, printError);
+    arr.nbelements = 100000;
+
+    //generate 100000 random datasets, and insert them in an AVL and a B-tree
+    if(setup_data((dataset_t**)&arr.structure, arr.nbelements) == -1 || initialise_btree(&btree) < 0)
+    {
+        fprintf(stderr, "tst_btree : error while allocating the data\n");
+        return -1;
+    }
+    data = arr.structure;
+    arrayToAVL(&arr, &avl, COPY);
+    for(uint32_t i = 0 ; i < arr.nbelements && !ret ; i++)
+        ret = (insertBTree(&btree, &data[i]) < 0 ? -1 : 0);
+
+    //both must hold the same elements, in ascending order
+    if(!ret && (btree.nbelements != avl.nbelements || foreachBTree(&btree, &previous, check_ascending) != 0))
+        ret = -1;
+
+    //compare the lookup times
+    start = clock();
+    for(uint32_t i = 0 ; i < arr.nbelements ; i++)
+        found += (search_AVL(&avl, avl.structure, &data[i]) != NULL);
+    printf("search_AVL : %u elements found in %.3f ms\n", found, (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+
+    start = clock();
+    for(uint32_t i = 0 ; i < arr.nbelements ; i++)
+        found -= (search_BTree(&btree, &data[i]) != NULL);
+    printf("search_BTree : %u elements found in %.3f ms (%u levels)\n", arr.nbelements - found, (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC, ((btree_t*)btree.structure)->height);
+    if(found)
+        ret = -1;
+
+    //compare random range counts with the AVL
+    for(uint32_t i = 0 ; i < 100 && !ret ; i++)
+    {
+        low.id = rand() % (2 * arr.nbelements) + 1;
+        high.id = low.id + rand() % 1000;
+
+        visited = 0;
+        if(foreachBTreeRange(&btree, &low, &high, &visited, count_elements) != 0 || visited != count_AVL_range(&avl, &low, &high))
+            ret = -1;
+    }
+
+    //remove every other element, which must not be found anymore
+    for(uint32_t i = 0 ; i < arr.nbelements && !ret ; i += 2)
+    {
+        removed += (removeBTree(&btree, &data[i]) == 1);
+        if(search_BTree(&btree, &data[i]))
+            ret = -1;
+    }
+
+    memset(&previous, 0, sizeof(dataset_t));
+    visited = 0;
+    if(!ret && (btree.nbelements != avl.nbelements - removed || foreachBTree(&btree, &previous, check_ascending) != 0 || foreachBTree(&btree, &visited, count_elements) != 0 || visited != btree.nbelements))
+        ret = -1;
+
+    //remove the rest
+    for(uint32_t i = 1 ; i < arr.nbelements && !ret ; i += 2)
+        removeBTree(&btree, &data[i]);
+    if(!ret && (btree.nbelements || ((btree_t*)btree.structure)->root))
+        ret = -1;
+
+    if(ret)
+        printf("tst_btree : Error : B-tree content differs from the AVL\n");
+    else
+        printf("tst_btree : B-tree matches the AVL through insertions, ranges and removals\n");
+
+    free_btree(&btree);
+    while(avl.structure)
+        delete_AVL_root(&avl);
+    empty_array(&arr);
+
+    return ret;
+}
+
+/********************************************************
+ * @brief Shared state of the concurrent AVL test
+********************************************************/
+typedef struct
+{
+    meta_t*     avl;        ///< AVL shared between the threads
+    atomic_int  done;       ///< Set once the writer is done
+    atomic_int  errors;     ///< Number of inconsistent snapshots read
+    atomic_uint snapshots;  ///< Number of snapshots read
+} cavltest_t;
+
+/********************************************************
+ * @brief State of the browsing of a snapshot
+********************************************************/
+typedef struct
+{
+    dataset_t   previous;   ///< Last element browsed
+    uint32_t    count;      ///< Number of elements browsed
+    int         error;      ///< Set if the elements are not in ascending order
+} snapshotcheck_t;
+
+/************************************************************/
+/*  I : Dataset browsed                                     */
+/*      State of the browsing                               */
+/*  P : Checks the order of the datasets and counts them    */
+/*  O :  0 -> Success                                       */
+/************************************************************/
+static int check_snapshot(void* elem, void* check)
+{
+    snapshotcheck_t* state = (snapshotcheck_t*)check;
+
+    if(compare_dataset(&state->previous, elem) >= 0)
+        state->error = 1;
+
+    memcpy(&state->previous, elem, sizeof(dataset_t));
+    state->count++;
+
+    return 0;
+}
+
+/************************************************************/
+/*  I : Shared state of the test                            */
+/*  P : Inserts 2000 datasets in a concurrent AVL, then     */
+/*          removes the ones with an even ID                */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+static int concurrentavl_writer(void* arg)
+{
+    cavltest_t* test = (cavltest_t*)arg;
+    dataset_t tmp = {0, "", 0.0};
+    int slot = register_concurrent_AVL(test->avl);
+
+    if(slot < 0)
+        return -1;
+
+    for(int i = 1 ; i <= 2000 ; i++)
+    {
+        tmp.id = (i * 7919) % 2000 + 1;
+        insertConcurrentAVL(test->avl, slot, &tmp);
+    }
+
+    for(int i = 2 ; i <= 2000 ; i += 2)
+    {
+        tmp.id = i;
+        removeConcurrentAVL(test->avl, slot, &tmp);
+    }
+
+    unregister_concurrent_AVL(test->avl, slot);
+    atomic_store(&test->done, 1);
+    return 0;
+}
+
+/************************************************************/
+/*  I : Shared state of the test                            */
+/*  P : Browses snapshots of a concurrent AVL until the     */
+/*          writer is done, checking their consistency      */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+static int concurrentavl_reader(void* arg)
+{
+    cavltest_t* test = (cavltest_t*)arg;
+    snapshotcheck_t check;
+    dyndata_t* root = NULL;
+    int slot = register_concurrent_AVL(test->avl);
+
+    if(slot < 0)
+        return -1;
+
+    while(!atomic_load(&test->done))
+    {
+        //the snapshot must be sorted and hold as many elements as its root says
+        memset(&check, 0, sizeof(snapshotcheck_t));
+        root = enter_concurrent_AVL(test->avl, slot);
+        foreachAVL(test->avl, root, &check, check_snapshot);
+        if(check.error || check.count != (root ? root->count : 0))
+            atomic_fetch_add(&test->errors, 1);
+        exit_concurrent_AVL(test->avl, slot);
+
+        atomic_fetch_add(&test->snapshots, 1);
+    }
+
+    unregister_concurrent_AVL(test->avl, slot);
+    return 0;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the concurrent AVL with 1 writer and      */
+/*          4 readers                                       */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_concurrentavl()
+{
+    meta_t avl;
+    cavltest_t test;
+    thrd_t threads[5];
+    dataset_t tmp = {1, "", 0.0};
+    int slot = 0, ret = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/************************ tst_concurrentavl **************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&avl, sizeof(dataset_t), compare_dataset, printError);
+    if(initialise_concurrent_AVL(&avl) == -1)
+    {
+        fprintf(stderr, "tst_concurrentavl : error while allocating the AVL\n");
+        return -1;
+    }
+
+    test.avl = &avl;
+    atomic_init(&test.done, 0);
+    atomic_init(&test.errors, 0);
+    atomic_init(&test.snapshots, 0);
+
+    //write while reading snapshots
+    for(int i = 1 ; i < 5 ; i++)
+        thrd_create(&threads[i], concurrentavl_reader, &test);
+    thrd_create(&threads[0], concurrentavl_writer, &test);
+    for(int i = 0 ; i < 5 ; i++)
+        thrd_join(threads[i], NULL);
+
+    //check the final version
+    slot = register_concurrent_AVL(&avl);
+    printf("%u snapshots read, %u elements left\n", atomic_load(&test.snapshots), get_concurrent_AVL_count(&avl, slot));
+    if(atomic_load(&test.errors) || get_concurrent_AVL_count(&avl, slot) != 1000 || avl.nbelements != 1000)
+    {
+        printf("tst_concurrentavl : Error : inconsistent snapshot read\n");
+        ret = -1;
+    }
+    else if(search_concurrent_AVL(&avl, slot, &tmp, NULL) != 1 || (tmp.id = 2, search_concurrent_AVL(&avl, slot, &tmp, NULL)) != 0)
+    {
+        printf("tst_concurrentavl : Error : search returned wrong results\n");
+        ret = -1;
+    }
+    else
+        printf("tst_concurrentavl : All snapshots consistent, odd elements kept\n");
+
+    unregister_concurrent_AVL(&avl, slot);
+    free_concurrent_AVL(&avl);
+
+    return ret;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the snapshots of a persistent AVL while   */
+/*          inserting and removing elements                 */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_persistentavl()
+{
+    meta_t avl;
+    pavlnode_t* versions[10] = {0};
+    snapshotcheck_t check;
+    dataset_t tmp = {0, "", 0.0};
+    int ret = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/************************ tst_persistentavl **************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&avl, sizeof(dataset_t), compare_dataset, printError);
+
+    //insert 1000 IDs, taking a snapshot every 100 elements
+    for(int i = 1 ; i <= 1000 && !ret ; i++)
+    {
+        tmp.id = (i * 7919) % 1000 + 1;
+        if(insertPersistentAVL(&avl, &tmp) != 0)
+            ret = -1;
+
+        if(!(i % 100))
+            versions[i / 100 - 1] = snapshot_persistent_AVL(&avl);
+    }
+
+    //remove the even IDs from the current version only
+    for(int i = 2 ; i <= 1000 && !ret ; i += 2)
+    {
+        tmp.id = i;
+        if(removePersistentAVL(&avl, &tmp) != 1 || search_persistent_AVL(&avl, avl.structure, &tmp))
+            ret = -1;
+    }
+
+    //each snapshot must still be sorted and hold the elements it had
+    for(int i = 0 ; i < 10 && !ret ; i++)
+    {
+        memset(&check, 0, sizeof(snapshotcheck_t));
+        foreachPersistentAVL(&avl, versions[i], &check, check_snapshot);
+        if(check.error || check.count != (uint32_t)(i + 1) * 100 || get_persistent_AVL_count(versions[i]) != check.count)
+            ret = -1;
+    }
+
+    memset(&check, 0, sizeof(snapshotcheck_t));
+    foreachPersistentAVL(&avl, avl.structure, &check, check_snapshot);
+    tmp.id = 2;
+    if(check.error || check.count != 500 || avl.nbelements != 500 || !search_persistent_AVL(&avl, versions[9], &tmp))
+        ret = -1;
+
+    if(ret)
+        printf("tst_persistentavl : Error : snapshot modified by the updates\n");
+    else
+        printf("tst_persistentavl : 10 snapshots kept intact through 1500 updates\n");
+
+    for(int i = 0 ; i < 10 ; i++)
+        release_persistent_AVL(versions[i]);
+    free_persistent_AVL(&avl);
+
+    return ret;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the removal of single keys, of a sorted   */
+/*          set of keys and of a range of keys in an AVL    */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_batchdeleteavl()
+{
+    meta_t arr, avl, avl2;
+    dataset_t *keys = NULL, low = {0}, high = {0};
+    uint32_t nbkeys = 0, count = 0, expected = 0;
+    clock_t start = 0;
+    int ret = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/************************ tst_batchdeleteavl *************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&arr, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&avl, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&avl2, sizeof(dataset_t), compare_dataset, printError);
+    arr.nbelements = 100000;
+
+    //generate 100000 random datasets, and insert them in two AVLs
+    if(setup_data((dataset_t**)&arr.structure, arr.nbelements) == -1)
+    {
+        fprintf(stderr, "tst_batchdeleteavl : error while allocating the data\n");
+        return -1;
+    }
+    arrayToAVL(&arr, &avl, COPY);
+    arrayToAVL(&arr, &avl2, COPY);
+
+    //pick 10% of the elements, in ascending order
+    keys = calloc(avl.nbelements / 10 + 1, sizeof(dataset_t));
+    if(!keys)
+    {
+        fprintf(stderr, "tst_batchdeleteavl : error while allocating the keys\n");
+        return -1;
+    }
+    for(uint32_t i = 0 ; i < avl.nbelements ; i += 10)
+        memcpy(&keys[nbkeys++], select_AVL(&avl, i), sizeof(dataset_t));
+
+    //remove them one by one, then in a single traversal
+    start = clock();
+    for(uint32_t i = 0 ; i < nbkeys && !ret ; i++)
+        ret = (delete_AVL_key(&avl2, &keys[i]) != 1 ? -1 : 0);
+    printf("delete_AVL_key : %u elements removed in %.3f ms\n", nbkeys, (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+
+    expected = avl.nbelements - nbkeys;
+    start = clock();
+    if(delete_AVL_keys(&avl, keys, nbkeys) != nbkeys)
+        ret = -1;
+    printf("delete_AVL_keys : %u elements removed in %.3f ms\n", nbkeys, (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+
+    //both AVLs must be valid, without the keys
+    if(!ret && (check_avl(&avl, avl.structure, &count) < 0 || count != expected || avl2.nbelements != expected))
+        ret = -1;
+    count = 0;
+    if(!ret && (check_avl(&avl2, avl2.structure, &count) < 0 || count != expected))
+        ret = -1;
+    for(uint32_t i = 0 ; i < nbkeys && !ret ; i++)
+        ret = (search_AVL(&avl, avl.structure, &keys[i]) || delete_AVL_key(&avl, &keys[i]) != 0 ? -1 : 0);
+
+    //remove a range of keys
+    low.id = arr.nbelements / 2;
+    high.id = arr.nbelements;
+    expected = count_AVL_range(&avl, &low, &high);
+    if(!ret && (delete_AVL_range(&avl, &low, &high) != expected || count_AVL_range(&avl, &low, &high)))
+        ret = -1;
+    count = 0;
+    if(!ret && (check_avl(&avl, avl.structure, &count) < 0 || count != avl.nbelements))
+        ret = -1;
+
+    if(ret)
+        printf("tst_batchdeleteavl : Error : wrong elements removed\n");
+    else
+        printf("tst_batchdeleteavl : keys removed one by one, in batch and by range\n");
+
+    while(avl.structure)
+        delete_AVL_root(&avl);
+    while(avl2.structure)
+        delete_AVL_root(&avl2);
+    free(keys);
+    empty_array(&arr);
+
+    return ret;
+}
+
+/************************************************************/
+/*  I : AVL to fill                                         */
+/*      Step between the IDs                                */
+/*      Highest ID                                          */
+/*  P : Fills an AVL with all the multiples of step         */
+/*  O : /                                                   */
+/************************************************************/
+static void fill_multiples(meta_t* avl, int step, int max)
+{
+    dataset_t tmp = {0, "", 0.0};
+
+    for(tmp.id = step ; tmp.id <= max ; tmp.id += step)
+        avl->structure = insertAVL(avl, avl->structure, &tmp);
+}
+
+/************************************************************/
+/*  I : AVL to check                                        */
+/*      Step of the IDs expected (0 if none)                */
+/*      Step of the IDs excluded (0 if none)                */
+/*      Highest ID                                          */
+/*  P : Checks an AVL holds exactly the multiples expected  */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+static int check_multiples(meta_t* avl, int step, int excluded, int max)
+{
+    dataset_t tmp = {0, "", 0.0};
+    uint32_t count = 0, expected = 0;
+    int in = 0;
+
+    if(check_avl(avl, avl->structure, &count) < 0 || count != avl->nbelements)
+        return -1;
+
+    for(tmp.id = 1 ; tmp.id <= max ; tmp.id++)
+    {
+        in = (!(tmp.id % step) && (!excluded || tmp.id % excluded));
+        expected += in;
+        if(in != (search_AVL(avl, avl->structure, &tmp) != NULL))
+            return -1;
+    }
+
+    return (count == expected ? 0 : -1);
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the split, join, union, intersection and  */
+/*          difference of AVLs                              */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_setopsavl()
+{
+    meta_t a, b;
+    dataset_t key = {5001, "", 0.0};
+    dyndata_t *left = NULL, *right = NULL, *middle = NULL;
+    uint32_t count = 0;
+    int ret = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/*************************** tst_setopsavl ***************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&a, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&b, sizeof(dataset_t), compare_dataset, printError);
+
+    //split the multiples of 1 around 5001, check both sides, then join them back
+    fill_multiples(&a, 1, 10000);
+    middle = split_AVL(&a, a.structure, &key, &left, &right);
+    if(!middle || check_avl(&a, left, &count) < 0 || count != 5000 || compare_dataset(middle->data, &key))
+        ret = -1;
+    if(!ret && (middle->left || middle->right || middle->height != 1 || middle->count != 1))
+        ret = -1;
+    count = 0;
+    if(!ret && (check_avl(&a, right, &count) < 0 || count != 4999))
+        ret = -1;
+    a.structure = join_AVL(left, middle, right);
+    if(!ret && check_multiples(&a, 1, 0, 10000) < 0)
+        ret = -1;
+    while(a.structure)
+        delete_AVL_root(&a);
+
+    //multiples of 2 and of 3
+    fill_multiples(&a, 2, 10000);
+    fill_multiples(&b, 3, 10000);
+    count = 0;
+    if(!ret && (unionAVL(&a, &b) < 0 || b.structure || check_avl(&a, a.structure, &count) < 0 || count != 6667 || a.nbelements != count))
+        ret = -1;
+    for(key.id = 1 ; key.id <= 10000 && !ret ; key.id++)
+        ret = ((!(key.id % 2) || !(key.id % 3)) != (search_AVL(&a, a.structure, &key) != NULL) ? -1 : 0);
+    while(a.structure)
+        delete_AVL_root(&a);
+
+    //multiples of 6
+    fill_multiples(&a, 2, 10000);
+    fill_multiples(&b, 3, 10000);
+    if(!ret && (intersectAVL(&a, &b) < 0 || b.structure || check_multiples(&a, 6, 0, 10000) < 0))
+        ret = -1;
+    while(a.structure)
+        delete_AVL_root(&a);
+
+    //multiples of 2 but not of 3
+    fill_multiples(&a, 2, 10000);
+    fill_multiples(&b, 3, 10000);
+    if(!ret && (differenceAVL(&a, &b) < 0 || b.structure || check_multiples(&a, 2, 3, 10000) < 0))
+        ret = -1;
+
+    if(ret)
+        printf("tst_setopsavl : Error : wrong elements after a set operation\n");
+    else
+        printf("tst_setopsavl : split, join, union, intersection and difference verified\n");
+
+    while(a.structure)
+        delete_AVL_root(&a);
+    while(b.structure)
+        delete_AVL_root(&b);
+
+    return ret;
+}
+
+/************************************************************/
+/*  I : Existing element                                    */
+/*      Element merged into it                              */
+/*  P : Adds the price of an element to the existing one    */
+/*  O :  0 -> Success                                       */
+/************************************************************/
+static int sum_prices(void* existing, const void* toAdd)
+{
+    ((dataset_t*)existing)->price += ((const dataset_t*)toAdd)->price;
+    return 0;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the upsert and the multiset mode of AVLs  */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_upsertavl()
+{
+    meta_t avl, multiset;
+    dataset_t tmp = {0, "", 1.0};
+    dataset_t* found = NULL;
+    uint32_t occurrences[200] = {0}, count = 0;
+    int ret = 0, existed = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/*************************** tst_upsertavl ***************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&avl, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&multiset, sizeof(dataset_t), compare_dataset, printError);
+
+    //draw 5000 IDs among 200, and check each call tells whether the ID was already drawn
+    for(int i = 0 ; i < 5000 && !ret ; i++)
+    {
+        tmp.id = rand() % 200;
+        existed = (occurrences[tmp.id]++ != 0);
+        if(upsertAVL(&avl, &tmp, sum_prices) != existed || insertMultisetAVL(&multiset, &tmp) != existed)
+            ret = -1;
+    }
+
+    //each ID is kept once, with the number of times it was drawn
+    if(!ret && (check_avl(&avl, avl.structure, &count) < 0 || count != avl.nbelements || multiset.nbelements != avl.nbelements))
+        ret = -1;
+    for(tmp.id = 0 ; tmp.id < 200 && !ret ; tmp.id++)
+    {
+        found = search_AVL(&avl, avl.structure, &tmp);
+        if(get_AVL_multiplicity(&multiset, &tmp) != occurrences[tmp.id] || (found ? (uint32_t)found->price : 0) != occurrences[tmp.id])
+            ret = -1;
+    }
+
+    //last writer wins without merge function
+    tmp.id = ((dataset_t*)select_AVL(&avl, 0))->id;
+    tmp.price = -1.0;
+    found = search_AVL(&avl, avl.structure, &tmp);
+    if(!ret && (upsertAVL(&avl, &tmp, NULL) != 1 || !found || found->price != -1.0f))
+        ret = -1;
+
+    //multiset calls are rejected on an AVL filled without them
+    count = avl.nbelements;
+    if(!ret && (get_AVL_multiplicity(&avl, &tmp) || removeMultisetAVL(&avl, &tmp) != -1 || insertMultisetAVL(&avl, &tmp) != -1 || avl.nbelements != count))
+        ret = -1;
+
+    //remove all the occurrences of each ID, one at a time
+    for(tmp.id = 0 ; tmp.id < 200 && !ret ; tmp.id++)
+    {
+        for( ; occurrences[tmp.id] && !ret ; occurrences[tmp.id]--)
+            ret = (removeMultisetAVL(&multiset, &tmp) == 1 ? 0 : -1);
+
+        if(!ret && (removeMultisetAVL(&multiset, &tmp) != 0 || get_AVL_multiplicity(&multiset, &tmp)))
+            ret = -1;
+    }
+    if(!ret && multiset.structure)
+        ret = -1;
+
+    if(ret)
+        printf("tst_upsertavl : Error : wrong element or number of occurrences\n");
+    else
+        printf("tst_upsertavl : upserts and multiset occurrences verified\n");
+
+    while(avl.structure)
+        delete_AVL_root(&avl);
+    while(multiset.structure)
+        delete_AVL_root(&multiset);
+
+    return ret;
+}
+
+/********************************************************
+ * @brief Partial result checking the order of a reduction
+********************************************************/
+typedef struct
+{
+    int         first;  ///< Lowest ID accumulated
+    int         last;   ///< Highest ID accumulated
+    uint32_t    count;  ///< Number of IDs accumulated
+    int         sorted; ///< 1 if the IDs were accumulated in ascending order
+} orderedsum_t;
+
+/************************************************************/
+/*  I : Element to accumulate                               */
+/*      Partial result                                      */
+/*  P : Accumulates an ID, checking it follows the last one */
+/*  O :  0 -> Success                                       */
+/************************************************************/
+static int accumulate_ordered(void* elem, void* partial)
+{
+    orderedsum_t* sum = (orderedsum_t*)partial;
+    int id = ((dataset_t*)elem)->id;
+
+    if(!sum->count)
+        sum->first = id;
+    else if(id <= sum->last)
+        sum->sorted = 0;
+
+    sum->last = id;
+    sum->count++;
+    return 0;
+}
+
+/************************************************************/
+/*  I : Final result                                        */
+/*      Partial result to combine                           */
+/*  P : Appends a partial result, checking the order        */
+/*  O :  0 -> Success                                       */
+/************************************************************/
+static int combine_ordered(void* result, const void* partial)
+{
+    orderedsum_t* sum = (orderedsum_t*)result;
+    const orderedsum_t* part = (const orderedsum_t*)partial;
+
+    if(!part->count)
+        return 0;
+
+    if(!sum->count)
+        sum->first = part->first;
+    else if(part->first <= sum->last)
+        sum->sorted = 0;
+
+    sum->sorted &= part->sorted;
+    sum->last = part->last;
+    sum->count += part->count;
+    return 0;
+}
+
+/************************************************************/
+/*  I : Element visited                                     */
+/*      Atomic counter of the elements visited              */
+/*  P : Counts the elements visited, and stops at ID 5000   */
+/*  O :  0 -> Continue                                      */
+/*       1 -> ID 5000 reached                               */
+/************************************************************/
+static int count_parallel(void* elem, void* visited)
+{
+    atomic_fetch_add((atomic_uint*)visited, 1);
+    return (((dataset_t*)elem)->id == 5000);
+}
+
+/************************************************************/
+/*  I : Atomic flag releasing the task                      */
+/*  P : Holds a worker until released, then fails           */
+/*  O : -1 -> Error                                         */
+/************************************************************/
+static int held_task(void* released)
+{
+    while(!atomic_load((atomic_bool*)released))
+        thrd_yield();
+
+    return -1;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the parallel foreach and reduction of     */
+/*          AVLs                                            */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_parallelavl()
+{
+    meta_t avl;
+    scheduler_t scheduler;
+    orderedsum_t sum = {0, 0, 0, 1};
+    atomic_uint visited;
+    atomic_bool released;
+    int ret = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/************************** tst_parallelavl **************************/\n");
+    printf("/*********************************************************************/\n");
+
+    if(initialise_scheduler(&scheduler, 3, printError) < 0)
+    {
+        printf("tst_parallelavl : Error : scheduler could not be initialised\n");
+        return -1;
+    }
+    initialise_structure(&avl, sizeof(dataset_t), compare_dataset, printError);
+
+    //an empty AVL reduces to the neutral element
+    if(reduceAVLParallel(&avl, &scheduler, &sum, sizeof(sum), accumulate_ordered, combine_ordered) || sum.count)
+        ret = -1;
+
+    //the partial results must be combined in ascending order, with or without workers
+    fill_multiples(&avl, 1, 100000);
+    if(!ret && (reduceAVLParallel(&avl, &scheduler, &sum, sizeof(sum), accumulate_ordered, combine_ordered) || !sum.sorted || sum.count != 100000 || sum.first != 1 || sum.last != 100000))
+        ret = -1;
+    sum = (orderedsum_t){0, 0, 0, 1};
+    if(!ret && (reduceAVLParallel(&avl, NULL, &sum, sizeof(sum), accumulate_ordered, combine_ordered) || !sum.sorted || sum.count != 100000 || sum.first != 1 || sum.last != 100000))
+        ret = -1;
+
+    //every element is visited once, the workers being reused from one traversal to the next
+    atomic_init(&visited, 0);
+    if(!ret && (foreachAVLParallel(&avl, &scheduler, &visited, count_parallel) != 1))
+        ret = -1;
+    atomic_init(&visited, 0);
+    if(!ret && (delete_AVL_key(&avl, &(dataset_t){5000, "", 0.0}) != 1 || foreachAVLParallel(&avl, &scheduler, &visited, count_parallel) || atomic_load(&visited) != 99999))
+        ret = -1;
+
+    //a traversal neither waits for the other tasks of the scheduler, nor swallows their failure
+    atomic_init(&released, false);
+    atomic_init(&visited, 0);
+    if(!ret && submit_scheduler(&scheduler, held_task, &released) < 0)
+        ret = -1;
+    if(!ret && (foreachAVLParallel(&avl, &scheduler, &visited, count_parallel) || atomic_load(&visited) != 99999))
+        ret = -1;
+    atomic_store(&released, true);
+    if(wait_scheduler(&scheduler) != -1)
+        ret = -1;
+
+    if(ret)
+        printf("tst_parallelavl : Error : wrong elements visited or reduced\n");
+    else
+        printf("tst_parallelavl : parallel traversal and ordered reduction verified\n");
+
+    while(avl.structure)
+        delete_AVL_root(&avl);
+    free_scheduler(&scheduler);
+
+    return ret;
+}
+
+/************************************************************/
+/*  I : Metadata of the tree                                */
+/*      Subtree to check                                    */
+/*      Number of elements counted so far                   */
+/*  P : Checks the order of a red-black subtree, and counts */
+/*          its elements                                    */
+/*  O : Height of the subtree                               */
+/*      -1 -> Error                                         */
+/************************************************************/
+static int check_rbt(meta_t* meta, dyndata_t* rbt, uint32_t* count)
+{
+    int left = 0, right = 0;
+
+    if(!rbt)
+        return 0;
+
+    if(rbt->left && (*meta->doCompare)(rbt->left->data, rbt->data) >= 0)
+        return -1;
+    if(rbt->right && (*meta->doCompare)(rbt->right->data, rbt->data) <= 0)
+        return -1;
+
+    left = check_rbt(meta, rbt->left, count);
+    right = check_rbt(meta, rbt->right, count);
+    if(left < 0 || right < 0)
+        return -1;
+
+    (*count)++;
+    return 1 + (left > right ? left : right);
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the insertion and removal in red-black    */
+/*          trees                                           */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_rbtree()
+{
+    meta_t rbt;
+    dataset_t tmp = {0, "", 0.0};
+    uint8_t present[4096] = {0};
+    uint32_t count = 0, bound = 0;
+    int ret = 0, height = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/***************************** tst_rbtree ****************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&rbt, sizeof(dataset_t), compare_dataset, printError);
+
+    //mixed random insertions and removals
+    for(int i = 0 ; i < 100000 && !ret ; i++)
+    {
+        tmp.id = rand() % 4096;
+        if(rand() % 2)
+        {
+            rbt.structure = insertRBT(&rbt, rbt.structure, &tmp);
+            present[tmp.id] = 1;
+        }
+        else
+        {
+            ret = (delete_RBT_key(&rbt, &tmp) == present[tmp.id] ? 0 : -1);
+            present[tmp.id] = 0;
+        }
+    }
+
+    //elements ordered, and height within 2 * log2(n + 1)
+    height = check_rbt(&rbt, rbt.structure, &count);
+    while((1U << bound) <= count)
+        bound++;
+    if(!ret && (height < 0 || count != rbt.nbelements || (uint32_t)height > 2 * bound))
+        ret = -1;
+    for(tmp.id = 0 ; tmp.id < 4096 && !ret ; tmp.id++)
+        ret = (present[tmp.id] != (search_RBT(&rbt, rbt.structure, &tmp) != NULL) ? -1 : 0);
+
+    if(ret)
+        printf("tst_rbtree : Error : wrong elements or height after random updates\n");
+    else
+        printf("tst_rbtree : %u elements ordered, height %d\n", count, height);
+
+    while(rbt.structure)
+        delete_RBT_root(&rbt);
+
+    return ret;
+}
+
+/************************************************************/
+/*  I : Metadata of the splay tree                          */
+/*      Key to look for                                     */
+/*  P : Computes the depth of a key without splaying        */
+/*  O : Number of nodes browsed to reach the key            */
+/************************************************************/
+static uint32_t splay_depth(meta_t* meta, const void* key)
+{
+    dyndata_t* cur = meta->structure;
+    uint32_t depth = 1;
+    int cmp = 0;
+
+    while(cur && (cmp = compare_dataset(cur->data, key)) != 0)
+    {
+        cur = (cmp < 0 ? cur->right : cur->left);
+        depth++;
+    }
+
+    return depth;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the splay trees on a sorted insertion and */
+/*          skewed accesses                                 */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_splaytree()
+{
+    meta_t splay;
+    dataset_t tmp = {0, "", 0.0}, previous = {-1, "", 0.0};
+    uint32_t deepest = 0, depth = 0;
+    int ret = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/**************************** tst_splaytree **************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&splay, sizeof(dataset_t), compare_dataset, printError);
+
+    //sorted insertion (degenerates into a chain), browsed without recursion
+    for(tmp.id = 0 ; tmp.id < 100000 && !ret ; tmp.id++)
+        ret = (insertSplay(&splay, &tmp) ? -1 : 0);
+    if(!ret && (insertSplay(&splay, &(dataset_t){5, "", 0.0}) != 1 || splay.nbelements != 100000 || foreachSplay(&splay, &previous, check_ascending)))
+        ret = -1;
+
+    //90% of the accesses on 8 hot keys, the rest spread over the tree
+    for(int i = 0 ; i < 100000 && !ret ; i++)
+    {
+        tmp.id = (rand() % 10 ? (rand() % 8) * 12345 : rand() % 100000);
+        if(!search_Splay(&splay, &tmp) || compare_dataset(((dyndata_t*)splay.structure)->data, &tmp))
+            ret = -1;
+    }
+
+    //the hot keys stay a few nodes away from the root
+    for(tmp.id = 0 ; tmp.id < 8 * 12345 && !ret ; tmp.id += 12345)
+    {
+        depth = splay_depth(&splay, &tmp);
+        deepest = (depth > deepest ? depth : deepest);
+    }
+    if(!ret && deepest > 24)
+        ret = -1;
+
+    //remove the even IDs, then check the odd ones are left
+    for(tmp.id = 0 ; tmp.id < 100000 && !ret ; tmp.id += 2)
+        ret = (delete_Splay_key(&splay, &tmp) == 1 ? 0 : -1);
+    for(tmp.id = 0 ; tmp.id < 100000 && !ret ; tmp.id++)
+        ret = ((search_Splay(&splay, &tmp) != NULL) != (tmp.id % 2) ? -1 : 0);
+    if(!ret && splay.nbelements != 50000)
+        ret = -1;
+
+    if(ret)
+        printf("tst_splaytree : Error : wrong elements or hot keys too deep\n");
+    else
+        printf("tst_splaytree : hot keys within %u nodes from the root\n", deepest);
+
+    while(splay.structure)
+        delete_Splay_root(&splay);
+
+    return ret;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the ring queues, wrapping around and      */
+/*          growing while wrapped                           */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_ringqueue()
+{
+    meta_t queue;
+    dataset_t tmp = {0, "", 0.0}, popped = {0, "", 0.0}, previous = {-1, "", 0.0};
+    int ret = 0, pushed = 0, expected = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/**************************** tst_ringqueue **************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&queue, sizeof(dataset_t), compare_dataset, printError);
+    if(initialise_ring_queue(&queue, 3) < 0)
+    {
+        printf("tst_ringqueue : Error : queue could not be initialised\n");
+        return -1;
+    }
+
+    //push 3 and pop 2 at a time, so the head keeps moving while the buffer grows
+    for(int i = 0 ; i < 20000 && !ret ; i++)
+    {
+        for(int j = 0 ; j < 3 && !ret ; j++)
+        {
+            tmp.id = pushed++;
+            ret = pushRingQueue(&queue, &tmp);
+        }
+
+        for(int j = 0 ; j < 2 && !ret ; j++)
+            ret = (popRingQueue(&queue, &popped) == 1 && popped.id == expected++ ? 0 : -1);
+    }
+
+    //the remaining elements are in order, then the queue empties
+    if(!ret && (queue.nbelements != 20000 || ((dataset_t*)get_ringelem(&queue, 0))->id != expected || get_ringelem(&queue, 20000)))
+        ret = -1;
+    if(!ret && foreachRingQueue(&queue, &previous, check_ascending) < 0)
+        ret = -1;
+    while(!ret && queue.nbelements)
+        ret = (popRingQueue(&queue, &popped) == 1 && popped.id == expected++ ? 0 : -1);
+    if(!ret && (popRingQueue(&queue, &popped) != 0 || expected != pushed))
+        ret = -1;
+
+    if(ret)
+        printf("tst_ringqueue : Error : elements popped out of order\n");
+    else
+        printf("tst_ringqueue : %d elements pushed and popped in order\n", pushed);
+
+    free_ring_queue(&queue);
+    return ret;
+}
+
+/************************************************************/
+/*  I : SPSC queue to fill                                  */
+/*  P : Pushes 1000000 increasing IDs, in batches of 1 to   */
+/*          16 elements                                     */
+/*  O :  0 -> Success                                       */
+/************************************************************/
+static int spscqueue_producer(void* arg)
+{
+    meta_t* queue = (meta_t*)arg;
+    dataset_t batch[16] = {0};
+    uint32_t nb = 0, pushed = 0;
+    int next = 0;
+
+    while(next < 1000000)
+    {
+        //prepare a batch, then push it until the consumer made room for all of it
+        nb = 1 + (uint32_t)(next % 16);
+        if(next + (int)nb > 1000000)
+            nb = (uint32_t)(1000000 - next);
+        for(uint32_t i = 0 ; i < nb ; i++)
+            batch[i].id = next + (int)i;
+
+        pushed = 0;
+        while(pushed < nb)
+        {
+            if(nb == 1)
+                pushed += !pushSPSCQueue(queue, &batch[0]);
+            else
+                pushed += pushSPSCQueueBatch(queue, &batch[pushed], nb - pushed);
+
+            if(pushed < nb)
+                thrd_yield();
+        }
+
+        next += (int)nb;
+    }
+
+    return 0;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the SPSC queues between two threads       */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_spscqueue()
+{
+    meta_t queue;
+    thrd_t producer;
+    dataset_t popped[8] = {0};
+    uint32_t nb = 0;
+    int ret = 0, expected = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/**************************** tst_spscqueue **************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&queue, sizeof(dataset_t), compare_dataset, printError);
+    if(initialise_SPSC_queue(&queue, 1000) < 0)
+    {
+        printf("tst_spscqueue : Error : queue could not be initialised\n");
+        return -1;
+    }
+
+    //pop the IDs one by one or by batches, while they are pushed (until the end, so the producer never blocks)
+    thrd_create(&producer, spscqueue_producer, &queue);
+    while(expected < 1000000)
+    {
+        nb = (expected % 3 ? popSPSCQueueBatch(&queue, popped, 8) : (uint32_t)popSPSCQueue(&queue, popped));
+        if(!nb)
+            thrd_yield();
+
+        for(uint32_t i = 0 ; i < nb ; i++)
+            ret |= (popped[i].id == expected++ ? 0 : -1);
+    }
+    thrd_join(producer, NULL);
+
+    if(!ret && (popSPSCQueue(&queue, popped) != 0 || get_SPSC_queue_count(&queue)))
+        ret = -1;
+
+    if(ret)
+        printf("tst_spscqueue : Error : elements popped out of order\n");
+    else
+        printf("tst_spscqueue : %d elements passed between two threads in order\n", expected);
+
+    free_SPSC_queue(&queue);
+    return ret;
+}
+
+/********************************************************
+ * @brief Thread of the MPMC queue test
+********************************************************/
+typedef struct
+{
+    meta_t*     queue;      ///< Queue shared by the threads
+    int         index;      ///< Index of the thread among the producers (or consumers)
+    int         errors;     ///< Number of elements popped out of order
+    long long   sum;        ///< Sum of the IDs popped
+} mpmctest_t;
+
+/************************************************************/
+/*  I : Test thread                                         */
+/*  P : Pushes 50000 increasing IDs, tagged with the        */
+/*          producer index (blocking or not, by parity)     */
+/*  O :  0 -> Success                                       */
+/************************************************************/
+static int mpmcqueue_producer(void* arg)
+{
+    mpmctest_t* test = (mpmctest_t*)arg;
+    dataset_t tmp = {0, "", 0.0};
+
+    for(int i = 0 ; i < 50000 ; i++)
+    {
+        tmp.id = (test->index * 100000) + i;
+        if(test->index % 2)
+            pushMPMCQueue(test->queue, &tmp);
+        else
+        {
+            while(tryPushMPMCQueue(test->queue, &tmp))
+                thrd_yield();
+        }
+    }
+
+    return 0;
+}
+
+/************************************************************/
+/*  I : Test thread                                         */
+/*  P : Pops 50000 IDs, checking the ones of each producer  */
+/*          come in order (blocking or not, by parity)      */
+/*  O :  0 -> Success                                       */
+/************************************************************/
+static int mpmcqueue_consumer(void* arg)
+{
+    mpmctest_t* test = (mpmctest_t*)arg;
+    dataset_t tmp = {0, "", 0.0};
+    int last[4] = {-1, -1, -1, -1}, producer = 0;
+
+    for(int i = 0 ; i < 50000 ; i++)
+    {
+        if(test->index % 2)
+            popMPMCQueue(test->queue, &tmp);
+        else
+        {
+            while(!tryPopMPMCQueue(test->queue, &tmp))
+                thrd_yield();
+        }
+
+        producer = tmp.id / 100000;
+        if(producer > 3 || tmp.id % 100000 <= last[producer])
+            test->errors++;
+        else
+            last[producer] = tmp.id % 100000;
+
+        test->sum += tmp.id;
+    }
+
+    return 0;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the MPMC queues with 4 producers and 4    */
+/*          consumers                                       */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_mpmcqueue()
+{
+    meta_t queue;
+    mpmctest_t producers[4], consumers[4];
+    thrd_t threads[8];
+    long long sum = 0, expected = 0;
+    int ret = 0, errors = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/**************************** tst_mpmcqueue **************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&queue, sizeof(dataset_t), compare_dataset, printError);
+    if(initialise_MPMC_queue(&queue, 64) < 0)
+    {
+        printf("tst_mpmcqueue : Error : queue could not be initialised\n");
+        return -1;
+    }
+
+    //a small queue, so the producers and consumers keep finding it full or empty
+    for(int i = 0 ; i < 4 ; i++)
+    {
+        producers[i] = (mpmctest_t){&queue, i, 0, 0};
+        consumers[i] = (mpmctest_t){&queue, i, 0, 0};
+        thrd_create(&threads[i], mpmcqueue_producer, &producers[i]);
+        thrd_create(&threads[i + 4], mpmcqueue_consumer, &consumers[i]);
+    }
+    for(int i = 0 ; i < 8 ; i++)
+        thrd_join(threads[i], NULL);
+
+    //every ID popped once, in order for each producer
+    for(int i = 0 ; i < 4 ; i++)
+    {
+        errors += consumers[i].errors;
+        sum += consumers[i].sum;
+        expected += (i * 100000LL * 50000) + (49999LL * 50000 / 2);
+    }
+    if(errors || sum != expected || get_MPMC_queue_count(&queue) || tryPopMPMCQueue(&queue, NULL))
+        ret = -1;
+
+    if(ret)
+        printf("tst_mpmcqueue : Error : %d elements out of order, or elements lost\n", errors);
+    else
+        printf("tst_mpmcqueue : 200000 elements passed between 8 threads\n");
+
+    free_MPMC_queue(&queue);
+    return ret;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the d-ary heaps, pushing and popping      */
+/*          random elements, then heapifying an array       */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_heap()
+{
+    meta_t heap;
+    dataset_t* data = NULL;
+    dataset_t tmp = {0, "", 0.0}, popped = {0, "", 0.0}, previous = {0, "", 0.0};
+    int ret = 0, nbpopped = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/******************************* tst_heap ****************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&heap, sizeof(dataset_t), compare_dataset, printError);
+    if(initialise_heap(&heap, 0, 0) < 0)
+    {
+        printf("tst_heap : Error : heap could not be initialised\n");
+        return -1;
+    }
+
+    //push random elements, popping one every three pushes
+    for(int i = 0 ; i < 30000 && !ret ; i++)
+    {
+        tmp.id = rand() % 10000;
+        ret = pushHeap(&heap, &tmp);
+        if(!ret && i % 3 == 2)
+        {
+            ret = (((dataset_t*)peekHeap(&heap))->id >= tmp.id && popHeap(&heap, &popped) == 1 ? 0 : -1);
+            nbpopped++;
+        }
+    }
+
+    //the remaining elements are popped in decreasing order
+    if(!ret && heap.nbelements != 20000)
+        ret = -1;
+    if(!ret)
+        ret = (popHeap(&heap, &previous) == 1 ? 0 : -1);
+    while(!ret && heap.nbelements)
+    {
+        ret = (popHeap(&heap, &popped) == 1 && compare_dataset(&previous, &popped) >= 0 ? 0 : -1);
+        previous = popped;
+    }
+    if(!ret && (popHeap(&heap, &popped) != 0 || peekHeap(&heap)))
+        ret = -1;
+
+    if(ret)
+        printf("tst_heap : Error : elements popped out of order\n");
+    else
+        printf("tst_heap : 30000 elements pushed, %d popped while pushing, then the rest in decreasing order\n", nbpopped);
+    free_heap(&heap);
+
+    //heapify an array in a binary heap, then check it pops in decreasing order
+    if(!ret && (setup_data(&data, 10000) < 0 || initialise_heap(&heap, 0, 2) < 0 || heapifyArray(&heap, data, 10000) < 0))
+        ret = -1;
+    if(!ret)
+        ret = (popHeap(&heap, &previous) == 1 ? 0 : -1);
+    while(!ret && heap.nbelements)
+    {
+        ret = (popHeap(&heap, &popped) == 1 && compare_dataset(&previous, &popped) >= 0 ? 0 : -1);
+        previous = popped;
+    }
+
+    //a single element heapified in the empty heap, then a greater one heapified with it
+    tmp.id = 1;
+    if(!ret && (heapifyArray(&heap, &tmp, 1) < 0 || heap.nbelements != 1 || ((dataset_t*)peekHeap(&heap))->id != 1))
+        ret = -1;
+    tmp.id = 2;
+    if(!ret && (heapifyArray(&heap, &tmp, 1) < 0 || heap.nbelements != 2))
+        ret = -1;
+    if(!ret && (popHeap(&heap, &popped) != 1 || popped.id != 2 || popHeap(&heap, &popped) != 1 || popped.id != 1 || popHeap(&heap, &popped) != 0))
+        ret = -1;
+
+    if(ret)
+        printf("tst_heap : Error : heapified elements popped out of order\n");
+    else
+        printf("tst_heap : 10000 elements, then 1 and 1 more, heapified then popped in decreasing order\n");
+
+    free(data);
+    free_heap(&heap);
+    return ret;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the indexed heaps, updating and removing  */
+/*          random elements by handle before popping them   */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_indexedheap()
+{
+    meta_t heap;
+    dataset_t tmp = {0, "", 0.0}, popped = {0, "", 0.0};
+    int* ids = NULL;
+    uint32_t handle = 0;
+    int ret = 0, previous = 10000, nbremoved = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/*************************** tst_indexedheap *************************/\n");
+    printf("/*********************************************************************/\n");
+
+    //keep the ID of each handle aside (-1 once removed)
+    ids = calloc(10000, sizeof(int));
+    initialise_structure(&heap, sizeof(dataset_t), compare_dataset, printError);
+    if(!ids || initialise_indexed_heap(&heap, 0, 0) < 0)
+    {
+        printf("tst_indexedheap : Error : heap could not be initialised\n");
+        free(ids);
+        return -1;
+    }
+
+    for(int i = 0 ; i < 10000 && !ret ; i++)
+    {
+        tmp.id = rand() % 10000;
+        ret = pushIndexedHeap(&heap, &tmp, &handle);
+        if(!ret && (handle >= 10000 || ((dataset_t*)get_indexed_heap_elem(&heap, handle))->id != tmp.id))
+            ret = -1;
+        else if(!ret)
+            ids[handle] = tmp.id;
+    }
+
+    //change the priority of random elements, by value or in place, and remove others
+    for(int i = 0 ; i < 20000 && !ret ; i++)
+    {
+        handle = (uint32_t)rand() % 10000;
+        if(ids[handle] < 0)
+            continue;
+
+        if(i % 4 == 0)
+        {
+            ret = (removeIndexedHeap(&heap, handle, &popped) == 0 && popped.id == ids[handle] ? 0 : -1);
+            ids[handle] = -1;
+            nbremoved++;
+        }
+        else if(i % 4 == 1)
+        {
+            ((dataset_t*)get_indexed_heap_elem(&heap, handle))->id = ids[handle] = rand() % 10000;
+            ret = updateIndexedHeap(&heap, handle, NULL);
+        }
+        else
+        {
+            tmp.id = ids[handle] = rand() % 10000;
+            ret = updateIndexedHeap(&heap, handle, &tmp);
+        }
+    }
+
+    //removed handles are refused, the others pop in decreasing order with the value of their handle
+    if(!ret && (heap.nbelements != (uint32_t)(10000 - nbremoved)))
+        ret = -1;
+    for(uint32_t i = 0 ; i < 10000 && !ret ; i++)
+    {
+        if(ids[i] < 0 && get_indexed_heap_elem(&heap, i))
+            ret = -1;
+    }
+    while(!ret && heap.nbelements)
+    {
+        ret = (((dataset_t*)peekIndexedHeap(&heap, NULL))->id <= previous && popIndexedHeap(&heap, &popped, &handle) == 1 ? 0 : -1);
+        if(!ret && (popped.id > previous || popped.id != ids[handle] || get_indexed_heap_elem(&heap, handle)))
+            ret = -1;
+        previous = popped.id;
+    }
+
+    if(ret)
+        printf("tst_indexedheap : Error : elements updated or removed improperly\n");
+    else
+        printf("tst_indexedheap : 10000 elements pushed, %d removed by handle, the others updated then popped in decreasing order\n", nbremoved);
+
+    free(ids);
+    free_indexed_heap(&heap);
+    return ret;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the bucket queues, checking the elements  */
+/*          are popped by priority then in FIFO order       */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_bucketqueue()
+{
+    meta_t queue;
+    dataset_t tmp = {0, "", 0.0}, popped = {0, "", 0.0};
+    int lastid[256] = {0};
+    uint8_t priority = 0, previous = 0;
+    int ret = 0, nbpopped = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/*************************** tst_bucketqueue *************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&queue, sizeof(dataset_t), compare_dataset, printError);
+    if(initialise_bucket_queue(&queue, 0) < 0)
+    {
+        printf("tst_bucketqueue : Error : queue could not be initialised\n");
+        return -1;
+    }
+
+    //push increasing IDs with random priorities, popping one every three pushes
+    for(int i = 1 ; i <= 30000 && !ret ; i++)
+    {
+        tmp.id = i;
+        ret = pushBucketQueue(&queue, &tmp, (uint8_t)(rand() % 256));
+        if(!ret && i % 3 == 0)
+        {
+            ret = (popBucketQueue(&queue, &popped, &priority) == 1 && popped.id > lastid[priority] ? 0 : -1);
+            lastid[priority] = popped.id;
+            nbpopped++;
+        }
+    }
+
+    //the remaining elements are popped by increasing priority, in the order they were pushed
+    if(!ret && queue.nbelements != 20000)
+        ret = -1;
+    while(!ret && queue.nbelements)
+    {
+        ret = (peekBucketQueue(&queue, NULL) && popBucketQueue(&queue, &popped, &priority) == 1 ? 0 : -1);
+        if(!ret && (priority < previous || popped.id <= lastid[priority]))
+            ret = -1;
+        lastid[priority] = popped.id;
+        previous = priority;
+    }
+    if(!ret && (popBucketQueue(&queue, &popped, &priority) != 0 || peekBucketQueue(&queue, NULL)))
+        ret = -1;
+
+    if(ret)
+        printf("tst_bucketqueue : Error : elements popped out of order\n");
+    else
+        printf("tst_bucketqueue : 30000 elements pushed, %d popped while pushing, then the rest by priority and in FIFO order\n", nbpopped);
+
+    free_bucket_queue(&queue);
+    return ret;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the array stacks, pushing and popping     */
+/*          elements one by one and in batches              */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_arraystack()
+{
+    meta_t stack;
+    dataset_t tmp = {0, "", 0.0}, popped = {0, "", 0.0};
+    dataset_t batch[100] = {0}, poppedbatch[100] = {0};
+    int ret = 0, pushed = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/**************************** tst_arraystack *************************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&stack, sizeof(dataset_t), compare_dataset, printError);
+    if(initialise_array_stack(&stack, 0) < 0)
+    {
+        printf("tst_arraystack : Error : stack could not be initialised\n");
+        return -1;
+    }
+
+    //push 3 elements and pop the last one, then push a batch and pop it back
+    for(int i = 0 ; i < 1000 && !ret ; i++)
+    {
+        for(int j = 0 ; j < 3 && !ret ; j++)
+        {
+            tmp.id = pushed++;
+            ret = pushArrayStack(&stack, &tmp);
+        }
+        if(!ret)
+            ret = (popArrayStack(&stack, &popped) == 1 && popped.id == --pushed ? 0 : -1);
+
+        for(int j = 0 ; j < 100 ; j++)
+            batch[j].id = pushed + j;
+        if(!ret && (pushArrayStackBatch(&stack, batch, 100) < 0 || ((dataset_t*)peekArrayStack(&stack))->id != pushed + 99))
+            ret = -1;
+        if(!ret && (popArrayStackBatch(&stack, poppedbatch, 100) != 100 || memcmp(batch, poppedbatch, sizeof(batch))))
+            ret = -1;
+    }
+
+    //push a last batch, then check everything pops from the top down
+    if(!ret && pushArrayStackBatch(&stack, batch, 100) == 0)
+        pushed += 100;
+    if(!ret && stack.nbelements != (uint32_t)pushed)
+        ret = -1;
+    while(!ret && stack.nbelements)
+        ret = (popArrayStack(&stack, &popped) == 1 && popped.id == --pushed ? 0 : -1);
+    if(!ret && (popArrayStack(&stack, &popped) != 0 || popArrayStackBatch(&stack, poppedbatch, 100) != 0 || peekArrayStack(&stack)))
+        ret = -1;
+
+    if(ret)
+        printf("tst_arraystack : Error : elements popped out of order\n");
+    else
+        printf("tst_arraystack : 2100 elements pushed and popped one by one and in batches\n");
+
+    free_array_stack(&stack);
+    return ret;
+}
+
+/********************************************************
+ * @brief Thread of the Treiber stack test
+********************************************************/
+typedef struct
+{
+    meta_t*         stack;  ///< Stack shared by the threads
+    atomic_uchar*   seen;   ///< Number of times each ID got popped
+    int             index;  ///< Index of the thread
+    int             errors; ///< Number of IDs popped more than once
+} treibertest_t;
+
+/************************************************************/
+/*  I : Dataset popped                                      */
+/*      Test thread                                         */
+/*  P : Marks the ID of a dataset as popped                 */
+/*  O :  0 -> Success                                       */
+/************************************************************/
+static int mark_treiber(void* elem, void* arg)
+{
+    treibertest_t* test = (treibertest_t*)arg;
+
+    if(atomic_fetch_add(&test->seen[((dataset_t*)elem)->id], 1))
+        test->errors++;
+
+    return 0;
+}
+
+/************************************************************/
+/*  I : Test thread                                         */
+/*  P : Pushes 50000 IDs tagged with the thread index,      */
+/*          popping one every two pushes, all of them       */
+/*          every 1000 pushes and one when the stack is     */
+/*          full                                            */
+/*  O :  0 -> Success                                       */
+/************************************************************/
+static int treiberstack_worker(void* arg)
+{
+    treibertest_t* test = (treibertest_t*)arg;
+    dataset_t tmp = {0, "", 0.0}, popped = {0, "", 0.0};
+
+    for(int i = 0 ; i < 50000 ; i++)
+    {
+        tmp.id = (test->index * 50000) + i;
+        while(pushTreiberStack(test->stack, &tmp) == 1)
+        {
+            if(popTreiberStack(test->stack, &popped) == 1)
+                mark_treiber(&popped, test);
+        }
+
+        if(i % 1000 == 999)
+            popAllTreiberStack(test->stack, test, mark_treiber);
+        else if(i % 2 && popTreiberStack(test->stack, &popped) == 1)
+            mark_treiber(&popped, test);
+    }
+
+    return 0;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the Treiber stacks, with 4 threads        */
+/*          pushing and popping on a small stack            */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_treiberstack()
+{
+    meta_t stack;
+    treibertest_t workers[4];
+    thrd_t threads[4];
+    atomic_uchar* seen = NULL;
+    int ret = 0, errors = 0, missing = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/*************************** tst_treiberstack ************************/\n");
+    printf("/*********************************************************************/\n");
+
+    seen = calloc(200000, sizeof(atomic_uchar));
+    initialise_structure(&stack, sizeof(dataset_t), compare_dataset, printError);
+    if(!seen || initialise_treiber_stack(&stack, 256) < 0)
+    {
+        printf("tst_treiberstack : Error : stack could not be initialised\n");
+        free(seen);
+        return -1;
+    }
+
+    //a small stack, so the nodes keep being reused while other threads hold stale tops
+    for(int i = 0 ; i < 4 ; i++)
+    {
+        workers[i] = (treibertest_t){&stack, seen, i, 0};
+        thrd_create(&threads[i], treiberstack_worker, &workers[i]);
+    }
+    for(int i = 0 ; i < 4 ; i++)
+        thrd_join(threads[i], NULL);
+
+    //pop the remaining elements, then check every ID got popped exactly once
+    if(popAllTreiberStack(&stack, &workers[0], mark_treiber) < 0 || popTreiberStack(&stack, NULL) != 0)
+        ret = -1;
+    for(int i = 0 ; i < 4 ; i++)
+        errors += workers[i].errors;
+    for(int i = 0 ; i < 200000 ; i++)
+    {
+        if(atomic_load(&seen[i]) != 1)
+            missing++;
+    }
+    if(errors || missing)
+        ret = -1;
+
+    if(ret)
+        printf("tst_treiberstack : Error : %d elements missing or popped several times\n", missing + errors);
+    else
+        printf("tst_treiberstack : 200000 elements pushed and popped by 4 threads, each exactly once\n");
+
+    free(seen);
+    free_treiber_stack(&stack);
+    return ret;
+}
+
+/********************************************************
+ * @brief Thread of the work-stealing deque test
+********************************************************/
+typedef struct
+{
+    meta_t*         deque;  ///< Deque shared by the threads
+    atomic_uchar*   seen;   ///< Number of times each ID got taken
+    atomic_int*     done;   ///< Set once the owner is done
+    int             errors; ///< Number of IDs taken more than once
+} workdequetest_t;
+
+/************************************************************/
+/*  I : Test thread                                         */
+/*  P : Steals IDs until the owner is done and the deque    */
+/*          is empty                                        */
+/*  O :  0 -> Success                                       */
+/************************************************************/
+static int workdeque_thief(void* arg)
+{
+    workdequetest_t* test = (workdequetest_t*)arg;
+    dataset_t stolen = {0, "", 0.0};
+
+    while(!atomic_load(test->done) || get_work_deque_count(test->deque))
+    {
+        if(stealWorkDeque(test->deque, &stolen) != 1)
+            thrd_yield();
+        else if(atomic_fetch_add(&test->seen[stolen.id], 1))
+            test->errors++;
+    }
+
+    return 0;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the work-stealing deques, with an owner   */
+/*          pushing and popping while 3 threads steal       */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_workdeque()
+{
+    meta_t deque;
+    workdequetest_t thieves[3];
+    thrd_t threads[3];
+    dataset_t tmp = {0, "", 0.0}, popped = {0, "", 0.0};
+    atomic_uchar* seen = NULL;
+    atomic_int done;
+    int ret = 0, errors = 0, missing = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/***************************** tst_workdeque *************************/\n");
+    printf("/*********************************************************************/\n");
+
+    atomic_init(&done, 0);
+    seen = calloc(200000, sizeof(atomic_uchar));
+    initialise_structure(&deque, sizeof(dataset_t), compare_dataset, printError);
+    if(!seen || initialise_work_deque(&deque, 4) < 0)
+    {
+        printf("tst_workdeque : Error : deque could not be initialised\n");
+        free(seen);
+        return -1;
+    }
+
+    for(int i = 0 ; i < 3 ; i++)
+    {
+        thieves[i] = (workdequetest_t){&deque, seen, &done, 0};
+        thrd_create(&threads[i], workdeque_thief, &thieves[i]);
+    }
+
+    //push increasing IDs (the deque starts small, to grow while being stolen from), popping one every three
+    for(int i = 0 ; i < 200000 && !ret ; i++)
+    {
+        tmp.id = i;
+        ret = pushWorkDeque(&deque, &tmp);
+        if(!ret && i % 3 == 2 && popWorkDeque(&deque, &popped) == 1 && atomic_fetch_add(&seen[popped.id], 1))
+            errors++;
+    }
+    while(popWorkDeque(&deque, &popped) == 1)
+    {
+        if(atomic_fetch_add(&seen[popped.id], 1))
+            errors++;
+    }
+    atomic_store(&done, 1);
+
+    for(int i = 0 ; i < 3 ; i++)
+    {
+        thrd_join(threads[i], NULL);
+        errors += thieves[i].errors;
+    }
+
+    //every ID taken exactly once, by the owner or a thief
+    for(int i = 0 ; i < 200000 ; i++)
+    {
+        if(atomic_load(&seen[i]) != 1)
+            missing++;
+    }
+    if(ret || errors || missing || get_work_deque_count(&deque))
+        ret = -1;
+
+    if(ret)
+        printf("tst_workdeque : Error : %d elements missing or taken several times\n", missing + errors);
+    else
+        printf("tst_workdeque : 200000 elements taken exactly once by the owner or 3 thieves\n");
+
+    free(seen);
+    free_work_deque(&deque);
+    return ret;
+}
+
+/********************************************************
+ * @brief Range of integers summed by a scheduler task
+********************************************************/
+typedef struct
+{
+    scheduler_t*        scheduler;  ///< Scheduler running the task
+    atomic_llong*       total;      ///< Sum of all the ranges
+    uint32_t            low;        ///< First integer of the range
+    uint32_t            high;       ///< Integer following the range
+} schedrange_t;
+
+/************************************************************/
+/*  I : Range to sum                                        */
+/*  P : Splits the range in two subtasks, or sums it if     */
+/*          small enough                                    */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+static int sum_range_task(void* arg)
+{
+    schedrange_t* range = (schedrange_t*)arg, *half = NULL;
+    long long sum = 0;
+    int ret = 0;
+
+    //split the ranges too large, the task going on with the lower half
+    while(range->high - range->low > 1000 && !ret)
+    {
+        half = malloc(sizeof(schedrange_t));
+        if(!half)
+            ret = -1;
+        else
+        {
+            *half = (schedrange_t){range->scheduler, range->total, range->low + ((range->high - range->low) / 2), range->high};
+            range->high = half->low;
+            ret = submit_scheduler(range->scheduler, sum_range_task, half);
+        }
+    }
+
+    for(uint32_t i = range->low ; i < range->high ; i++)
+        sum += i;
+    atomic_fetch_add(range->total, sum);
+
+    free(range);
+    return ret;
+}
+
+/************************************************************/
+/*  I : Unused                                              */
+/*  P : Fails                                               */
+/*  O : -1 -> Error                                         */
+/************************************************************/
+static int failing_task(void* arg)
+{
+    (void)arg;
+    return -1;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the schedulers, summing ranges split      */
+/*          recursively into tasks                          */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_scheduler()
+{
+    scheduler_t scheduler;
+    schedrange_t* range = NULL;
+    atomic_llong total;
+    int ret = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/***************************** tst_scheduler *************************/\n");
+    printf("/*********************************************************************/\n");
+
+    atomic_init(&total, 0);
+    if(initialise_scheduler(&scheduler, 4, printError) < 0)
+    {
+        printf("tst_scheduler : Error : scheduler could not be initialised\n");
+        return -1;
+    }
+
+    //sum 0 to 999999 ten times, each range being split into tasks by the workers
+    for(int i = 0 ; i < 10 && !ret ; i++)
+    {
+        range = malloc(sizeof(schedrange_t));
+        if(!range)
+            ret = -1;
+        else
+        {
+            *range = (schedrange_t){&scheduler, &total, 0, 1000000};
+            ret = submit_scheduler(&scheduler, sum_range_task, range);
+        }
+    }
+    if(!ret && (wait_scheduler(&scheduler) < 0 || atomic_load(&total) != 10 * (999999LL * 1000000 / 2)))
+        ret = -1;
+
+    //a failing task is reported by the next wait only
+    if(!ret && (submit_scheduler(&scheduler, failing_task, NULL) < 0 || wait_scheduler(&scheduler) != -1 || wait_scheduler(&scheduler) != 0))
+        ret = -1;
+
+    if(free_scheduler(&scheduler) < 0)
+        ret = -1;
+
+    if(ret)
+        printf("tst_scheduler : Error : ranges summed improperly, or failure not reported\n");
+    else
+        printf("tst_scheduler : 10 ranges of 1000000 integers summed by 4 workers\n");
+
+    return ret;
+}
+
+/************************************************************/
+/*  I : /                                                   */
+/*  P : Tests out the batch operations on queues and        */
+/*          stacks, mixed with the single ones              */
+/*  O :  0 -> Success                                       */
+/*      -1 -> Error                                         */
+/************************************************************/
+int tst_batchqueuestack()
+{
+    meta_t queue, stack;
+    dataset_t tmp = {0, "", 0.0}, batch[100] = {0}, popped[100] = {0};
+    dyndata_t* single = NULL;
+    uint32_t nb = 0;
+    int ret = 0, pushed = 0, expected = 0;
+
+    printf("/*********************************************************************/\n");
+    printf("/************************* tst_batchqueuestack ***********************/\n");
+    printf("/*********************************************************************/\n");
+
+    initialise_structure(&queue, sizeof(dataset_t), compare_dataset, printError);
+    initialise_structure(&stack, sizeof(dataset_t), compare_dataset, printError);
+
+    //push a batch and a single element, then pop one alone and 60 in a batch
+    for(int i = 0 ; i < 200 && !ret ; i++)
+    {
+        for(int j = 0 ; j < 100 ; j++)
+            batch[j].id = pushed++;
+        tmp.id = pushed++;
+        if(pushQueueBatch(&queue, batch, 100) < 0 || pushQueue(&queue, &tmp) < 0)
+            ret = -1;
+
+        single = popQueue(&queue);
+        if(!ret && (!single || ((dataset_t*)single->data)->id != expected++))
+            ret = -1;
+        if(single)
+            free_dyn(&single);
+
+        if(!ret && popQueueBatch(&queue, popped, 60) != 60)
+            ret = -1;
+        for(int j = 0 ; j < 60 && !ret ; j++)
+            ret = (popped[j].id == expected++ ? 0 : -1);
+    }
+
+    //drain the rest by batches
+    while(!ret && queue.nbelements)
+    {
+        nb = popQueueBatch(&queue, popped, 100);
+        for(uint32_t j = 0 ; j < nb && !ret ; j++)
+            ret = (popped[j].id == expected++ ? 0 : -1);
+    }
+    if(!ret && (expected != pushed || queue.structure || queue.last || popQueueBatch(&queue, popped, 100)))
+        ret = -1;
+
+    if(ret)
+        printf("tst_batchqueuestack : Error : queue elements popped out of order\n");
+    else
+        printf("tst_batchqueuestack : %d elements pushed and popped in order in a queue\n", pushed);
+
+    //push batches on a stack, pop them back along with the element pushed alone
+    pushed = 0;
+    for(int i = 0 ; i < 100 && !ret ; i++)
+    {
+        for(int j = 0 ; j < 100 ; j++)
+            batch[j].id = pushed++;
+        tmp.id = pushed++;
+        if(pushStack(&stack, &tmp) < 0 || pushStackBatch(&stack, batch, 100) < 0 || ((dataset_t*)((dyndata_t*)stack.structure)->data)->id != pushed - 2)
+            ret = -1;
+    }
+    if(!ret && stack.nbelements != (uint32_t)pushed)
+        ret = -1;
+    for(int i = 0 ; i < 100 && !ret ; i++)
+    {
+        pushed -= 101;
+        if(popStackBatch(&stack, popped, 100) != 100)
+            ret = -1;
+        for(int j = 0 ; j < 100 && !ret ; j++)
+            ret = (popped[j].id == pushed + j ? 0 : -1);
+
+        single = popStack(&stack);
+        if(!ret && (!single || ((dataset_t*)single->data)->id != pushed + 100))
+            ret = -1;
+        if(single)
+            free_dyn(&single);
+    }
+    if(!ret && (stack.nbelements || stack.structure || stack.last || popStackBatch(&stack, popped, 100)))
+        ret = -1;
+
+    if(ret)
+        printf("tst_batchqueuestack : Error : stack elements popped out of order\n");
+    else
+        printf("tst_batchqueuestack : 10100 elements pushed and popped in order in a stack\n");
+
+    popQueueBatch(&queue, NULL, UINT32_MAX);
+    popStackBatch(&stack, NULL, UINT32_MAX);
+    return ret;
+}